@@ -0,0 +1,215 @@
+#include "Benchmark.hpp"
+#include "../Resources/Model.hpp"
+#include "../Resources/Texture.hpp"
+#include "../Geometry/PrimitiveMesh.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Cogent::Bench::State;
+
+// Asset sintetis ditulis ke temp dir sekali per ukuran (repo tidak membawa asset).
+// --model=<file.obj> / --texture=<file.png> untuk mengukur asset asli.
+namespace {
+
+    std::filesystem::path benchAssetPath(const std::string& fileName) {
+        return std::filesystem::temp_directory_path() / ("cogent_bench_" + fileName);
+    }
+
+    // Sphere UV sebagai OBJ (v/vt/vn + face triangle), mirip output exporter DCC
+    std::string writeSphereObj(int resolution) {
+        const std::filesystem::path path = benchAssetPath("sphere_" + std::to_string(resolution) + ".obj");
+        if (std::filesystem::exists(path)) return path.string();
+
+        PrimitiveMesh mesh;
+        mesh.createSphere(1.0f, resolution, resolution);
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) throw std::runtime_error("Tidak bisa menulis " + path.string());
+        file << "# cogent_bench sphere " << resolution << "x" << resolution << "\n";
+        for (const Vertex& v : mesh.vertices) file << "v " << v.pos.x << " " << v.pos.y << " " << v.pos.z << "\n";
+        for (const Vertex& v : mesh.vertices) file << "vt " << v.texCoord.x << " " << v.texCoord.y << "\n";
+        for (const Vertex& v : mesh.vertices) file << "vn " << v.normal.x << " " << v.normal.y << " " << v.normal.z << "\n";
+        for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+            file << "f";
+            for (size_t k = 0; k < 3; k++) {
+                const uint32_t index = mesh.indices[i + k] + 1; // OBJ 1-based
+                file << " " << index << "/" << index << "/" << index;
+            }
+            file << "\n";
+        }
+        if (!file) throw std::runtime_error("Gagal menulis " + path.string());
+        return path.string();
+    }
+
+    // ------------------------------------------------------------ PNG writer minimal
+
+    uint32_t crc32(const uint8_t* data, size_t size, uint32_t crc = 0) {
+        static uint32_t table[256] = {};
+        if (table[1] == 0) {
+            for (uint32_t n = 0; n < 256; n++) {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                table[n] = c;
+            }
+        }
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+    void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(static_cast<uint8_t>(value >> 24));
+        out.push_back(static_cast<uint8_t>(value >> 16));
+        out.push_back(static_cast<uint8_t>(value >> 8));
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    void putChunk(std::vector<uint8_t>& out, const char type[4], const std::vector<uint8_t>& data) {
+        putBigEndian(out, static_cast<uint32_t>(data.size()));
+        const size_t typeOffset = out.size();
+        out.insert(out.end(), type, type + 4);
+        out.insert(out.end(), data.begin(), data.end());
+        putBigEndian(out, crc32(out.data() + typeOffset, data.size() + 4));
+    }
+
+    // RGBA8 gradient + noise. Baris genap filter Sub, ganjil Up (decoder harus unfilter), zlib
+    // stored block (tanpa kompresi) supaya writer tetap kecil; biaya decode = inflate + unfilter + convert.
+    std::string writeTexturePng(uint32_t size) {
+        const std::filesystem::path path = benchAssetPath("texture_" + std::to_string(size) + ".png");
+        if (std::filesystem::exists(path)) return path.string();
+
+        const size_t stride = static_cast<size_t>(size) * 4;
+        std::vector<uint8_t> pixels(stride * size);
+        uint32_t noise = 0x9E3779B9u;
+        for (uint32_t y = 0; y < size; y++) {
+            for (uint32_t x = 0; x < size; x++) {
+                noise ^= noise << 13; noise ^= noise >> 17; noise ^= noise << 5;
+                uint8_t* p = &pixels[y * stride + x * 4];
+                p[0] = static_cast<uint8_t>(x * 255 / size);
+                p[1] = static_cast<uint8_t>(y * 255 / size);
+                p[2] = static_cast<uint8_t>(noise & 0x3F);
+                p[3] = 255;
+            }
+        }
+
+        std::vector<uint8_t> filtered;
+        filtered.reserve((stride + 1) * size);
+        for (uint32_t y = 0; y < size; y++) {
+            const uint8_t* row = &pixels[y * stride];
+            const bool useUp = (y % 2 == 1);
+            filtered.push_back(useUp ? 2 : 1);
+            for (size_t i = 0; i < stride; i++) {
+                const uint8_t reference = useUp ? row[i - stride] : (i >= 4 ? row[i - 4] : 0);
+                filtered.push_back(static_cast<uint8_t>(row[i] - reference));
+            }
+        }
+
+        std::vector<uint8_t> zlib = { 0x78, 0x01 };
+        uint32_t adlerA = 1, adlerB = 0;
+        for (uint8_t byte : filtered) {
+            adlerA = (adlerA + byte) % 65521u;
+            adlerB = (adlerB + adlerA) % 65521u;
+        }
+        for (size_t offset = 0; offset < filtered.size(); offset += 65535) {
+            const uint16_t length = static_cast<uint16_t>(std::min<size_t>(65535, filtered.size() - offset));
+            const bool last = offset + length >= filtered.size();
+            zlib.push_back(last ? 1 : 0);
+            zlib.push_back(static_cast<uint8_t>(length));
+            zlib.push_back(static_cast<uint8_t>(length >> 8));
+            const uint16_t complement = static_cast<uint16_t>(~length);
+            zlib.push_back(static_cast<uint8_t>(complement));
+            zlib.push_back(static_cast<uint8_t>(complement >> 8));
+            zlib.insert(zlib.end(), filtered.begin() + offset, filtered.begin() + offset + length);
+        }
+        putBigEndian(zlib, (adlerB << 16) | adlerA);
+
+        std::vector<uint8_t> header;
+        putBigEndian(header, size);
+        putBigEndian(header, size);
+        header.insert(header.end(), { 8, 6, 0, 0, 0 }); // 8 bit, RGBA, deflate, filter 0, non-interlaced
+
+        std::vector<uint8_t> png = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        putChunk(png, "IHDR", header);
+        putChunk(png, "IDAT", zlib);
+        putChunk(png, "IEND", {});
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(png.data()), static_cast<std::streamsize>(png.size()));
+        if (!file) throw std::runtime_error("Gagal menulis " + path.string());
+        return path.string();
+    }
+}
+
+// ---------------------------------------------------------------- Model
+
+// Argumen = resolusi sphere (sectors = stacks); tinyobj parse + dedup vertex (Model::loadObj)
+static void BM_Model_ImportObj(State& state) {
+    std::string path;
+    try {
+        path = Cogent::Bench::getArgument("--model=");
+        if (path.empty()) path = writeSphereObj(static_cast<int>(state.range()));
+    } catch (const std::exception& e) {
+        state.skipWithError(e.what());
+        return;
+    }
+
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+    for (auto _ : state) {
+        Model model;
+        try {
+            model.loadObj(path);
+        } catch (const std::exception& e) {
+            state.skipWithError(e.what());
+            break;
+        }
+        vertexCount = model.getVertices().size();
+        indexCount = model.getIndices().size();
+        Cogent::Bench::doNotOptimize(model.getVertices().data());
+    }
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(path)));
+    state.setCounter("vertices", static_cast<double>(vertexCount));
+    state.setCounter("triangles", static_cast<double>(indexCount / 3));
+}
+COGENT_BENCHMARK(BM_Model_ImportObj)->arg(64)->arg(256);
+
+// ---------------------------------------------------------------- Texture
+
+// Argumen = sisi texture; decode stb_image ke RGBA8 lewat jalur streaming (Texture::loadCPU)
+static void BM_Texture_LoadCPU(State& state) {
+    std::string path;
+    try {
+        path = Cogent::Bench::getArgument("--texture=");
+        if (path.empty()) path = writeTexturePng(static_cast<uint32_t>(state.range()));
+    } catch (const std::exception& e) {
+        state.skipWithError(e.what());
+        return;
+    }
+
+    // Cek sekali di luar loop: loadCPU tidak melempar, hanya jatuh ke fallback 1x1
+    {
+        Texture probe;
+        probe.path = path;
+        probe.loadCPU();
+        if (probe.usesFallback()) {
+            state.skipWithError("Texture::loadCPU gagal decode " + path);
+            return;
+        }
+    }
+
+    uint64_t decodedBytes = 0;
+    for (auto _ : state) {
+        Texture texture;
+        texture.path = path;
+        texture.loadCPU();
+        decodedBytes = static_cast<uint64_t>(texture.getWidth()) * texture.getHeight() * 4;
+        Cogent::Bench::doNotOptimize(texture);
+    }
+    state.setBytesProcessed(static_cast<int64_t>(state.iterations() * decodedBytes));
+}
+COGENT_BENCHMARK(BM_Texture_LoadCPU)->arg(512)->arg(2048);
@@ -0,0 +1,294 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+namespace Cogent::Bench {
+
+    static std::vector<std::unique_ptr<Benchmark>>& registry() {
+        static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+        return benchmarks;
+    }
+
+    Benchmark* registerBenchmark(const char* name, Function function) {
+        registry().push_back(std::make_unique<Benchmark>(name, std::move(function)));
+        return registry().back().get();
+    }
+
+    static std::vector<std::string>& commandLine() {
+        static std::vector<std::string> arguments;
+        return arguments;
+    }
+
+    std::string getArgument(const std::string& prefix, const std::string& fallback) {
+        for (const std::string& arg : commandLine()) {
+            if (arg.compare(0, prefix.size(), prefix) == 0) return arg.substr(prefix.size());
+        }
+        return fallback;
+    }
+
+    struct Options {
+        std::string filter;         // Substring nama (kosong = semua)
+        double minTime = 0.5;       // Detik per run minimum
+        uint32_t repetitions = 1;   // > 1: tambah aggregate mean/median/min
+        std::string outPath;        // Kosong = tanpa JSON
+        bool list = false;
+    };
+
+    struct Result {
+        std::string name;
+        std::string runType = "iteration"; // "iteration" | "aggregate"
+        std::string aggregate;             // mean | median | min
+        uint32_t repetitionIndex = 0;
+        uint64_t iterations = 0;
+        double realTime = 0.0;  // Per iterasi, dalam timeUnit
+        double cpuTime = 0.0;
+        const char* timeUnit = "ns";
+        double itemsPerSecond = 0.0;
+        double bytesPerSecond = 0.0;
+        std::string label;
+        std::string error;
+        std::vector<std::pair<std::string, double>> counters;
+    };
+
+    static double unitScale(const char* unit) {
+        const std::string value(unit);
+        if (value == "ms") return 1e3;
+        if (value == "us") return 1e6;
+        return 1e9;
+    }
+
+    static std::string escapeJson(const std::string& text) {
+        std::string out;
+        for (char c : text) {
+            if (c == '"' || c == '\\') { out += '\\'; out += c; }
+            else if (c == '\n') out += "\\n";
+            else out += c;
+        }
+        return out;
+    }
+
+    class Runner {
+    public:
+        explicit Runner(const Options& options) : options(options) {}
+
+        void run(const Benchmark& benchmark, int64_t argument, bool hasArgument) {
+            std::string name = benchmark.name;
+            std::vector<int64_t> args;
+            if (hasArgument) {
+                name += "/" + std::to_string(argument);
+                args.push_back(argument);
+            }
+            if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+
+            std::vector<Result> repetitions;
+            for (uint32_t rep = 0; rep < options.repetitions; rep++) {
+                Result result = runOnce(benchmark, name, args);
+                result.repetitionIndex = rep;
+                print(result);
+                results.push_back(result);
+                repetitions.push_back(result);
+                if (!result.error.empty()) return;
+            }
+            if (repetitions.size() > 1) addAggregates(repetitions);
+        }
+
+        const std::vector<Result>& getResults() const { return results; }
+
+    private:
+        Result runOnce(const Benchmark& benchmark, const std::string& name, const std::vector<int64_t>& args) {
+            // Naikkan iterasi sampai satu run cukup lama untuk diukur (seperti Google Benchmark)
+            uint64_t iterations = benchmark.fixedIterations > 0 ? benchmark.fixedIterations : 1;
+            constexpr uint64_t MAX_ITERATIONS = 1000000000ull;
+            while (true) {
+                State state(iterations, args);
+                benchmark.function(state);
+                state.stopTimer();
+
+                const double seconds = benchmark.manualTime ? state.manualSeconds : state.wallSeconds;
+                const bool done = benchmark.fixedIterations > 0 || state.hasError() || seconds >= options.minTime ||
+                                  iterations >= MAX_ITERATIONS;
+                if (done) return makeResult(benchmark, name, iterations, state, seconds);
+
+                // Prediksi iterasi untuk mencapai minTime (+40%), naik maksimal 10x per langkah
+                const double multiplier = seconds <= 0.0 ? 10.0 : std::min(10.0, std::max(1.4 * options.minTime / seconds, 1.5));
+                iterations = std::min<uint64_t>(MAX_ITERATIONS, static_cast<uint64_t>(static_cast<double>(iterations) * multiplier) + 1);
+            }
+        }
+
+        Result makeResult(const Benchmark& benchmark, const std::string& name, uint64_t iterations, const State& state, double seconds) {
+            Result result;
+            result.name = name;
+            result.iterations = iterations;
+            result.timeUnit = benchmark.timeUnit;
+            const double scale = unitScale(benchmark.timeUnit);
+            result.realTime = seconds / static_cast<double>(iterations) * scale;
+            result.cpuTime = state.cpuSeconds / static_cast<double>(iterations) * scale;
+            if (seconds > 0.0) {
+                result.itemsPerSecond = static_cast<double>(state.itemsProcessed) / seconds;
+                result.bytesPerSecond = static_cast<double>(state.bytesProcessed) / seconds;
+            }
+            result.label = state.label;
+            result.error = state.error;
+            result.counters = state.counters;
+            return result;
+        }
+
+        void addAggregates(const std::vector<Result>& repetitions) {
+            auto aggregateOf = [&](const char* kind, auto reduce) {
+                Result aggregate = repetitions.front();
+                aggregate.name += std::string("_") + kind;
+                aggregate.runType = "aggregate";
+                aggregate.aggregate = kind;
+                aggregate.realTime = reduce([](const Result& r) { return r.realTime; });
+                aggregate.cpuTime = reduce([](const Result& r) { return r.cpuTime; });
+                aggregate.itemsPerSecond = reduce([](const Result& r) { return r.itemsPerSecond; });
+                aggregate.bytesPerSecond = reduce([](const Result& r) { return r.bytesPerSecond; });
+                for (size_t c = 0; c < aggregate.counters.size(); c++) {
+                    aggregate.counters[c].second = reduce([c](const Result& r) { return c < r.counters.size() ? r.counters[c].second : 0.0; });
+                }
+                print(aggregate);
+                results.push_back(aggregate);
+            };
+
+            auto values = [&](auto field) {
+                std::vector<double> out;
+                for (const Result& r : repetitions) out.push_back(field(r));
+                std::sort(out.begin(), out.end());
+                return out;
+            };
+            aggregateOf("mean", [&](auto field) {
+                double sum = 0.0;
+                for (double v : values(field)) sum += v;
+                return sum / static_cast<double>(repetitions.size());
+            });
+            aggregateOf("median", [&](auto field) {
+                std::vector<double> sorted = values(field);
+                const size_t mid = sorted.size() / 2;
+                return sorted.size() % 2 ? sorted[mid] : 0.5 * (sorted[mid - 1] + sorted[mid]);
+            });
+            aggregateOf("min", [&](auto field) { return values(field).front(); });
+        }
+
+        static void print(const Result& result) {
+            char line[256];
+            if (!result.error.empty()) {
+                std::snprintf(line, sizeof(line), "%-48s ERROR: %s", result.name.c_str(), result.error.c_str());
+                std::cout << line << std::endl;
+                return;
+            }
+            std::snprintf(line, sizeof(line), "%-48s %12.2f %-2s %12.2f %-2s %12llu", result.name.c_str(),
+                          result.realTime, result.timeUnit, result.cpuTime, result.timeUnit,
+                          static_cast<unsigned long long>(result.iterations));
+            std::cout << line;
+            if (result.itemsPerSecond > 0.0) std::cout << "  items/s=" << result.itemsPerSecond;
+            if (result.bytesPerSecond > 0.0) std::cout << "  bytes/s=" << result.bytesPerSecond;
+            for (const auto& [counter, value] : result.counters) std::cout << "  " << counter << "=" << value;
+            if (!result.label.empty()) std::cout << "  " << result.label;
+            std::cout << std::endl;
+        }
+
+        const Options& options;
+        std::vector<Result> results;
+    };
+
+    static bool writeJson(const std::string& path, const std::vector<Result>& results) {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) return false;
+
+        const std::time_t now = std::time(nullptr);
+        char date[64];
+        std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+        file << "{\n  \"context\": {\n";
+        file << "    \"date\": \"" << date << "\",\n";
+        file << "    \"executable\": \"cogent_bench\",\n";
+        file << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#ifdef NDEBUG
+        file << "    \"library_build_type\": \"release\"\n";
+#else
+        file << "    \"library_build_type\": \"debug\"\n";
+#endif
+        file << "  },\n  \"benchmarks\": [\n";
+
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            file << "    {\n";
+            file << "      \"name\": \"" << escapeJson(r.name) << "\",\n";
+            file << "      \"run_name\": \"" << escapeJson(r.runType == "aggregate" ? r.name.substr(0, r.name.rfind('_')) : r.name) << "\",\n";
+            file << "      \"run_type\": \"" << r.runType << "\",\n";
+            if (r.runType == "aggregate") file << "      \"aggregate_name\": \"" << r.aggregate << "\",\n";
+            file << "      \"repetition_index\": " << r.repetitionIndex << ",\n";
+            if (!r.error.empty()) {
+                file << "      \"error_occurred\": true,\n";
+                file << "      \"error_message\": \"" << escapeJson(r.error) << "\",\n";
+            }
+            file << "      \"iterations\": " << r.iterations << ",\n";
+            file << "      \"real_time\": " << r.realTime << ",\n";
+            file << "      \"cpu_time\": " << r.cpuTime << ",\n";
+            if (r.itemsPerSecond > 0.0) file << "      \"items_per_second\": " << r.itemsPerSecond << ",\n";
+            if (r.bytesPerSecond > 0.0) file << "      \"bytes_per_second\": " << r.bytesPerSecond << ",\n";
+            for (const auto& [counter, value] : r.counters) file << "      \"" << escapeJson(counter) << "\": " << value << ",\n";
+            if (!r.label.empty()) file << "      \"label\": \"" << escapeJson(r.label) << "\",\n";
+            file << "      \"time_unit\": \"" << r.timeUnit << "\"\n";
+            file << "    }" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+
+    static Options parseOptions(int argc, char** argv) {
+        Options options;
+        for (int i = 1; i < argc; i++) {
+            const std::string arg = argv[i];
+            auto valueOf = [&](const char* prefix) -> const char* {
+                const size_t length = std::char_traits<char>::length(prefix);
+                return arg.compare(0, length, prefix) == 0 ? arg.c_str() + length : nullptr;
+            };
+            if (const char* value = valueOf("--filter=")) options.filter = value;
+            else if (const char* value = valueOf("--min-time=")) options.minTime = std::atof(value);
+            else if (const char* value = valueOf("--repetitions=")) options.repetitions = std::max(1, std::atoi(value));
+            else if (const char* value = valueOf("--out=")) options.outPath = value;
+            else if (arg == "--list") options.list = true;
+            // Argumen lain (mis. --engine=, --scene-frames=) dibaca oleh benchmark masing-masing
+        }
+        return options;
+    }
+
+    int runBenchmarks(int argc, char** argv) {
+        const Options options = parseOptions(argc, argv);
+        commandLine().assign(argv + 1, argv + argc);
+
+        if (options.list) {
+            for (const auto& benchmark : registry()) std::cout << benchmark->getName() << std::endl;
+            return EXIT_SUCCESS;
+        }
+
+        char header[256];
+        std::snprintf(header, sizeof(header), "%-48s %15s %15s %12s", "Benchmark", "Time", "CPU", "Iterations");
+        std::cout << header << std::endl << std::string(94, '-') << std::endl;
+
+        Runner runner(options);
+        for (const auto& benchmark : registry()) {
+            if (benchmark->getArgs().empty()) {
+                runner.run(*benchmark, 0, false);
+            } else {
+                for (int64_t argument : benchmark->getArgs()) runner.run(*benchmark, argument, true);
+            }
+        }
+
+        if (!options.outPath.empty()) {
+            if (!writeJson(options.outPath, runner.getResults())) {
+                std::cerr << "cogent_bench: tidak bisa menulis " << options.outPath << std::endl;
+                return EXIT_FAILURE;
+            }
+            std::cout << "Results written to " << options.outPath << std::endl;
+        }
+        return EXIT_SUCCESS; // Benchmark yang error tetap tercatat di JSON (error_occurred)
+    }
+}
@@ -0,0 +1,149 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <functional>
+#include <chrono>
+#include <ctime>
+#include <utility>
+
+// [NEW] Harness microbenchmark kecil untuk cogent_bench, gaya Google Benchmark:
+//
+//     static void BM_Something(Cogent::Bench::State& state) {
+//         for (auto _ : state) { ... }
+//         state.setItemsProcessed(state.iterations() * state.range());
+//     }
+//     COGENT_BENCHMARK(BM_Something)->range(1000, 1000000, 10);
+//
+// Jumlah iterasi dinaikkan otomatis sampai satu run >= --min-time. Output JSON mengikuti skema
+// Google Benchmark (context + benchmarks[]), jadi tools/compare.py bisa dipakai untuk regression.
+namespace Cogent::Bench {
+
+    class State {
+    public:
+        struct Value { ~Value() {} }; // Destructor non-trivial: tanpa warning "_" unused
+
+        class Iterator {
+        public:
+            Iterator(State* state, uint64_t remaining) : state(state), remaining(remaining) {}
+            Value operator*() const { return {}; }
+            Iterator& operator++() { --remaining; return *this; }
+            bool operator!=(const Iterator&) {
+                if (remaining != 0) return true;
+                state->stopTimer();
+                return false;
+            }
+        private:
+            State* state;
+            uint64_t remaining;
+        };
+
+        State(uint64_t maxIterations, std::vector<int64_t> args) : maxIterations(maxIterations), args(std::move(args)) {}
+
+        Iterator begin() { startTimer(); return Iterator(this, maxIterations); }
+        Iterator end() { return Iterator(this, 0); }
+
+        int64_t range(size_t index = 0) const { return index < args.size() ? args[index] : 0; }
+        uint64_t iterations() const { return maxIterations; }
+
+        // Setup di dalam loop yang tidak ikut diukur
+        void pauseTiming() { stopTimer(); }
+        void resumeTiming() { startTimer(); }
+
+        // Macro benchmark: waktu per iterasi diukur sendiri (mis. rata-rata frame engine headless)
+        void setIterationTime(double seconds) { manualSeconds += seconds; }
+
+        void setItemsProcessed(int64_t items) { itemsProcessed = items; }
+        void setBytesProcessed(int64_t bytes) { bytesProcessed = bytes; }
+        void setLabel(const std::string& text) { label = text; }
+        void setCounter(const std::string& name, double value) { counters.emplace_back(name, value); }
+        void skipWithError(const std::string& message) { error = message; }
+        bool hasError() const { return !error.empty(); }
+
+    private:
+        friend class Runner;
+
+        void startTimer() {
+            if (running) return;
+            running = true;
+            wallStart = std::chrono::steady_clock::now();
+            cpuStart = std::clock();
+        }
+        void stopTimer() {
+            if (!running) return;
+            running = false;
+            wallSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+            cpuSeconds += static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        }
+
+        uint64_t maxIterations;
+        std::vector<int64_t> args;
+
+        bool running = false;
+        std::chrono::steady_clock::time_point wallStart;
+        std::clock_t cpuStart = 0;
+        double wallSeconds = 0.0;
+        double cpuSeconds = 0.0;
+        double manualSeconds = 0.0;
+
+        int64_t itemsProcessed = 0;
+        int64_t bytesProcessed = 0;
+        std::string label;
+        std::string error;
+        std::vector<std::pair<std::string, double>> counters;
+    };
+
+    using Function = std::function<void(State&)>;
+
+    class Benchmark {
+    public:
+        Benchmark(std::string name, Function function) : name(std::move(name)), function(std::move(function)) {}
+
+        Benchmark* arg(int64_t value) { args.push_back(value); return this; }
+        // lo, lo*multiplier, ... sampai hi (hi selalu ikut)
+        Benchmark* range(int64_t lo, int64_t hi, int64_t multiplier = 8) {
+            for (int64_t value = lo; value < hi; value *= multiplier) args.push_back(value);
+            args.push_back(hi);
+            return this;
+        }
+        Benchmark* iterations(uint64_t count) { fixedIterations = count; return this; }
+        Benchmark* useManualTime() { manualTime = true; return this; }
+        Benchmark* unit(const char* timeUnit) { this->timeUnit = timeUnit; return this; } // "ns", "us", "ms"
+
+        const std::string& getName() const { return name; }
+        const std::vector<int64_t>& getArgs() const { return args; }
+
+    private:
+        friend class Runner;
+
+        std::string name;
+        Function function;
+        std::vector<int64_t> args;
+        uint64_t fixedIterations = 0; // 0 = otomatis dari --min-time
+        bool manualTime = false;
+        const char* timeUnit = "ns";
+    };
+
+    Benchmark* registerBenchmark(const char* name, Function function);
+    int runBenchmarks(int argc, char** argv);
+
+    // Nilai argumen command line "--name=value" milik benchmark tertentu (mis. --engine=), fallback kalau tidak ada
+    std::string getArgument(const std::string& prefix, const std::string& fallback = std::string());
+
+    // Cegah compiler membuang hasil yang tidak dipakai
+    template<typename T>
+    inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static const void* volatile sink;
+        sink = &value;
+#endif
+    }
+}
+
+#define COGENT_BENCH_CONCAT_INNER(a, b) a##b
+#define COGENT_BENCH_CONCAT(a, b) COGENT_BENCH_CONCAT_INNER(a, b)
+#define COGENT_BENCHMARK(function) \
+    static ::Cogent::Bench::Benchmark* COGENT_BENCH_CONCAT(cogentBenchmark_, __LINE__) = \
+        ::Cogent::Bench::registerBenchmark(#function, function)
@@ -0,0 +1,100 @@
+#include "Benchmark.hpp"
+#include "../Core/Threading/JobSystem.hpp"
+#include "../Core/Memory/LinearAllocator.hpp"
+#include "../Core/Memory/PoolAllocator.hpp"
+#include "../Core/Diagnostics/Profiler.hpp"
+#include <atomic>
+#include <vector>
+
+using Cogent::Bench::State;
+
+// ---------------------------------------------------------------- JobSystem
+
+// Dispatch N job kecil per group 64: overhead queue + sinkronisasi per item
+static void BM_JobSystem_Dispatch(State& state) {
+    const uint32_t jobCount = static_cast<uint32_t>(state.range());
+    std::vector<uint32_t> output(jobCount);
+    for (auto _ : state) {
+        Cogent::Threading::JobSystem::Get().Dispatch(jobCount, 64, [&](uint32_t i) { output[i] = i * 2654435761u; });
+        Cogent::Bench::doNotOptimize(output.data());
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * jobCount);
+}
+COGENT_BENCHMARK(BM_JobSystem_Dispatch)->range(1024, 1 << 20, 32);
+
+// Satu job per group: biaya murni Execute + ambil job dari queue
+static void BM_JobSystem_DispatchUngrouped(State& state) {
+    const uint32_t jobCount = static_cast<uint32_t>(state.range());
+    std::atomic<uint32_t> counter{0};
+    for (auto _ : state) {
+        Cogent::Threading::JobSystem::Get().Dispatch(jobCount, 1, [&](uint32_t) { counter.fetch_add(1, std::memory_order_relaxed); });
+    }
+    Cogent::Bench::doNotOptimize(counter.load());
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * jobCount);
+}
+COGENT_BENCHMARK(BM_JobSystem_DispatchUngrouped)->arg(64)->arg(1024);
+
+// ---------------------------------------------------------------- Allocators
+
+// Pola frame allocator: N alokasi kecil lalu clear() sekali per frame
+static void BM_LinearAllocator_Frame(State& state) {
+    const size_t allocations = static_cast<size_t>(state.range());
+    constexpr size_t ALLOCATION_SIZE = 48;
+    std::vector<uint8_t> memory(allocations * (ALLOCATION_SIZE + 16));
+    Cogent::Memory::LinearAllocator allocator(memory.size(), memory.data());
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < allocations; i++) {
+            Cogent::Bench::doNotOptimize(allocator.allocate(ALLOCATION_SIZE, 16));
+        }
+        allocator.clear();
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * allocations));
+}
+COGENT_BENCHMARK(BM_LinearAllocator_Frame)->range(1024, 65536, 8);
+
+// Allocate N object lalu free dengan urutan selang-seling (free list tidak lagi berurutan)
+static void BM_PoolAllocator_AllocFree(State& state) {
+    const size_t objects = static_cast<size_t>(state.range());
+    constexpr size_t OBJECT_SIZE = 64;
+    std::vector<uint8_t> memory((objects + 1) * OBJECT_SIZE);
+    Cogent::Memory::PoolAllocator allocator(OBJECT_SIZE, 16, memory.size(), memory.data());
+    std::vector<void*> pointers(objects);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < objects; i++) pointers[i] = allocator.allocate(OBJECT_SIZE, 16);
+        for (size_t i = 0; i < objects; i += 2) allocator.deallocate(pointers[i]);
+        for (size_t i = 1; i < objects; i += 2) allocator.deallocate(pointers[i]);
+        Cogent::Bench::doNotOptimize(pointers.data());
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations() * objects * 2));
+}
+COGENT_BENCHMARK(BM_PoolAllocator_AllocFree)->range(1024, 65536, 8);
+
+// ---------------------------------------------------------------- Profiler
+
+// Biaya PROFILE_SCOPE kosong (2x timestamp + push ring). Drain tiap 1024 scope di luar timing,
+// seperti BeginFrame engine, supaya ring tidak penuh dan event tidak di-drop.
+static void BM_Profiler_Scope(State& state) {
+    Cogent::Diagnostics::Profiler& profiler = Cogent::Diagnostics::Profiler::Get();
+    const bool wasEnabled = profiler.IsEnabled();
+    profiler.SetEnabled(state.range() != 0);
+    uint64_t frame = 0;
+    uint32_t scopesThisFrame = 0;
+    for (auto _ : state) {
+        {
+            PROFILE_SCOPE("BM_Profiler_Scope");
+        }
+        if (++scopesThisFrame == 1024) {
+            state.pauseTiming();
+            profiler.BeginFrame(frame++);
+            scopesThisFrame = 0;
+            state.resumeTiming();
+        }
+    }
+    profiler.BeginFrame(frame);
+    profiler.SetEnabled(wasEnabled);
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+// Argumen = profiler enabled (1) / disabled (0)
+COGENT_BENCHMARK(BM_Profiler_Scope)->arg(1)->arg(0)->unit("ns");
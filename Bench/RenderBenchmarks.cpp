@@ -0,0 +1,230 @@
+#include "Benchmark.hpp"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include "../Core/Math/Frustum.hpp"
+#include "../Renderer/Visibility/VisibilitySystem.hpp"
+#include "../Renderer/Visibility/BVH.hpp"
+#include "../Renderer/Graph/RenderGraph.hpp"
+#include "../Renderer/DrawBatcher.hpp"
+#include "../Geometry/Meshlet.hpp"
+#include "../Geometry/PrimitiveMesh.hpp"
+#include "../Scene/World.hpp"
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+
+using Cogent::Bench::State;
+
+namespace {
+
+    // Scene deterministik: mt19937 dengan seed tetap, konversi float manual (distribution
+    // std:: tidak dijamin sama antar standard library -> hasil beda antar compiler)
+    struct CullScene {
+        std::vector<Cogent::Math::AABB> boxes;
+        Cogent::Scene::World world;
+        Cogent::Math::Frustum frustum;
+        glm::mat4 viewProj{1.0f};
+    };
+
+    float unitFloat(std::mt19937& rng) {
+        return static_cast<float>(rng() >> 8) * (1.0f / 16777216.0f);
+    }
+
+    glm::mat4 benchViewProj() {
+        // Camera di atas grid melihat ke tengah (Z-up, sama dengan Camera engine)
+        const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, -60.0f, 25.0f), glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+        const glm::mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+        return proj * view;
+    }
+
+    // Scene per jumlah object dibuat sekali dan dipakai ulang antar run (setup 1M entity mahal)
+    CullScene& getCullScene(uint32_t count, bool withWorld) {
+        static std::map<uint32_t, std::unique_ptr<CullScene>> scenes;
+        std::unique_ptr<CullScene>& scene = scenes[count];
+        if (!scene) {
+            scene = std::make_unique<CullScene>();
+            std::mt19937 rng(1337u);
+            scene->boxes.resize(count);
+            for (uint32_t i = 0; i < count; i++) {
+                const glm::vec3 center((unitFloat(rng) - 0.5f) * 1000.0f, (unitFloat(rng) - 0.5f) * 1000.0f, (unitFloat(rng) - 0.5f) * 40.0f);
+                const glm::vec3 extent(0.5f + unitFloat(rng) * 1.5f);
+                scene->boxes[i] = { center - extent, center + extent };
+            }
+            scene->viewProj = benchViewProj();
+            scene->frustum.update(scene->viewProj);
+        }
+        if (withWorld && scene->world.size() != count) {
+            scene->world.reserve(count);
+            for (uint32_t i = 0; i < count; i++) {
+                const Cogent::Math::AABB& box = scene->boxes[i];
+                scene->world.create(0, glm::translate(glm::mat4(1.0f), (box.min + box.max) * 0.5f), glm::vec4(1.0f), std::string());
+                scene->world.bounds()[i] = { box.min, box.max };
+            }
+        }
+        return *scene;
+    }
+}
+
+// ---------------------------------------------------------------- Culling
+
+// Baseline scalar: satu checkAABB per object
+static void BM_Frustum_CheckAABB(State& state) {
+    const uint32_t count = static_cast<uint32_t>(state.range());
+    CullScene& scene = getCullScene(count, false);
+    uint32_t visible = 0;
+    for (auto _ : state) {
+        visible = 0;
+        for (const Cogent::Math::AABB& box : scene.boxes) visible += scene.frustum.checkAABB(box) ? 1u : 0u;
+        Cogent::Bench::doNotOptimize(visible);
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+    state.setCounter("visible", visible);
+}
+COGENT_BENCHMARK(BM_Frustum_CheckAABB)->range(1000, 1000000, 10);
+
+// VisibilitySystem::cull tanpa updateBounds (tidak butuh GeometryPool/device): path linear SIMD
+// dari kolom WorldBounds, paralel di JobSystem
+static void BM_VisibilitySystem_CullLinear(State& state) {
+    const uint32_t count = static_cast<uint32_t>(state.range());
+    CullScene& scene = getCullScene(count, true);
+    Cogent::Renderer::VisibilitySystem visibility;
+    visibility.setUseBVH(false);
+    visibility.update(scene.viewProj);
+    std::vector<uint32_t> visibleRows;
+    for (auto _ : state) {
+        visibility.cull(scene.world, visibleRows);
+        Cogent::Bench::doNotOptimize(visibleRows.data());
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+    state.setCounter("visible", static_cast<double>(visibleRows.size()));
+}
+COGENT_BENCHMARK(BM_VisibilitySystem_CullLinear)->range(1000, 1000000, 10);
+
+// Path default engine: query frustum BVH (temporal coherence aktif, seperti frame statis)
+static void BM_BVH_QueryFrustum(State& state) {
+    const uint32_t count = static_cast<uint32_t>(state.range());
+    CullScene& scene = getCullScene(count, false);
+    Cogent::Renderer::BVH bvh;
+    bvh.build(scene.boxes);
+    std::vector<uint32_t> visibleRows;
+    for (auto _ : state) {
+        visibleRows.clear();
+        bvh.queryFrustum(scene.frustum, visibleRows);
+        Cogent::Bench::doNotOptimize(visibleRows.data());
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+    state.setCounter("visible", static_cast<double>(visibleRows.size()));
+}
+COGENT_BENCHMARK(BM_BVH_QueryFrustum)->range(1000, 1000000, 10);
+
+// ---------------------------------------------------------------- Batching
+
+// Camera-only frame: visible set sama, hanya urutan hasil cull yang beda (traversal BVH ikut kamera).
+// Instance stream hasil build harus identik per page InstanceBuffer (0 page di-upload); kalau tidak,
+// benchmark gagal dengan jumlah page yang berubah.
+static void BM_DrawBatcher_CameraOnly(State& state) {
+    const uint32_t count = static_cast<uint32_t>(state.range());
+    CullScene& scene = getCullScene(count, true);
+    std::vector<uint32_t> rows(count);
+    std::iota(rows.begin(), rows.end(), 0u);
+    std::vector<uint32_t> reordered(rows.rbegin(), rows.rend());
+
+    Cogent::Renderer::DrawBatcher batcher;
+    batcher.build(scene.world, rows, 1);
+    const std::vector<Cogent::Renderer::InstanceData> previous = batcher.getInstances();
+
+    constexpr uint32_t PAGE_SIZE = Cogent::Renderer::InstanceBuffer::PAGE_SIZE;
+    uint32_t changedPages = 0;
+    for (auto _ : state) {
+        batcher.build(scene.world, reordered, 1);
+        const std::vector<Cogent::Renderer::InstanceData>& current = batcher.getInstances();
+        changedPages = 0;
+        const uint32_t instanceCount = static_cast<uint32_t>(std::max(previous.size(), current.size()));
+        for (uint32_t first = 0; first < instanceCount; first += PAGE_SIZE) {
+            const uint32_t last = std::min(instanceCount, first + PAGE_SIZE);
+            const bool sameSize = last <= previous.size() && last <= current.size();
+            if (!sameSize || std::memcmp(&previous[first], &current[first], sizeof(Cogent::Renderer::InstanceData) * (last - first)) != 0) {
+                changedPages++;
+            }
+        }
+        Cogent::Bench::doNotOptimize(changedPages);
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * count);
+    state.setCounter("changedPages", changedPages);
+    if (changedPages != 0) {
+        state.skipWithError("camera-only rebuild mengubah " + std::to_string(changedPages) + " page instance");
+    }
+}
+COGENT_BENCHMARK(BM_DrawBatcher_CameraOnly)->range(1000, 100000, 10);
+
+// ---------------------------------------------------------------- Meshlets
+
+// Argumen = sectors = stacks sphere (triangle ~ 2 * n^2)
+static void BM_MeshletBuilder_Build(State& state) {
+    const int resolution = static_cast<int>(state.range());
+    PrimitiveMesh mesh;
+    mesh.createSphere(1.0f, resolution, resolution);
+    std::vector<glm::vec3> positions;
+    positions.reserve(mesh.vertices.size());
+    for (const Vertex& vertex : mesh.vertices) positions.push_back(vertex.pos);
+
+    size_t meshletCount = 0;
+    for (auto _ : state) {
+        std::vector<Cogent::Geometry::Meshlet> meshlets = Cogent::Geometry::MeshletBuilder::build(mesh.indices, positions);
+        meshletCount = meshlets.size();
+        Cogent::Bench::doNotOptimize(meshlets.data());
+    }
+    const int64_t triangles = static_cast<int64_t>(mesh.indices.size() / 3);
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * triangles);
+    state.setCounter("triangles", static_cast<double>(triangles));
+    state.setCounter("meshlets", static_cast<double>(meshletCount));
+}
+COGENT_BENCHMARK(BM_MeshletBuilder_Build)->arg(64)->arg(256)->arg(512);
+
+// ---------------------------------------------------------------- RenderGraph
+
+// Build + compile graph N pass berantai (tiap pass baca output pass sebelumnya), seperti graph
+// yang dibangun ulang tiap frame. RenderGraph butuh GraphicsDevice: instance headless saja.
+static void BM_RenderGraph_Compile(State& state) {
+    static std::unique_ptr<GraphicsDevice> device;
+    static std::string deviceError;
+    if (!device && deviceError.empty()) {
+        try {
+            device = std::make_unique<GraphicsDevice>(false, true);
+        } catch (const std::exception& e) {
+            deviceError = e.what();
+        }
+    }
+    if (!device) {
+        state.skipWithError("GraphicsDevice: " + deviceError);
+        return;
+    }
+
+    const uint32_t passCount = static_cast<uint32_t>(state.range());
+    std::vector<std::string> names(passCount + 1);
+    for (uint32_t i = 0; i <= passCount; i++) names[i] = "Target" + std::to_string(i);
+
+    for (auto _ : state) {
+        RenderGraph graph(*device);
+        for (uint32_t i = 0; i <= passCount; i++) {
+            graph.registerImage(names[i], VK_NULL_HANDLE, VK_NULL_HANDLE, VK_FORMAT_R16G16B16A16_SFLOAT);
+        }
+        for (uint32_t i = 0; i < passCount; i++) {
+            RenderPassNode node;
+            node.name = names[i + 1];
+            node.inputs.push_back({ names[i], VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT });
+            node.outputs.push_back({ names[i + 1], VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                                     VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT });
+            node.setup = [](GraphicsDevice&) {};
+            node.execute = [](VkCommandBuffer) {};
+            graph.addPass(std::move(node));
+        }
+        graph.compile();
+    }
+    state.setItemsProcessed(static_cast<int64_t>(state.iterations()) * passCount);
+}
+COGENT_BENCHMARK(BM_RenderGraph_Compile)->arg(16)->arg(64)->arg(256);
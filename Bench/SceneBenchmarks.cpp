@@ -0,0 +1,179 @@
+#include "Benchmark.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using Cogent::Bench::State;
+
+// [NEW] Macro benchmark: jalankan COGENT_Engine --headless sebagai subprocess (instance Vulkan
+// terpisah, scene + pipeline lengkap) lalu baca CSV timing per frame dari HeadlessOptions.
+//   --engine=<path>        executable engine (default: hasil build CMake)
+//   --engine-cwd=<dir>     working dir engine, harus berisi Shaders/ (default: build dir)
+//   --scene-frames=<n>     frame per scenario (default 300, 30 pertama = warmup, tidak dihitung)
+#ifndef COGENT_ENGINE_EXECUTABLE
+#define COGENT_ENGINE_EXECUTABLE ""
+#endif
+#ifndef COGENT_ENGINE_WORKING_DIR
+#define COGENT_ENGINE_WORKING_DIR "."
+#endif
+
+namespace {
+
+    constexpr uint32_t WARMUP_FRAMES = 30;
+
+    // Set env var selama scope (diwarisi subprocess engine), nilai lama dikembalikan
+    class ScopedEnv {
+    public:
+        ScopedEnv(const char* name, const std::string& value) : name(name) {
+            if (const char* previous = std::getenv(name)) {
+                hadPrevious = true;
+                previousValue = previous;
+            }
+            set(value.c_str());
+        }
+        ~ScopedEnv() {
+            if (hadPrevious) set(previousValue.c_str());
+            else unset();
+        }
+        ScopedEnv(const ScopedEnv&) = delete;
+        ScopedEnv& operator=(const ScopedEnv&) = delete;
+
+    private:
+        void set(const char* value) {
+#ifdef _WIN32
+            _putenv_s(name, value);
+#else
+            setenv(name, value, 1);
+#endif
+        }
+        void unset() {
+#ifdef _WIN32
+            _putenv_s(name, "");
+#else
+            unsetenv(name);
+#endif
+        }
+
+        const char* name;
+        bool hadPrevious = false;
+        std::string previousValue;
+    };
+
+    struct FrameSample {
+        double frameMs = 0.0;
+        double cpuMs = 0.0;
+        double gpuMs = 0.0;
+    };
+
+    // Format dari CogentEngine::writeFrameTimings: frame,frame_ms,cpu_ms,gpu_ms
+    std::vector<FrameSample> readTimings(const std::string& path) {
+        std::vector<FrameSample> samples;
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line); // header
+        while (std::getline(file, line)) {
+            std::stringstream row(line);
+            std::string frame, frameMs, cpuMs, gpuMs;
+            if (!std::getline(row, frame, ',') || !std::getline(row, frameMs, ',') ||
+                !std::getline(row, cpuMs, ',') || !std::getline(row, gpuMs, ',')) continue;
+            samples.push_back({ std::atof(frameMs.c_str()), std::atof(cpuMs.c_str()), std::atof(gpuMs.c_str()) });
+        }
+        return samples;
+    }
+
+    double percentile(std::vector<double> values, double fraction) {
+        if (values.empty()) return 0.0;
+        std::sort(values.begin(), values.end());
+        const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size() - 1) + 0.5));
+        return values[index];
+    }
+
+    double mean(const std::vector<double>& values) {
+        if (values.empty()) return 0.0;
+        double sum = 0.0;
+        for (double v : values) sum += v;
+        return sum / static_cast<double>(values.size());
+    }
+
+    std::string quote(const std::string& text) { return "\"" + text + "\""; }
+
+    void runHeadlessScene(State& state, const std::vector<std::pair<const char*, std::string>>& environment) {
+        const std::string engine = Cogent::Bench::getArgument("--engine=", COGENT_ENGINE_EXECUTABLE);
+        const std::string workingDir = Cogent::Bench::getArgument("--engine-cwd=", COGENT_ENGINE_WORKING_DIR);
+        const uint32_t frames = static_cast<uint32_t>(std::strtoul(Cogent::Bench::getArgument("--scene-frames=", "300").c_str(), nullptr, 10));
+        if (engine.empty() || !std::filesystem::exists(engine)) {
+            state.skipWithError("engine executable tidak ditemukan (pakai --engine=<path>)");
+            return;
+        }
+        if (frames <= WARMUP_FRAMES) {
+            state.skipWithError("--scene-frames harus > " + std::to_string(WARMUP_FRAMES));
+            return;
+        }
+
+        const std::string timingsPath = (std::filesystem::temp_directory_path() / "cogent_bench_scene_timings.csv").string();
+        std::error_code ignored;
+        std::filesystem::remove(timingsPath, ignored);
+
+        std::vector<std::unique_ptr<ScopedEnv>> scopedEnv;
+        for (const auto& [name, value] : environment) scopedEnv.push_back(std::make_unique<ScopedEnv>(name, value));
+
+        // Log engine per frame tidak perlu ada di output bench
+#ifdef _WIN32
+        const std::string command = "cd /d " + quote(workingDir) + " && " + quote(engine) + " --headless --frames " + std::to_string(frames) +
+                                    " --timings " + quote(timingsPath) + " > NUL 2>&1";
+        const int status = std::system(("\"" + command + "\"").c_str()); // cmd /c butuh quote luar
+#else
+        const std::string command = "cd " + quote(workingDir) + " && " + quote(engine) + " --headless --frames " + std::to_string(frames) +
+                                    " --timings " + quote(timingsPath) + " > /dev/null 2>&1";
+        const int status = std::system(command.c_str());
+#endif
+        if (status != 0) {
+            state.skipWithError("engine headless exit status " + std::to_string(status) + " (lihat cogent_log.txt di " + workingDir + ")");
+            return;
+        }
+
+        const std::vector<FrameSample> samples = readTimings(timingsPath);
+        if (samples.size() <= WARMUP_FRAMES) {
+            state.skipWithError("timing CSV kosong / terlalu pendek: " + timingsPath);
+            return;
+        }
+
+        std::vector<double> frameMs, cpuMs, gpuMs;
+        for (size_t i = WARMUP_FRAMES; i < samples.size(); i++) {
+            frameMs.push_back(samples[i].frameMs);
+            cpuMs.push_back(samples[i].cpuMs);
+            gpuMs.push_back(samples[i].gpuMs);
+        }
+
+        // Satu iterasi = satu run engine; waktu yang dilaporkan = rata-rata frame time
+        for (auto _ : state) state.setIterationTime(mean(frameMs) / 1000.0);
+
+        state.setCounter("frames", static_cast<double>(frameMs.size()));
+        state.setCounter("frame_p50_ms", percentile(frameMs, 0.50));
+        state.setCounter("frame_p95_ms", percentile(frameMs, 0.95));
+        state.setCounter("frame_max_ms", percentile(frameMs, 1.0));
+        state.setCounter("cpu_mean_ms", mean(cpuMs));
+        state.setCounter("cpu_p95_ms", percentile(cpuMs, 0.95));
+        state.setCounter("gpu_mean_ms", mean(gpuMs));
+        state.setCounter("gpu_p95_ms", percentile(gpuMs, 0.95));
+    }
+}
+
+// Argumen = COGENT_BENCH_OBJECTS tambahan di atas demo scene (0 = demo scene saja); GPU culling default
+static void BM_HeadlessScene(State& state) {
+    std::vector<std::pair<const char*, std::string>> environment;
+    if (state.range() > 0) environment.emplace_back("COGENT_BENCH_OBJECTS", std::to_string(state.range()));
+    runHeadlessScene(state, environment);
+}
+COGENT_BENCHMARK(BM_HeadlessScene)->arg(0)->arg(10000)->arg(100000)->iterations(1)->useManualTime()->unit("ms");
+
+// Scene sama dengan culling CPU (BVH + occlusion software) untuk membandingkan jalur culling
+static void BM_HeadlessSceneCpuCulling(State& state) {
+    runHeadlessScene(state, { { "COGENT_BENCH_OBJECTS", std::to_string(state.range()) }, { "COGENT_CPU_CULLING", "1" } });
+}
+COGENT_BENCHMARK(BM_HeadlessSceneCpuCulling)->arg(100000)->iterations(1)->useManualTime()->unit("ms");
@@ -0,0 +1,14 @@
+#include "Benchmark.hpp"
+#include "../Core/Threading/JobSystem.hpp"
+#include "../Core/Logger.hpp"
+
+// [NEW] cogent_bench: microbenchmark subsystem + macro scenario engine headless.
+//   cogent_bench --out=bench.json [--filter=Cull] [--min-time=0.5] [--repetitions=5]
+// JSON kompatibel dengan tools/compare.py Google Benchmark untuk tracking regression antar commit.
+int main(int argc, char** argv) {
+    LOG_INIT("cogent_bench_log.txt");
+    Cogent::Threading::JobSystem::Get().Initialize();
+    const int result = Cogent::Bench::runBenchmarks(argc, argv);
+    Cogent::Threading::JobSystem::Get().Shutdown();
+    return result;
+}
@@ -1,99 +1,250 @@
 #include "GpuProfiler.hpp"
-#include <iostream>
+#include <algorithm>
 #include <stdexcept>
 #include "../Logger.hpp"
 
 namespace Cogent::Diagnostics {
 
-    void GpuProfiler::Init(GraphicsDevice& device) {
+    void GpuProfiler::Init(GraphicsDevice& device, uint32_t framesInFlight) {
         _device = &device;
 
+        uint32_t queueFamilyCount = 0;
+        vkGetPhysicalDeviceQueueFamilyProperties(device.getPhysicalDevice(), &queueFamilyCount, nullptr);
+        std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+        vkGetPhysicalDeviceQueueFamilyProperties(device.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+        const uint32_t validBits = queueFamilies[device.getGraphicsQueueFamily()].timestampValidBits;
+        if (validBits == 0) {
+            LOG_WARN("GpuProfiler: graphics queue tidak mendukung timestamp, GPU profiling nonaktif");
+            return;
+        }
+        _timestampMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+
         VkPhysicalDeviceProperties props;
         vkGetPhysicalDeviceProperties(device.getPhysicalDevice(), &props);
         _timestampPeriod = props.limits.timestampPeriod;
 
+        // Range [slot * QUERIES_PER_FRAME, +QUERIES_PER_FRAME) per frame in flight, + 1 query kalibrasi fallback
         VkQueryPoolCreateInfo poolInfo{};
         poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
         poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
-        poolInfo.queryCount = MAX_QUERIES;
+        poolInfo.queryCount = framesInFlight * QUERIES_PER_FRAME + 1;
 
         if (vkCreateQueryPool(device.getDevice(), &poolInfo, nullptr, &_queryPool) != VK_SUCCESS) {
             LOG_ERROR("Failed to create timestamp query pool!");
+            _queryPool = VK_NULL_HANDLE;
+            return;
         }
+
+        _hostQueryReset = device.supportsHostQueryReset();
+        if (_hostQueryReset) vkResetQueryPool(device.getDevice(), _queryPool, 0, poolInfo.queryCount);
+        _frames.assign(framesInFlight, FrameQueries{});
+        _readback.resize(QUERIES_PER_FRAME * 2);
+        _currentSlot = ~0u;
+        _droppedScopes = 0;
+
+        // Pakai calibrated timestamps hanya kalau domain device benar-benar bisa di-sample
+        _getCalibratedTimestamps = nullptr;
+        if (device.supportsCalibratedTimestamps()) {
+            auto getTimeDomains = reinterpret_cast<PFN_vkGetPhysicalDeviceCalibrateableTimeDomainsEXT>(
+                vkGetInstanceProcAddr(device.getInstance(), "vkGetPhysicalDeviceCalibrateableTimeDomainsEXT"));
+            uint32_t domainCount = 0;
+            std::vector<VkTimeDomainEXT> domains;
+            if (getTimeDomains && getTimeDomains(device.getPhysicalDevice(), &domainCount, nullptr) == VK_SUCCESS) {
+                domains.resize(domainCount);
+                getTimeDomains(device.getPhysicalDevice(), &domainCount, domains.data());
+            }
+            if (std::find(domains.begin(), domains.end(), VK_TIME_DOMAIN_DEVICE_EXT) != domains.end()) {
+                _getCalibratedTimestamps = reinterpret_cast<PFN_vkGetCalibratedTimestampsEXT>(
+                    vkGetDeviceProcAddr(device.getDevice(), "vkGetCalibratedTimestampsEXT"));
+            }
+        }
+
+        _track = Profiler::Get().CreateTrack("GPU (graphics queue)");
+        Calibrate();
+        LOG_INFO("GpuProfiler: " + std::to_string(framesInFlight) + " x " + std::to_string(QUERIES_PER_FRAME) + " queries, " +
+                 (_getCalibratedTimestamps ? "calibrated timestamps" : "kalibrasi sekali lewat query") +
+                 (_hostQueryReset ? ", host query reset" : ""));
     }
 
     void GpuProfiler::Cleanup() {
-        if (_queryPool != VK_NULL_HANDLE) {
-            vkDestroyQueryPool(_device->getDevice(), _queryPool, nullptr);
+        if (_queryPool == VK_NULL_HANDLE) return;
+
+        // Dipanggil setelah vkDeviceWaitIdle: semua frame yang masih pending sudah selesai
+        for (uint32_t slot = 0; slot < _frames.size(); slot++) ResolveSlot(slot, true);
+        if (_droppedScopes > 0) {
+            LOG_WARN("GpuProfiler: " + std::to_string(_droppedScopes) + " scope di-drop (query per frame penuh / hasil tidak tersedia)");
         }
+
+        vkDestroyQueryPool(_device->getDevice(), _queryPool, nullptr);
+        _queryPool = VK_NULL_HANDLE;
+        _frames.clear();
+        _openScopes.clear();
+        _currentSlot = ~0u;
+    }
+
+    void GpuProfiler::Calibrate() {
+        const VkDevice device = _device->getDevice();
+
+        if (_getCalibratedTimestamps) {
+            VkCalibratedTimestampInfoEXT info{};
+            info.sType = VK_STRUCTURE_TYPE_CALIBRATED_TIMESTAMP_INFO_EXT;
+            info.timeDomain = VK_TIME_DOMAIN_DEVICE_EXT;
+
+            // Clock Profiler (rdtsc) bukan time domain Vulkan: sample GPU diapit dua Ticks(), ambil tengahnya
+            uint64_t gpuTicks = 0;
+            uint64_t maxDeviation = 0;
+            const uint64_t before = Profiler::Ticks();
+            const VkResult result = _getCalibratedTimestamps(device, 1, &info, &gpuTicks, &maxDeviation);
+            const uint64_t after = Profiler::Ticks();
+            if (result == VK_SUCCESS) {
+                _calibrationGpuTicks = gpuTicks & _timestampMask;
+                _calibrationCpuTicks = before + (after - before) / 2;
+                _framesSinceCalibration = 0;
+                return;
+            }
+            LOG_WARN("GpuProfiler: vkGetCalibratedTimestampsEXT gagal, fallback ke timestamp query");
+            _getCalibratedTimestamps = nullptr;
+        }
+
+        // [FALLBACK] Tulis satu timestamp di submit terpisah dan tunggu. Error ~ setengah latency submit,
+        // cukup untuk menyejajarkan timeline secara kasar; hanya sekali saat Init (submit ini sinkron).
+        const uint32_t query = static_cast<uint32_t>(_frames.size()) * QUERIES_PER_FRAME;
+        VkCommandBuffer cmd = _device->beginSingleTimeCommands();
+        vkCmdResetQueryPool(cmd, _queryPool, query, 1);
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _queryPool, query);
+        const uint64_t before = Profiler::Ticks();
+        _device->endSingleTimeCommands(cmd);
+        const uint64_t after = Profiler::Ticks();
+
+        uint64_t gpuTicks = 0;
+        if (vkGetQueryPoolResults(device, _queryPool, query, 1, sizeof(gpuTicks), &gpuTicks, sizeof(gpuTicks),
+                                  VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT) == VK_SUCCESS) {
+            _calibrationGpuTicks = gpuTicks & _timestampMask;
+            _calibrationCpuTicks = before + (after - before) / 2;
+        }
+        _framesSinceCalibration = 0;
+    }
+
+    uint64_t GpuProfiler::ToProfilerTicks(uint64_t gpuTicks) const {
+        // Selisih terhadap titik kalibrasi, wrap-around sesuai timestampValidBits
+        const uint64_t delta = (gpuTicks - _calibrationGpuTicks) & _timestampMask;
+        int64_t signedDelta = static_cast<int64_t>(delta);
+        if (_timestampMask != ~0ull && delta > (_timestampMask >> 1)) signedDelta -= static_cast<int64_t>(_timestampMask) + 1;
+
+        const double ticks = Profiler::Get().NsToTicks(static_cast<double>(signedDelta) * _timestampPeriod);
+        return static_cast<uint64_t>(static_cast<int64_t>(_calibrationCpuTicks) + static_cast<int64_t>(ticks));
     }
 
-    void GpuProfiler::BeginFrame(VkCommandBuffer cmd) {
-        vkCmdResetQueryPool(cmd, _queryPool, 0, MAX_QUERIES);
-        _currentQuery = 0;
-        _activeScopes.clear();
+    ScopeID GpuProfiler::RegisterScope(const std::string& name) {
+        return Profiler::Get().RegisterScope("GPU " + name);
     }
 
-    void GpuProfiler::EndFrame() {
-        // Nothing to do here specifically for queries, we wait for next frame or explicit Retrieve
+    void GpuProfiler::BeginFrame(VkCommandBuffer cmd, uint32_t frameSlot) {
+        if (!IsActive() || frameSlot >= _frames.size()) return;
+
+        // Fence slot ini sudah di-wait: hasil lama pasti selesai, baca sebelum range dipakai ulang
+        ResolveSlot(frameSlot, true);
+        if (_getCalibratedTimestamps && ++_framesSinceCalibration >= CALIBRATION_INTERVAL) Calibrate();
+
+        FrameQueries& frame = _frames[frameSlot];
+        frame.scopes.clear();
+        frame.queryCount = 0;
+        frame.pending = false;
+        _openScopes.clear();
+        _currentSlot = ~0u;
+        if (!Profiler::Get().IsEnabled()) return; // Scope jadi no-op selama frame ini
+
+        if (!_hostQueryReset) vkCmdResetQueryPool(cmd, _queryPool, frameSlot * QUERIES_PER_FRAME, QUERIES_PER_FRAME);
+        _currentSlot = frameSlot;
+
+        static const ScopeID frameScope = RegisterScope("Frame");
+        BeginScope(cmd, frameScope);
     }
 
-    void GpuProfiler::BeginTimestamp(VkCommandBuffer cmd, const std::string& name) {
-        if (_currentQuery >= MAX_QUERIES - 1) return;
+    void GpuProfiler::EndFrame(VkCommandBuffer cmd) {
+        if (_currentSlot == ~0u) return;
 
-        uint32_t idx = _currentQuery++;
-        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _queryPool, idx);
+        if (_openScopes.size() > 1) {
+            LOG_WARN("GpuProfiler: " + std::to_string(_openScopes.size() - 1) + " scope belum ditutup di akhir frame");
+        }
+        while (!_openScopes.empty()) EndScope(cmd); // Termasuk scope "Frame" dari BeginFrame
+        _frames[_currentSlot].pending = true;
+        _currentSlot = ~0u;
+    }
 
-        GpuTimerScope scope;
-        scope.name = name;
-        scope.startIndex = idx;
-        scope.endIndex = 0; // Will be set in EndTimestamp
-        _activeScopes.push_back(scope);
+    void GpuProfiler::BeginScope(VkCommandBuffer cmd, ScopeID scope) {
+        if (_currentSlot == ~0u) return;
+
+        FrameQueries& frame = _frames[_currentSlot];
+        if (frame.queryCount + 2 > QUERIES_PER_FRAME) {
+            _openScopes.push_back(~0u); // Tetap di-push supaya EndScope berikutnya seimbang
+            _droppedScopes++;
+            return;
+        }
+
+        // Query end dipesan sekarang: index tetap berurutan walau scope nested ditutup belakangan
+        GpuTimerScope record{ scope, frame.queryCount, frame.queryCount + 1, static_cast<uint32_t>(_openScopes.size()) };
+        frame.queryCount += 2;
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, _queryPool, _currentSlot * QUERIES_PER_FRAME + record.beginQuery);
+
+        _openScopes.push_back(static_cast<uint32_t>(frame.scopes.size()));
+        frame.scopes.push_back(record);
     }
 
-    void GpuProfiler::EndTimestamp(VkCommandBuffer cmd, const std::string& name) {
-        if (_currentQuery >= MAX_QUERIES) return;
+    void GpuProfiler::EndScope(VkCommandBuffer cmd) {
+        if (_currentSlot == ~0u || _openScopes.empty()) return;
 
-        uint32_t idx = _currentQuery++;
-        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _queryPool, idx);
+        const uint32_t index = _openScopes.back();
+        _openScopes.pop_back();
+        if (index == ~0u) return;
 
-        // Find the matching scope
-        for (auto& scope : _activeScopes) {
-            if (scope.name == name && scope.endIndex == 0) {
-                scope.endIndex = idx;
-                break;
-            }
+        const GpuTimerScope& record = _frames[_currentSlot].scopes[index];
+        vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, _queryPool, _currentSlot * QUERIES_PER_FRAME + record.endQuery);
+    }
+
+    void GpuProfiler::Collect() {
+        // Tanpa host reset, range baru di-reset oleh GPU: nilai frame lama masih "available" sampai command
+        // reset dieksekusi, jadi slot hanya aman dibaca setelah fence-nya (BeginFrame).
+        if (!IsActive() || !_hostQueryReset) return;
+        for (uint32_t slot = 0; slot < _frames.size(); slot++) {
+            if (slot != _currentSlot) ResolveSlot(slot, false);
         }
     }
 
-    void GpuProfiler::RetrieveResults() {
-        if (_currentQuery == 0) return;
-
-        std::vector<uint64_t> queryResults(_currentQuery);
-        VkResult res = vkGetQueryPoolResults(
-            _device->getDevice(), 
-            _queryPool, 
-            0, _currentQuery, 
-            _currentQuery * sizeof(uint64_t), 
-            queryResults.data(), 
-            sizeof(uint64_t), 
-            VK_QUERY_RESULT_64_BIT
-        );
-
-        if (res == VK_SUCCESS) {
-            for (const auto& scope : _activeScopes) {
-                if (scope.endIndex == 0) continue; // Unfinished scope
-
-                uint64_t start = queryResults[scope.startIndex];
-                uint64_t end = queryResults[scope.endIndex];
-                
-                float durationNs = (end - start) * _timestampPeriod;
-                float durationMs = durationNs / 1000000.0f;
-
-                _results[scope.name] = durationMs;
-                // Optional: Print or store
-                // LOG_INFO("GPU Profile [" + scope.name + "]: " + std::to_string(durationMs) + "ms");
+    bool GpuProfiler::ResolveSlot(uint32_t slot, bool final) {
+        FrameQueries& frame = _frames[slot];
+        if (!frame.pending) return true;
+        if (frame.queryCount == 0) {
+            frame.pending = false;
+            return true;
+        }
+
+        // Non-blocking: tiap query = { timestamp, availability }. VK_NOT_READY = masih ada yang belum selesai.
+        const VkResult result = vkGetQueryPoolResults(_device->getDevice(), _queryPool, slot * QUERIES_PER_FRAME, frame.queryCount,
+                                                      frame.queryCount * 2 * sizeof(uint64_t), _readback.data(), 2 * sizeof(uint64_t),
+                                                      VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (result == VK_NOT_READY && !final) return false;
+
+        if (result == VK_SUCCESS || result == VK_NOT_READY) {
+            Profiler& profiler = Profiler::Get();
+            for (const GpuTimerScope& record : frame.scopes) {
+                const uint64_t* begin = &_readback[record.beginQuery * 2];
+                const uint64_t* end = &_readback[record.endQuery * 2];
+                if (begin[1] == 0 || end[1] == 0) {
+                    _droppedScopes++;
+                    continue;
+                }
+                const uint64_t beginTicks = ToProfilerTicks(begin[0] & _timestampMask);
+                const uint64_t endTicks = std::max(beginTicks, ToProfilerTicks(end[0] & _timestampMask));
+                profiler.WriteTrackEvent(_track, record.scope, beginTicks, endTicks, record.depth);
             }
+        } else {
+            LOG_ERROR("GpuProfiler: vkGetQueryPoolResults gagal (" + std::to_string(static_cast<int>(result)) + ")");
         }
+
+        // Host reset langsung setelah dibaca: query jadi unavailable sampai GPU menulis frame berikutnya
+        if (_hostQueryReset) vkResetQueryPool(_device->getDevice(), _queryPool, slot * QUERIES_PER_FRAME, frame.queryCount);
+        frame.pending = false;
+        return true;
     }
 }
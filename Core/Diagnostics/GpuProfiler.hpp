@@ -2,15 +2,27 @@
 #include <vulkan/vulkan.h>
 #include <vector>
 #include <string>
-#include <unordered_map>
 #include "../Graphics/GraphicsDevice.hpp"
+#include "Profiler.hpp"
 
 namespace Cogent::Diagnostics {
 
+    // [MODIFIED] GPU timestamp profiler untuk frame yang di-pipeline:
+    // - tiap frame in flight punya range query sendiri di satu pool (dulu satu range dipakai semua frame)
+    // - hasil dibaca non-blocking dengan availability bit; frame yang belum selesai ditunggu di Collect berikutnya
+    // - scope boleh nested
+    // - timestamp GPU dikonversi ke clock Profiler (VK_EXT_calibrated_timestamps) lalu ditulis ke track
+    //   "GPU" Profiler: satu trace Chrome berisi timeline CPU + GPU, dan statistik window ikut terisi ("GPU <nama>")
+    //
+    //     GpuProfiler::Get().BeginFrame(cmd, currentFrame); // setelah fence slot di-wait, sebelum pass pertama
+    //     { GPU_PROFILE_SCOPE(cmd, "GBuffer"); ... }        // name harus string literal
+    //     GpuProfiler::Get().EndFrame(cmd);
+
     struct GpuTimerScope {
-        std::string name;
-        uint32_t startIndex;
-        uint32_t endIndex;
+        ScopeID scope;
+        uint32_t beginQuery; // Index query relatif ke awal range slot
+        uint32_t endQuery;
+        uint32_t depth;
     };
 
     class GpuProfiler {
@@ -20,29 +32,75 @@ namespace Cogent::Diagnostics {
             return instance;
         }
 
-        void Init(GraphicsDevice& device);
+        void Init(GraphicsDevice& device, uint32_t framesInFlight);
         void Cleanup();
 
-        void BeginFrame(VkCommandBuffer cmd);
-        void EndFrame();
+        // frameSlot = index frame in flight; fence slot ini harus sudah di-wait
+        void BeginFrame(VkCommandBuffer cmd, uint32_t frameSlot);
+        void EndFrame(VkCommandBuffer cmd);
+
+        // Intern nama runtime (mis. pass render graph) sebagai "GPU <name>"
+        ScopeID RegisterScope(const std::string& name);
+        void BeginScope(VkCommandBuffer cmd, ScopeID scope);
+        void EndScope(VkCommandBuffer cmd);
 
-        void BeginTimestamp(VkCommandBuffer cmd, const std::string& name);
-        void EndTimestamp(VkCommandBuffer cmd, const std::string& name);
+        // Baca hasil slot mana saja yang sudah selesai di GPU, tanpa menunggu
+        void Collect();
 
-        // Retrieve results from previous frame
-        void RetrieveResults();
+        bool IsActive() const { return _queryPool != VK_NULL_HANDLE; }
 
     private:
         GpuProfiler() = default;
 
+        struct FrameQueries {
+            std::vector<GpuTimerScope> scopes;
+            uint32_t queryCount = 0;
+            bool pending = false; // Sudah di-record, hasil belum dibaca
+        };
+
+        // final = slot akan dipakai ulang: scope yang belum available di-drop, bukan ditunggu
+        bool ResolveSlot(uint32_t slot, bool final);
+        void Calibrate();
+        uint64_t ToProfilerTicks(uint64_t gpuTicks) const;
+
         GraphicsDevice* _device = nullptr;
         VkQueryPool _queryPool = VK_NULL_HANDLE;
-        float _timestampPeriod = 1.0f;
+        float _timestampPeriod = 1.0f;  // ns per tick GPU
+        uint64_t _timestampMask = ~0ull; // timestampValidBits queue graphics
+        bool _hostQueryReset = false;
+
+        static constexpr uint32_t QUERIES_PER_FRAME = 256; // 128 scope per frame
+        static constexpr uint32_t CALIBRATION_INTERVAL = 600; // Frame; clock CPU/GPU drift pelan
+        std::vector<FrameQueries> _frames;
+        uint32_t _currentSlot = ~0u; // ~0u = di luar BeginFrame/EndFrame
+        std::vector<uint32_t> _openScopes; // Index ke _frames[_currentSlot].scopes, ~0u = scope overflow
+        std::vector<uint64_t> _readback;
+        uint64_t _droppedScopes = 0;
+
+        // Titik kalibrasi: timestamp GPU yang sama dengan Profiler::Ticks() di CPU
+        PFN_vkGetCalibratedTimestampsEXT _getCalibratedTimestamps = nullptr;
+        uint64_t _calibrationGpuTicks = 0;
+        uint64_t _calibrationCpuTicks = 0;
+        uint32_t _framesSinceCalibration = 0;
 
-        static const uint32_t MAX_QUERIES = 128; // Max 64 scopes per frame
-        uint32_t _currentQuery = 0;
+        uint32_t _track = 0; // Track "GPU" di Profiler
+    };
+
+    class GpuScope {
+    public:
+        GpuScope(VkCommandBuffer cmd, ScopeID scope) : _cmd(cmd) { GpuProfiler::Get().BeginScope(cmd, scope); }
+        ~GpuScope() { GpuProfiler::Get().EndScope(_cmd); }
 
-        std::vector<GpuTimerScope> _activeScopes;
-        std::unordered_map<std::string, float> _results; // Name -> Time in ms
+        GpuScope(const GpuScope&) = delete;
+        GpuScope& operator=(const GpuScope&) = delete;
+
+    private:
+        VkCommandBuffer _cmd;
     };
 }
+
+// [NEW] Timestamp GPU di sekitar command dalam scope C++ ini (nama di-intern sekali per call site)
+#define GPU_PROFILE_SCOPE(cmd, name) \
+    static const ::Cogent::Diagnostics::ScopeID PROFILE_CONCAT(gpuScopeID, __LINE__) = \
+        ::Cogent::Diagnostics::Profiler::Get().RegisterScope("GPU " name); \
+    ::Cogent::Diagnostics::GpuScope PROFILE_CONCAT(gpuScope, __LINE__)(cmd, PROFILE_CONCAT(gpuScopeID, __LINE__))
@@ -0,0 +1,392 @@
+#include "Profiler.hpp"
+#include "../Logger.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace Cogent::Diagnostics {
+
+    Profiler::Profiler() {
+        if (const char* value = std::getenv("COGENT_PROFILER")) _enabled.store(std::string(value) != "0");
+
+#if defined(COGENT_PROFILER_RDTSC)
+        // Kalibrasi TSC terhadap steady_clock (sekali, ~10 ms saat startup). TSC invariant di CPU x86 modern.
+        const auto wallBegin = std::chrono::steady_clock::now();
+        const uint64_t ticksBegin = Ticks();
+        auto wallEnd = wallBegin;
+        while (wallEnd - wallBegin < std::chrono::milliseconds(10)) wallEnd = std::chrono::steady_clock::now();
+        const uint64_t ticksEnd = Ticks();
+        const double wallNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(wallEnd - wallBegin).count());
+        if (ticksEnd > ticksBegin) _nsPerTick = wallNs / static_cast<double>(ticksEnd - ticksBegin);
+#endif
+    }
+
+    ScopeID Profiler::FindScopeLocked(const char* name) const {
+        const uint32_t count = _scopeCount.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < count; i++) {
+            const char* existing = _scopeNames[i].load(std::memory_order_relaxed);
+            if (existing == name || std::strcmp(existing, name) == 0) return i;
+        }
+        return MAX_SCOPES;
+    }
+
+    ScopeID Profiler::InsertScopeLocked(const char* name) {
+        const uint32_t count = _scopeCount.load(std::memory_order_relaxed);
+        if (count == MAX_SCOPES - 1) {
+            // Slot terakhir dipakai bersama semua scope yang tidak kebagian ID
+            _scopeNames[count].store("(scope overflow)", std::memory_order_release);
+            return count;
+        }
+        _scopeNames[count].store(name, std::memory_order_release);
+        _scopeCount.store(count + 1, std::memory_order_release);
+        return count;
+    }
+
+    ScopeID Profiler::RegisterScope(const char* name) {
+        std::lock_guard<std::mutex> lock(_scopeMutex);
+        const ScopeID existing = FindScopeLocked(name);
+        return existing != MAX_SCOPES ? existing : InsertScopeLocked(name);
+    }
+
+    ScopeID Profiler::RegisterScope(const std::string& name) {
+        // [FIX] Cari, salin, dan tambah di bawah satu lock: dua thread dengan nama baru yang sama
+        // tidak bisa sama-sama lolos pencarian lalu membuat dua entry
+        std::lock_guard<std::mutex> lock(_scopeMutex);
+        const ScopeID existing = FindScopeLocked(name.c_str());
+        if (existing != MAX_SCOPES) return existing;
+        if (_scopeCount.load(std::memory_order_relaxed) == MAX_SCOPES - 1) return InsertScopeLocked(name.c_str()); // Overflow: tidak disalin
+        _ownedScopeNames.push_back(name);
+        return InsertScopeLocked(_ownedScopeNames.back().c_str());
+    }
+
+    const char* Profiler::GetScopeName(ScopeID id) const {
+        const char* name = id < MAX_SCOPES ? _scopeNames[id].load(std::memory_order_acquire) : nullptr;
+        return name ? name : "(unknown)";
+    }
+
+    Profiler::ThreadBuffer* Profiler::RegisterThread() {
+        // Buffer dimiliki Profiler (bukan thread_local) supaya event tetap bisa di-drain setelah thread selesai
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+        _threads.push_back(std::make_unique<ThreadBuffer>());
+        ThreadBuffer* buffer = _threads.back().get();
+        buffer->threadID = static_cast<uint32_t>(_threads.size()); // tid 0 = track frame
+        buffer->name = "Thread " + std::to_string(buffer->threadID);
+        LocalBuffer() = buffer;
+        return buffer;
+    }
+
+    void Profiler::SetThreadName(const std::string& name) {
+        ThreadBuffer* buffer = LocalBuffer();
+        if (!buffer) buffer = RegisterThread();
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+        buffer->name = name;
+    }
+
+    uint32_t Profiler::CreateTrack(const std::string& name) {
+        std::lock_guard<std::mutex> lock(_threadsMutex);
+        _threads.push_back(std::make_unique<ThreadBuffer>());
+        ThreadBuffer* buffer = _threads.back().get();
+        buffer->threadID = static_cast<uint32_t>(_threads.size());
+        buffer->gpu = true;
+        buffer->name = name;
+        return static_cast<uint32_t>(_threads.size() - 1);
+    }
+
+    void Profiler::WriteTrackEvent(uint32_t track, ScopeID scope, uint64_t beginTicks, uint64_t endTicks, uint32_t depth) {
+        if (!IsEnabled()) return;
+        std::lock_guard<std::mutex> lock(_threadsMutex); // _threads bisa bertambah dari thread lain
+        if (track < _threads.size()) Push(*_threads[track], nullptr, scope, beginTicks, endTicks, depth);
+    }
+
+    void Profiler::BeginSession(const std::string& name, const std::string& path) {
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        if (_recording.load()) {
+            LOG_WARN("Profiler: session '" + _sessionName + "' masih aktif, BeginSession diabaikan");
+            return;
+        }
+        _pendingFrames = 0;
+        _remainingFrames = 0;
+        _frameCapture = false;
+        StartRecording(name, path);
+    }
+
+    void Profiler::EndSession() {
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        _pendingFrames = 0;
+        if (!_recording.load()) return;
+        if (!_frames.empty() && _frames.back().endTicks == 0) _frames.back().endTicks = Ticks();
+        Drain();
+        StopAndWrite();
+    }
+
+    void Profiler::CaptureFrames(uint32_t frameCount, const std::string& path) {
+        if (frameCount == 0) return;
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        if (_recording.load()) {
+            LOG_WARN("Profiler: capture sedang berjalan, CaptureFrames diabaikan");
+            return;
+        }
+        _pendingFrames = frameCount;
+        _sessionPath = path;
+    }
+
+    void Profiler::BeginFrame(uint64_t frameNumber) {
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        const uint64_t now = Ticks();
+
+        // Event frame sebelumnya -> slot window saat ini, lalu geser window satu frame
+        if (_recording.load() && !_frames.empty() && _frames.back().endTicks == 0) _frames.back().endTicks = now;
+        Drain();
+        AdvanceStatsFrame();
+
+        if (_recording.load() && _frameCapture && --_remainingFrames == 0) StopAndWrite();
+
+        if (_pendingFrames > 0 && !_recording.load()) {
+            _remainingFrames = _pendingFrames;
+            _pendingFrames = 0;
+            _frameCapture = true;
+            StartRecording("COGENT frames", _sessionPath);
+        }
+
+        // Frame pertama capture mulai saat recording aktif (bukan sebelum _sessionBeginTicks)
+        if (_recording.load()) _frames.push_back({ frameNumber, std::max(now, _sessionBeginTicks), 0 });
+    }
+
+    void Profiler::StartRecording(const std::string& name, const std::string& path) {
+        _sessionName = name;
+        _sessionPath = path;
+        _captured.clear();
+        _frames.clear();
+
+        {
+            std::lock_guard<std::mutex> threadsLock(_threadsMutex);
+            for (const std::unique_ptr<ThreadBuffer>& buffer : _threads) buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+
+        // Event yang mulai sebelum titik ini masih ada di ring, disaring saat export
+        _sessionBeginTicks = Ticks();
+        _recording.store(true);
+        LOG_INFO("Profiler: recording '" + name + "' -> " + path);
+    }
+
+    ScopeID Profiler::ResolveScope(const RingEvent& event) {
+        if (!event.name) return event.key;
+
+        auto it = _literalScopes.find(event.key);
+        if (it != _literalScopes.end() && (it->second.name == event.name || std::strcmp(it->second.name, event.name) == 0)) {
+            return it->second.id;
+        }
+        // Pertama kali terlihat (atau collision hash: tidak di-cache, tetap benar lewat RegisterScope)
+        const ScopeID id = RegisterScope(event.name);
+        if (it == _literalScopes.end()) _literalScopes.emplace(event.key, LiteralScope{ id, event.name });
+        return id;
+    }
+
+    void Profiler::Drain() {
+        auto growWindows = [this](size_t scopeCount) {
+            if (_windows.size() >= scopeCount) return;
+            const size_t first = _windows.size();
+            _windows.resize(scopeCount);
+            for (size_t i = first; i < _windows.size(); i++) _windows[i].frames.resize(_windowFrames + 1);
+        };
+        growWindows(std::min(_scopeCount.load(std::memory_order_acquire) + 1, MAX_SCOPES));
+        const bool recording = _recording.load();
+
+        std::lock_guard<std::mutex> threadsLock(_threadsMutex);
+        for (const std::unique_ptr<ThreadBuffer>& buffer : _threads) {
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            uint64_t tail = buffer->tail.load(std::memory_order_relaxed);
+            for (; tail < head; tail++) {
+                const RingEvent& raw = buffer->events[tail & (ThreadBuffer::CAPACITY - 1)];
+                const TraceEvent event{ raw.beginTicks, raw.endTicks, ResolveScope(raw), raw.depth };
+                if (event.scope < MAX_SCOPES) growWindows(event.scope + 1);
+                if (event.scope < _windows.size()) {
+                    const double ns = TicksToNs(event.endTicks - event.beginTicks);
+                    const uint32_t bucket = BucketOf(ns);
+                    for (Histogram* histogram : { &_windows[event.scope].frames[_windowSlot], &_windows[event.scope].total }) {
+                        histogram->buckets[bucket]++;
+                        histogram->count++;
+                        histogram->sumNs += ns;
+                        histogram->maxNs = std::max(histogram->maxNs, ns);
+                    }
+                }
+                if (recording) _captured.push_back({ event, buffer->threadID, buffer->gpu });
+            }
+            buffer->tail.store(tail, std::memory_order_release);
+        }
+    }
+
+    void Profiler::AdvanceStatsFrame() {
+        // Slot = frame selesai di window + satu slot kosong untuk frame yang sedang berjalan
+        _windowSlot = (_windowSlot + 1) % (_windowFrames + 1);
+        _windowFilled = std::min(_windowFilled + 1, _windowFrames);
+
+        // Frame tertua keluar dari window: kurangi dari total, max dihitung ulang dari frame yang tersisa
+        for (ScopeWindow& window : _windows) {
+            Histogram& expired = window.frames[_windowSlot];
+            if (expired.count == 0) continue;
+            for (uint32_t b = 0; b < HISTOGRAM_BUCKETS; b++) window.total.buckets[b] -= expired.buckets[b];
+            window.total.count -= expired.count;
+            window.total.sumNs -= expired.sumNs;
+            expired = Histogram{};
+            window.total.maxNs = 0.0;
+            for (const Histogram& frame : window.frames) window.total.maxNs = std::max(window.total.maxNs, frame.maxNs);
+        }
+    }
+
+    void Profiler::SetStatsWindow(uint32_t frames) {
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        _windowFrames = std::max(frames, 1u);
+        _windowSlot = 0;
+        _windowFilled = 0;
+        for (ScopeWindow& window : _windows) {
+            window.frames.assign(_windowFrames + 1, Histogram{});
+            window.total = Histogram{};
+        }
+    }
+
+    // Bucket: 0..3 ns langsung, lalu 4 sub-bucket per oktaf (e = floor(log2(ns))), maksimum ~4 s
+    uint32_t Profiler::BucketOf(double ns) {
+        if (ns < 4.0) return ns <= 0.0 ? 0u : static_cast<uint32_t>(ns);
+        const uint64_t value = static_cast<uint64_t>(ns);
+        uint32_t exponent = 2;
+        while (exponent < 63 && (value >> (exponent + 1)) != 0) exponent++;
+        const uint32_t bucket = exponent * 4 + static_cast<uint32_t>((value >> (exponent - 2)) & 3);
+        return std::min(bucket, HISTOGRAM_BUCKETS - 1);
+    }
+
+    double Profiler::BucketLowerNs(uint32_t bucket) {
+        if (bucket < 8) return static_cast<double>(bucket < 4 ? bucket : 4);
+        const uint32_t exponent = bucket / 4;
+        return static_cast<double>(static_cast<uint64_t>(4 + bucket % 4) << (exponent - 2));
+    }
+
+    double Profiler::Percentile(const Histogram& histogram, double fraction) {
+        if (histogram.count == 0) return 0.0;
+        const double target = fraction * static_cast<double>(histogram.count);
+        double cumulative = 0.0;
+        for (uint32_t b = 0; b < HISTOGRAM_BUCKETS; b++) {
+            const uint32_t inBucket = histogram.buckets[b];
+            if (inBucket == 0) continue;
+            if (cumulative + inBucket >= target) {
+                // Interpolasi linear di dalam bucket, tidak melebihi max yang benar-benar terukur
+                const double lower = BucketLowerNs(b);
+                const double upper = b + 1 < HISTOGRAM_BUCKETS ? BucketLowerNs(b + 1) : histogram.maxNs;
+                const double t = (target - cumulative) / static_cast<double>(inBucket);
+                return std::min(lower + (upper - lower) * t, histogram.maxNs);
+            }
+            cumulative += inBucket;
+        }
+        return histogram.maxNs;
+    }
+
+    std::vector<ScopeStats> Profiler::GetScopeStats() const {
+        std::lock_guard<std::mutex> lock(_sessionMutex);
+        std::vector<ScopeStats> stats;
+        const double frames = static_cast<double>(std::max(_windowFilled, 1u));
+        for (size_t id = 0; id < _windows.size(); id++) {
+            const Histogram& total = _windows[id].total;
+            if (total.count == 0) continue;
+            ScopeStats scope{};
+            scope.name = GetScopeName(static_cast<ScopeID>(id));
+            scope.count = total.count;
+            scope.callsPerFrame = static_cast<double>(total.count) / frames;
+            scope.meanMs = total.sumNs / static_cast<double>(total.count) * 1e-6;
+            scope.p50Ms = Percentile(total, 0.50) * 1e-6;
+            scope.p95Ms = Percentile(total, 0.95) * 1e-6;
+            scope.p99Ms = Percentile(total, 0.99) * 1e-6;
+            scope.maxMs = total.maxNs * 1e-6;
+            stats.push_back(scope);
+        }
+        std::sort(stats.begin(), stats.end(), [](const ScopeStats& a, const ScopeStats& b) {
+            return a.meanMs * static_cast<double>(a.count) > b.meanMs * static_cast<double>(b.count);
+        });
+        return stats;
+    }
+
+    void Profiler::StopAndWrite() {
+        _recording.store(false);
+        _frameCapture = false;
+        _remainingFrames = 0;
+
+        uint64_t dropped = 0;
+        {
+            std::lock_guard<std::mutex> threadsLock(_threadsMutex);
+            for (const std::unique_ptr<ThreadBuffer>& buffer : _threads) dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        if (dropped > 0) {
+            LOG_WARN("Profiler: " + std::to_string(dropped) + " event di-drop (ring per-thread penuh dalam satu frame)");
+        }
+
+        if (WriteChromeTrace(_sessionPath)) {
+            LOG_INFO("Profiler: " + std::to_string(_captured.size()) + " events, " + std::to_string(_frames.size()) +
+                     " frames written to " + _sessionPath);
+        } else {
+            LOG_ERROR("Profiler: gagal menulis trace " + _sessionPath);
+        }
+        _captured.clear();
+        _captured.shrink_to_fit();
+        _frames.clear();
+    }
+
+    static std::string EscapeJson(const char* text) {
+        std::string out;
+        for (const char* c = text; *c; c++) {
+            const unsigned char ch = static_cast<unsigned char>(*c);
+            if (ch < 0x20) {
+                // [FIX] Control character tidak boleh muncul mentah di string JSON
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", ch);
+                out += escaped;
+                continue;
+            }
+            if (ch == '"' || ch == '\\') out += '\\';
+            out += *c;
+        }
+        return out;
+    }
+
+    bool Profiler::WriteChromeTrace(const std::string& path) const {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) return false;
+
+        // ts/dur Chrome tracing dalam microsecond (pecahan boleh), relatif ke awal session
+        auto micros = [this](uint64_t ticks) { return TicksToNs(ticks) / 1000.0; };
+        auto fixed = [](double value) {
+            char number[64];
+            std::snprintf(number, sizeof(number), "%.3f", value);
+            return std::string(number);
+        };
+
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+        file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"" << EscapeJson(_sessionName.c_str()) << "\"}},\n";
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Frames\"}}";
+        {
+            std::lock_guard<std::mutex> threadsLock(_threadsMutex);
+            for (const std::unique_ptr<ThreadBuffer>& buffer : _threads) {
+                file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadID
+                     << ",\"args\":{\"name\":\"" << EscapeJson(buffer->name.c_str()) << "\"}}";
+                file << ",\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadID
+                     << ",\"args\":{\"sort_index\":" << buffer->threadID << "}}";
+            }
+        }
+
+        for (const FrameMarker& frame : _frames) {
+            if (frame.endTicks == 0) continue;
+            file << ",\n{\"name\":\"Frame " << frame.frameNumber << "\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":0,\"ts\":"
+                 << fixed(micros(frame.beginTicks - _sessionBeginTicks)) << ",\"dur\":" << fixed(micros(frame.endTicks - frame.beginTicks)) << "}";
+        }
+
+        for (const CapturedEvent& captured : _captured) {
+            const TraceEvent& event = captured.event;
+            if (event.beginTicks < _sessionBeginTicks) continue; // Scope mulai sebelum capture
+            file << ",\n{\"name\":\"" << EscapeJson(GetScopeName(event.scope)) << "\",\"cat\":\"" << (captured.gpu ? "gpu" : "cpu") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << captured.threadID
+                 << ",\"ts\":" << fixed(micros(event.beginTicks - _sessionBeginTicks)) << ",\"dur\":" << fixed(micros(event.endTicks - event.beginTicks))
+                 << ",\"args\":{\"depth\":" << event.depth << "}}";
+        }
+        file << "\n]}\n";
+        return static_cast<bool>(file);
+    }
+}
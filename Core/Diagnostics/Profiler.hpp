@@ -1,69 +1,304 @@
 #pragma once
 #include <string>
 #include <chrono>
-#include <unordered_map>
-#include <iostream>
+#include <atomic>
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
 #include <mutex>
+#include <unordered_map>
+#include <type_traits>
+#include <cstdint>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define COGENT_PROFILER_RDTSC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define COGENT_PROFILER_RDTSC 1
+#elif defined(__linux__)
+#include <time.h>
+#endif
 
 namespace Cogent::Diagnostics {
 
-    struct ProfileResult {
-        std::string name;
-        long long duration; // Microseconds
+    // [MODIFIED] CPU profiler always-on: tiap scope direkam sebagai event begin/end (scope ID ter-intern,
+    // thread ID, nesting depth) ke ring per-thread lock-free. Main thread drain ring tiap BeginFrame:
+    // - statistik per scope (count, mean, p50/p95/p99, max) atas sliding window frame -> GetScopeStats()
+    // - saat capture aktif, event juga di-export ke Chrome tracing JSON (chrome://tracing / ui.perfetto.dev)
+    //
+    //     Profiler::Get().BeginFrame(frameNumber);          // sekali per frame di main thread
+    //     { PROFILE_SCOPE("Culling"); ... }                 // name harus string statis (literal / __FUNCTION__)
+    //     Profiler::Get().CaptureFrames(120, "trace.json"); // trace mulai frame berikutnya
+    //
+    // Biaya per scope: 2x rdtsc + satu write ke ring thread sendiri (tanpa lock, tanpa static guard, tanpa
+    // hashing string di runtime: nama di-hash compile-time, di-register saat pertama di-drain).
+    // COGENT_PROFILER=0 mematikan perekaman.
+
+    using ScopeID = uint32_t;
+
+    // [NEW] FNV-1a 32-bit nama scope; di PROFILE_SCOPE dievaluasi compile-time
+    constexpr uint32_t HashScopeName(const char* name) {
+        uint32_t hash = 2166136261u;
+        for (; *name; ++name) hash = (hash ^ static_cast<uint8_t>(*name)) * 16777619u;
+        return hash;
+    }
+
+    struct TraceEvent {
+        uint64_t beginTicks; // Clock profiler (TSC kalau tersedia), konversi lewat TicksToNs
+        uint64_t endTicks;
+        ScopeID scope;
+        uint32_t depth;      // Nesting scope di thread pemanggil (0 = paling luar)
+    };
+
+    struct ScopeStats {
+        const char* name;
+        uint64_t count;        // Jumlah eksekusi scope dalam window
+        double callsPerFrame;
+        double meanMs;
+        double p50Ms;
+        double p95Ms;
+        double p99Ms;
+        double maxMs;
     };
 
     class Profiler {
     public:
+        static constexpr uint32_t MAX_SCOPES = 1024;
+        static constexpr uint32_t DEFAULT_WINDOW_FRAMES = 120;
+
         static Profiler& Get() {
             static Profiler instance;
             return instance;
         }
 
-        void BeginSession(const std::string& name) {
-            // Optional: Open file for chrome tracing format
-        }
+        // Intern nama scope -> ID. Nama sama = ID sama. Scope PROFILE_SCOPE di-register otomatis oleh Drain.
+        ScopeID RegisterScope(const char* name);
+        // [NEW] Nama runtime (mis. nama pass render graph): string disalin dan dimiliki Profiler
+        ScopeID RegisterScope(const std::string& name);
+        const char* GetScopeName(ScopeID id) const;
 
-        void EndSession() {
+        // Capture manual sampai EndSession (JSON ditulis saat EndSession)
+        void BeginSession(const std::string& name, const std::string& path = "cogent_trace.json");
+        void EndSession();
+
+        // Capture frameCount frame mulai dari BeginFrame berikutnya, lalu EndSession otomatis
+        void CaptureFrames(uint32_t frameCount, const std::string& path = "cogent_trace.json");
+        // Batas frame (main thread): drain ring per-thread -> statistik window (+ capture kalau aktif)
+        void BeginFrame(uint64_t frameNumber);
+
+        static bool IsEnabled() { return _enabled.load(std::memory_order_relaxed); }
+        static void SetEnabled(bool enabled) { _enabled.store(enabled, std::memory_order_relaxed); }
+        bool IsRecording() const { return _recording.load(std::memory_order_relaxed); }
+
+        // [NEW] Statistik per scope atas window frame terakhir (diurutkan dari total waktu terbesar)
+        std::vector<ScopeStats> GetScopeStats() const;
+        void SetStatsWindow(uint32_t frames);
+
+        // Nama track thread di trace (mis. "Main", "Worker 3")
+        void SetThreadName(const std::string& name);
+
+        // [NEW] Track non-thread (mis. queue GPU): event ditulis oleh satu thread saja, timestamp sudah
+        // dikonversi ke clock profiler (Ticks). Muncul sebagai track terpisah di trace, kategori "gpu".
+        uint32_t CreateTrack(const std::string& name);
+        void WriteTrackEvent(uint32_t track, ScopeID scope, uint64_t beginTicks, uint64_t endTicks, uint32_t depth);
+
+        // Hot path: dipanggil dari thread mana saja tanpa lock
+        void WriteEvent(ScopeID scope, uint64_t beginTicks, uint64_t endTicks, uint32_t depth) {
+            ThreadBuffer* buffer = LocalBuffer();
+            if (!buffer) buffer = RegisterThread();
+            Push(*buffer, nullptr, scope, beginTicks, endTicks, depth);
         }
 
-        void WriteProfile(const ProfileResult& result) {
-            std::lock_guard<std::mutex> lock(_mutex);
-            // Just print to console for now, or store for UI
-            // std::cout << "Profile [" << result.name << "]: " << result.duration << "us" << std::endl;
-            _results[result.name] = result.duration;
+        // Timestamp mentah: rdtsc (x86, TSC invariant) / CLOCK_MONOTONIC_RAW (Linux) / steady_clock
+        static uint64_t Ticks() {
+#if defined(COGENT_PROFILER_RDTSC)
+            return __rdtsc();
+#elif defined(__linux__)
+            timespec ts;
+            clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+            return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+#else
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
         }
 
-        const std::unordered_map<std::string, long long>& GetResults() { return _results; }
+        double TicksToNs(uint64_t ticks) const { return static_cast<double>(ticks) * _nsPerTick; }
+        double NsToTicks(double ns) const { return ns / _nsPerTick; }
 
     private:
-         std::unordered_map<std::string, long long> _results;
-         std::mutex _mutex;
+        friend class InstrumentationTimer;
+
+        // Event di ring. Scope PROFILE_SCOPE belum punya ScopeID: dibawa nama + hash compile-time,
+        // di-resolve (dan di-register saat pertama terlihat) oleh Drain di main thread.
+        struct RingEvent {
+            uint64_t beginTicks;
+            uint64_t endTicks;
+            const char* name; // nullptr = key sudah ScopeID (RegisterScope / track GPU)
+            uint32_t key;     // HashScopeName(name) atau ScopeID
+            uint32_t depth;
+        };
+
+        // Ring SPSC: thread pemilik push (producer), main thread drain (consumer).
+        // head/tail di cache line terpisah supaya producer dan consumer tidak saling invalidasi.
+        struct ThreadBuffer {
+            static constexpr uint32_t CAPACITY = 1u << 15;
+
+            std::vector<RingEvent> events = std::vector<RingEvent>(CAPACITY);
+            alignas(64) std::atomic<uint64_t> head{0};
+            uint64_t cachedTail = 0; // Salinan tail milik producer, reload hanya saat terlihat penuh
+            uint32_t depth = 0;      // Nesting InstrumentationTimer, hanya disentuh thread pemilik
+            alignas(64) std::atomic<uint64_t> tail{0};
+            std::atomic<uint64_t> dropped{0};
+            uint32_t threadID = 0;
+            bool gpu = false; // Track dari CreateTrack (timeline GPU)
+            std::string name;
+        };
+
+        struct CapturedEvent {
+            TraceEvent event;
+            uint32_t threadID;
+            bool gpu;
+        };
+
+        struct FrameMarker {
+            uint64_t frameNumber;
+            uint64_t beginTicks;
+            uint64_t endTicks;
+        };
+
+        // Durasi per eksekusi scope dalam bucket log2 (4 sub-bucket per oktaf, ~19% lebar bucket)
+        static constexpr uint32_t HISTOGRAM_BUCKETS = 128;
+        struct Histogram {
+            std::array<uint32_t, HISTOGRAM_BUCKETS> buckets{};
+            uint64_t count = 0;
+            double sumNs = 0.0;
+            double maxNs = 0.0;
+        };
+
+        // Satu histogram per frame di ring window + total window (total -= frame yang keluar window)
+        struct ScopeWindow {
+            std::vector<Histogram> frames;
+            Histogram total;
+        };
+
+        Profiler();
+
+        static ThreadBuffer*& LocalBuffer() {
+            thread_local ThreadBuffer* buffer = nullptr;
+            return buffer;
+        }
+
+        static void Push(ThreadBuffer& buffer, const char* name, uint32_t key, uint64_t beginTicks, uint64_t endTicks, uint32_t depth) {
+            const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+            if (head - buffer.cachedTail >= ThreadBuffer::CAPACITY) {
+                buffer.cachedTail = buffer.tail.load(std::memory_order_acquire);
+                if (head - buffer.cachedTail >= ThreadBuffer::CAPACITY) {
+                    // Ring penuh (drain hanya tiap frame): drop daripada block thread pemanggil
+                    buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            buffer.events[head & (ThreadBuffer::CAPACITY - 1)] = { beginTicks, endTicks, name, key, depth };
+            buffer.head.store(head + 1, std::memory_order_release);
+        }
+
+        static uint32_t BucketOf(double ns);
+        static double BucketLowerNs(uint32_t bucket);
+        static double Percentile(const Histogram& histogram, double fraction);
+
+        ThreadBuffer* RegisterThread();
+        // Caller pegang _scopeMutex: cari + tambah dalam satu critical section (tidak ada entry ganda)
+        ScopeID FindScopeLocked(const char* name) const;
+        ScopeID InsertScopeLocked(const char* name);
+        ScopeID ResolveScope(const RingEvent& event); // Main thread (Drain)
+        void StartRecording(const std::string& name, const std::string& path);
+        void Drain(); // Ring -> statistik (+ _captured saat recording). Caller pegang _sessionMutex.
+        void AdvanceStatsFrame();
+        void StopAndWrite();
+        bool WriteChromeTrace(const std::string& path) const;
+
+        static inline std::atomic<bool> _enabled{true}; // Static: hot path tidak lewat Get()
+        std::atomic<bool> _recording{false};
+        double _nsPerTick = 1.0;
+
+        // Nama scope: array tetap (pointer tidak pernah pindah), dibaca main thread tanpa lock
+        std::array<std::atomic<const char*>, MAX_SCOPES> _scopeNames{};
+        std::atomic<uint32_t> _scopeCount{0};
+        std::mutex _scopeMutex;
+        std::deque<std::string> _ownedScopeNames; // Storage RegisterScope(std::string), alamat stabil
+
+        // Hash nama PROFILE_SCOPE -> ScopeID (hanya Drain). Nama disimpan untuk cek collision hash.
+        struct LiteralScope {
+            ScopeID id;
+            const char* name;
+        };
+        std::unordered_map<uint32_t, LiteralScope> _literalScopes;
+
+        mutable std::mutex _threadsMutex; // Registrasi thread (sekali per thread) + nama
+        std::vector<std::unique_ptr<ThreadBuffer>> _threads;
+
+        mutable std::mutex _sessionMutex;
+        std::string _sessionName;
+        std::string _sessionPath;
+        uint64_t _sessionBeginTicks = 0;
+        std::vector<CapturedEvent> _captured;
+        std::vector<FrameMarker> _frames;
+        uint32_t _pendingFrames = 0;   // CaptureFrames menunggu BeginFrame berikutnya
+        uint32_t _remainingFrames = 0; // 0 = session manual (tanpa batas frame)
+        bool _frameCapture = false;
+
+        std::vector<ScopeWindow> _windows; // Index = ScopeID
+        uint32_t _windowFrames = DEFAULT_WINDOW_FRAMES; // Frame selesai yang dihitung statistik
+        uint32_t _windowSlot = 0;          // Slot frame yang sedang diisi (ring _windowFrames + 1)
+        uint32_t _windowFilled = 0;        // Frame selesai di window (< _windowFrames saat startup)
     };
 
     class InstrumentationTimer {
     public:
-        InstrumentationTimer(const char* name) : _name(name), _startTimepoint(std::chrono::high_resolution_clock::now()) {}
+        // [MODIFIED] Scope literal: hash compile-time, ScopeID di-resolve saat Drain
+        InstrumentationTimer(const char* name, uint32_t nameHash) : _name(name), _key(nameHash) { Begin(); }
+        // Scope yang sudah di-register (nama runtime)
+        explicit InstrumentationTimer(ScopeID scope) : _key(scope) { Begin(); }
 
         ~InstrumentationTimer() {
-            if (!_stopped) Stop();
+            if (!_buffer) return;
+            const uint64_t endTicks = Profiler::Ticks();
+            --_buffer->depth;
+            Profiler::Push(*_buffer, _name, _key, _beginTicks, endTicks, _depth);
         }
 
-        void Stop() {
-            auto endTimepoint = std::chrono::high_resolution_clock::now();
-            auto start = std::chrono::time_point_cast<std::chrono::microseconds>(_startTimepoint).time_since_epoch().count();
-            auto end = std::chrono::time_point_cast<std::chrono::microseconds>(endTimepoint).time_since_epoch().count();
+        InstrumentationTimer(const InstrumentationTimer&) = delete;
+        InstrumentationTimer& operator=(const InstrumentationTimer&) = delete;
 
-            auto duration = end - start;
-            Profiler::Get().WriteProfile({ _name, duration });
-            _stopped = true;
+    private:
+        void Begin() {
+            if (!Profiler::IsEnabled()) return;
+            // Buffer thread di-cache di timer: destructor tidak perlu lookup thread_local / Get() lagi
+            Profiler::ThreadBuffer* buffer = Profiler::LocalBuffer();
+            if (!buffer) {
+                buffer = Profiler::Get().RegisterThread(); // Sekali per thread (juga membaca COGENT_PROFILER)
+                if (!Profiler::IsEnabled()) return;
+            }
+            _buffer = buffer;
+            _depth = buffer->depth++;
+            _beginTicks = Profiler::Ticks();
         }
 
-    private:
-        const char* _name;
-        std::chrono::time_point<std::chrono::high_resolution_clock> _startTimepoint;
-        bool _stopped = false;
+        Profiler::ThreadBuffer* _buffer = nullptr;
+        uint64_t _beginTicks = 0;
+        const char* _name = nullptr;
+        uint32_t _key;
+        uint32_t _depth = 0;
     };
 }
 
-#define PROFILE_SCOPE(name) Cogent::Diagnostics::InstrumentationTimer timer##__LINE__(name)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// [MODIFIED] Tanpa static lokal: hash nama dihitung compile-time, registrasi lazy di Drain
+#define PROFILE_SCOPE(name) \
+    ::Cogent::Diagnostics::InstrumentationTimer PROFILE_CONCAT(profileTimer, __LINE__)( \
+        name, std::integral_constant<uint32_t, ::Cogent::Diagnostics::HashScopeName(name)>::value)
 #define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
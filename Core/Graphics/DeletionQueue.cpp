@@ -0,0 +1,62 @@
+#include "DeletionQueue.hpp"
+#include <vector>
+
+void DeletionQueue::setCurrentFrame(uint64_t frame) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (frame > currentFrame) currentFrame = frame;
+}
+
+uint64_t DeletionQueue::getCurrentFrame() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return currentFrame;
+}
+
+void DeletionQueue::push(Deleter deleter) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.push_back({ currentFrame, std::move(deleter) });
+}
+
+void DeletionQueue::destroyBuffer(VkBuffer buffer, VkDeviceMemory memory) {
+    if (buffer == VK_NULL_HANDLE && memory == VK_NULL_HANDLE) return;
+    push([buffer, memory](VkDevice dev) {
+        if (buffer != VK_NULL_HANDLE) vkDestroyBuffer(dev, buffer, nullptr);
+        if (memory != VK_NULL_HANDLE) vkFreeMemory(dev, memory, nullptr);
+    });
+}
+
+void DeletionQueue::destroyImage(VkImage image, VkImageView view, VkSampler sampler, VkDeviceMemory memory) {
+    if (image == VK_NULL_HANDLE && view == VK_NULL_HANDLE && sampler == VK_NULL_HANDLE && memory == VK_NULL_HANDLE) return;
+    push([image, view, sampler, memory](VkDevice dev) {
+        if (sampler != VK_NULL_HANDLE) vkDestroySampler(dev, sampler, nullptr);
+        if (view != VK_NULL_HANDLE) vkDestroyImageView(dev, view, nullptr);
+        if (image != VK_NULL_HANDLE) vkDestroyImage(dev, image, nullptr);
+        if (memory != VK_NULL_HANDLE) vkFreeMemory(dev, memory, nullptr);
+    });
+}
+
+void DeletionQueue::retire(uint64_t completedFrame) {
+    // Deleter dijalankan di luar lock supaya push dari thread lain tidak ikut menunggu
+    std::vector<Deleter> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!entries.empty() && entries.front().frame <= completedFrame) {
+            ready.push_back(std::move(entries.front().deleter));
+            entries.pop_front();
+        }
+    }
+    for (Deleter& deleter : ready) deleter(device);
+}
+
+void DeletionQueue::flush() {
+    std::deque<Entry> all;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        all.swap(entries);
+    }
+    for (Entry& entry : all) entry.deleter(device);
+}
+
+size_t DeletionQueue::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
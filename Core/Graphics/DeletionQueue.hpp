@@ -0,0 +1,43 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <cstdint>
+
+// [NEW] Deferred destruction. Handle yang mungkin masih dibaca GPU tidak langsung di-destroy, tapi
+// ditandai dengan nomor frame yang sedang direkam dan baru dilepas setelah frame itu retire
+// (fence-nya sudah di-wait). Resize buffer / evict texture jadi tanpa stall dan tanpa use-after-free.
+class DeletionQueue {
+public:
+    using Deleter = std::function<void(VkDevice device)>;
+
+    void init(VkDevice vkDevice) { device = vkDevice; }
+
+    // Frame yang sedang direkam CPU. Entry baru di-tag dengan nilai ini (naik monoton).
+    void setCurrentFrame(uint64_t frame);
+    uint64_t getCurrentFrame() const;
+
+    void push(Deleter deleter);
+    // Helper untuk handle yang umum. VK_NULL_HANDLE di-skip.
+    void destroyBuffer(VkBuffer buffer, VkDeviceMemory memory);
+    void destroyImage(VkImage image, VkImageView view, VkSampler sampler, VkDeviceMemory memory);
+
+    // Lepas semua entry dengan tag <= completedFrame (GPU sudah selesai dengan frame itu)
+    void retire(uint64_t completedFrame);
+    // Lepas semuanya. Hanya setelah vkDeviceWaitIdle (resize swapchain, shutdown).
+    void flush();
+
+    size_t pending() const;
+
+private:
+    struct Entry {
+        uint64_t frame;
+        Deleter deleter;
+    };
+
+    VkDevice device = VK_NULL_HANDLE;
+    mutable std::mutex mutex; // push bisa dari worker (streaming)
+    std::deque<Entry> entries; // Urut tag (currentFrame monoton), retire cukup pop dari depan
+    uint64_t currentFrame = 0;
+};
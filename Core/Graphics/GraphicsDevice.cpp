@@ -2,6 +2,7 @@
 #include <set>
 #include <string>
 #include <algorithm>
+#include <cstdlib>
 #include "../Logger.hpp"
 
 #define GLFW_INCLUDE_VULKAN
@@ -26,11 +27,16 @@ QueueFamilyIndices GraphicsDevice::findQueueFamilies(VkPhysicalDevice device, Vk
             indices.computeFamily = i;
         }
 
-        VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
+        if (surface == VK_NULL_HANDLE) {
+            // [NEW] Headless: tidak ada present, queue graphics juga mengisi slot present
+            if (indices.graphicsFamily.has_value()) indices.presentFamily = indices.graphicsFamily;
+        } else {
+            VkBool32 presentSupport = false;
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface, &presentSupport);
 
-        if (presentSupport) {
-            indices.presentFamily = i;
+            if (presentSupport) {
+                indices.presentFamily = i;
+            }
         }
 
         if (indices.isComplete()) break;
@@ -63,7 +69,8 @@ bool GraphicsDevice::isDeviceSuitable(VkPhysicalDevice device, VkSurfaceKHR surf
     std::vector<VkExtensionProperties> availableExtensions(extensionCount);
     vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
-    std::set<std::string> requiredExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+    std::set<std::string> requiredExtensions;
+    if (surface != VK_NULL_HANDLE) requiredExtensions.insert(VK_KHR_SWAPCHAIN_EXTENSION_NAME); // [MODIFIED] Headless tanpa swapchain
 
     for (const auto& extension : availableExtensions) {
         requiredExtensions.erase(extension.extensionName);
@@ -90,9 +97,18 @@ void GraphicsDevice::init(VkSurfaceKHR surface) {
     pickPhysicalDevice(surface);
     createLogicalDevice(surface);
     createCommandPool();
+    deletionQueue.init(device);
+
+    // [NEW] Pipeline cache persist ke disk. COGENT_PIPELINE_CACHE=<path> untuk ganti lokasi,
+    // COGENT_NO_PIPELINE_CACHE=1 untuk paksa cold start (cache hanya di memory, tidak di-load/save).
+    std::string cachePath = "pipeline_cache.bin";
+    if (const char* value = std::getenv("COGENT_PIPELINE_CACHE")) cachePath = value;
+    if (std::getenv("COGENT_NO_PIPELINE_CACHE") != nullptr) cachePath.clear();
+    pipelineCache.init(device, physicalDevice, cachePath);
 }
 
-GraphicsDevice::GraphicsDevice(bool enableValidation) : enableValidationLayers(enableValidation) {
+GraphicsDevice::GraphicsDevice(bool enableValidation, bool headlessMode)
+    : enableValidationLayers(enableValidation), headless(headlessMode) {
     createInstance();
 }
 
@@ -109,8 +125,9 @@ void GraphicsDevice::createInstance() {
     appInfo.engineVersion = VK_MAKE_VERSION(1, 0, 0);
     appInfo.apiVersion = VK_API_VERSION_1_3;
 
+    // [MODIFIED] Headless: GLFW tidak di-init, instance tidak butuh extension surface
     uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+    const char** glfwExtensions = headless ? nullptr : glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
 
     VkInstanceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -192,16 +209,62 @@ void GraphicsDevice::createLogicalDevice(VkSurfaceKHR surface) {
         queueCreateInfos.push_back(queueCreateInfo);
     }
 
+    // [NEW] Query fitur untuk GPU-driven rendering (multiDrawIndirect + drawIndirectCount)
+    VkPhysicalDeviceVulkan12Features supported12{};
+    supported12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    VkPhysicalDeviceFeatures2 supportedFeatures{};
+    supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+    supportedFeatures.pNext = &supported12;
+    vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures);
+
     VkPhysicalDeviceFeatures deviceFeatures{};
     deviceFeatures.samplerAnisotropy = VK_TRUE; 
+    deviceFeatures.multiDrawIndirect = supportedFeatures.features.multiDrawIndirect;
+
+    VkPhysicalDeviceVulkan12Features features12{};
+    features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    features12.drawIndirectCount = supported12.drawIndirectCount;
+
+    drawIndirectCountSupported = supported12.drawIndirectCount && supportedFeatures.features.multiDrawIndirect;
+    LOG_INFO(std::string("RHI: drawIndirectCount ") + (drawIndirectCountSupported ? "supported" : "NOT supported (CPU culling fallback)"));
+
+    // [NEW] Descriptor indexing untuk BindlessHeap (texture material): array runtime, slot boleh kosong,
+    // update selagi set dipakai, dan index non-uniform per draw di shader
+    features12.descriptorIndexing = supported12.descriptorIndexing;
+    features12.runtimeDescriptorArray = supported12.runtimeDescriptorArray;
+    features12.descriptorBindingPartiallyBound = supported12.descriptorBindingPartiallyBound;
+    features12.descriptorBindingSampledImageUpdateAfterBind = supported12.descriptorBindingSampledImageUpdateAfterBind;
+    features12.shaderSampledImageArrayNonUniformIndexing = supported12.shaderSampledImageArrayNonUniformIndexing;
+
+    bindlessSupported = supported12.runtimeDescriptorArray && supported12.descriptorBindingPartiallyBound &&
+                        supported12.descriptorBindingSampledImageUpdateAfterBind &&
+                        supported12.shaderSampledImageArrayNonUniformIndexing;
+    LOG_INFO(std::string("RHI: descriptor indexing (bindless) ") + (bindlessSupported ? "supported" : "NOT supported"));
+
+    // [NEW] Reset query dari host: GpuProfiler bisa membaca hasil kapan saja tanpa melihat nilai stale
+    features12.hostQueryReset = supported12.hostQueryReset;
+    hostQueryResetSupported = supported12.hostQueryReset;
 
     VkDeviceCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    createInfo.pNext = &features12;
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
     createInfo.pEnabledFeatures = &deviceFeatures;
 
-    const std::vector<const char*> deviceExtensions = { VK_KHR_SWAPCHAIN_EXTENSION_NAME };
+    std::vector<const char*> deviceExtensions;
+    if (surface != VK_NULL_HANDLE) deviceExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME); // [MODIFIED] Headless tanpa swapchain
+
+    // [NEW] Opsional: sampling clock GPU + CPU bersamaan, supaya timeline GPU bisa disejajarkan dengan trace CPU
+    uint32_t extensionCount = 0;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+    calibratedTimestampsSupported = std::any_of(availableExtensions.begin(), availableExtensions.end(), [](const VkExtensionProperties& extension) {
+        return std::string(extension.extensionName) == VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME;
+    });
+    if (calibratedTimestampsSupported) deviceExtensions.push_back(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+    LOG_INFO(std::string("RHI: calibrated timestamps ") + (calibratedTimestampsSupported ? "supported" : "NOT supported (GPU trace di-align sekali saat init)"));
     createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
     createInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
@@ -240,6 +303,7 @@ void GraphicsDevice::createCommandPool() {
     poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
     poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
     poolInfo.queueFamilyIndex = graphicsFamilyIndex;
+    graphicsQueueFamily = static_cast<uint32_t>(graphicsFamilyIndex);
 
     if (vkCreateCommandPool(device, &poolInfo, nullptr, &commandPool) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create Command Pool!");
@@ -266,3 +330,63 @@ uint32_t GraphicsDevice::findMemoryType(uint32_t typeFilter, VkMemoryPropertyFla
 
     throw std::runtime_error("Failed to find suitable memory type!");
 }
+
+VkCommandBuffer GraphicsDevice::beginSingleTimeCommands() {
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandPool = commandPool;
+    allocInfo.commandBufferCount = 1;
+
+    VkCommandBuffer commandBuffer;
+    if (vkAllocateCommandBuffers(device, &allocInfo, &commandBuffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate single-time Command Buffer!");
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(commandBuffer, &beginInfo);
+
+    return commandBuffer;
+}
+
+void GraphicsDevice::endSingleTimeCommands(VkCommandBuffer commandBuffer) {
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submitInfo{};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = &commandBuffer;
+
+    vkQueueSubmit(graphicsQueue, 1, &submitInfo, VK_NULL_HANDLE);
+    vkQueueWaitIdle(graphicsQueue);
+
+    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+}
+
+void GraphicsDevice::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
+    VkBufferCreateInfo bufferInfo{};
+    bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufferInfo.size = size;
+    bufferInfo.usage = usage;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(device, &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create Buffer!");
+    }
+
+    VkMemoryRequirements memRequirements;
+    vkGetBufferMemoryRequirements(device, buffer, &memRequirements);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memRequirements.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memRequirements.memoryTypeBits, properties);
+
+    if (vkAllocateMemory(device, &allocInfo, nullptr, &bufferMemory) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate Buffer Memory!");
+    }
+
+    vkBindBufferMemory(device, buffer, bufferMemory, 0);
+}
@@ -4,6 +4,8 @@
 #include <optional>
 #include <stdexcept>
 #include <iostream>
+#include "DeletionQueue.hpp"
+#include "PipelineCache.hpp"
 
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
@@ -17,10 +19,11 @@ struct QueueFamilyIndices {
 
 class GraphicsDevice {
 public:
-    GraphicsDevice(bool enableValidationLayers = true);
+    // [MODIFIED] headless = tanpa GLFW/surface/swapchain (render offscreen, bisa jalan di ICD software)
+    GraphicsDevice(bool enableValidationLayers = true, bool headless = false);
     ~GraphicsDevice();
 
-    void init(VkSurfaceKHR surface); // Requires surface to pick suitable GPU
+    void init(VkSurfaceKHR surface); // Requires surface to pick suitable GPU (VK_NULL_HANDLE kalau headless)
     void cleanup();
 
     VkInstance getInstance() const { return instance; }
@@ -29,11 +32,21 @@ public:
     VkQueue getGraphicsQueue() const { return graphicsQueue; }
     VkQueue getPresentQueue() const { return presentQueue; }
     VkCommandPool getCommandPool() const { return commandPool; }
+    uint32_t getGraphicsQueueFamily() const { return graphicsQueueFamily; } // [NEW] Untuk command pool tambahan
+    bool supportsDrawIndirectCount() const { return drawIndirectCountSupported; } // [NEW] GPU-driven culling
+    bool supportsBindless() const { return bindlessSupported; } // [NEW] Descriptor indexing (BindlessHeap)
+    bool supportsCalibratedTimestamps() const { return calibratedTimestampsSupported; } // [NEW] VK_EXT_calibrated_timestamps (GpuProfiler)
+    bool supportsHostQueryReset() const { return hostQueryResetSupported; } // [NEW] vkResetQueryPool dari CPU (GpuProfiler)
+    DeletionQueue& getDeletionQueue() { return deletionQueue; } // [NEW] Destroy handle setelah frame retire
+    VkPipelineCache getPipelineCache() const { return pipelineCache.get(); } // [NEW] Dipakai semua vkCreate*Pipelines
+    PipelineCache& getPipelineCacheStore() { return pipelineCache; }          // [NEW] save / shutdown / isWarm
+    bool isHeadless() const { return headless; } // [NEW]
 
     // Helper functions
     uint32_t findMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
     VkCommandBuffer beginSingleTimeCommands();
     void endSingleTimeCommands(VkCommandBuffer commandBuffer);
+    void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
     
     // Static helpers for device selection
     static QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface);
@@ -51,6 +64,14 @@ private:
     VkQueue graphicsQueue;
     VkQueue presentQueue;
     VkCommandPool commandPool;
+    uint32_t graphicsQueueFamily = 0;
+    DeletionQueue deletionQueue;
+    PipelineCache pipelineCache;
 
     bool enableValidationLayers;
+    bool headless = false;
+    bool drawIndirectCountSupported = false;
+    bool bindlessSupported = false;
+    bool calibratedTimestampsSupported = false;
+    bool hostQueryResetSupported = false;
 };
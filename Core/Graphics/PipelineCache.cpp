@@ -0,0 +1,111 @@
+#include "PipelineCache.hpp"
+#include "../Logger.hpp"
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+void PipelineCache::init(VkDevice vkDevice, VkPhysicalDevice physicalDevice, const std::string& cachePath) {
+    device = vkDevice;
+    path = cachePath;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+
+    std::vector<uint8_t> data;
+    if (!path.empty()) {
+        std::ifstream file(path, std::ios::ate | std::ios::binary);
+        if (file.is_open()) {
+            data.resize(static_cast<size_t>(file.tellg()));
+            file.seekg(0);
+            file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!file || !validateHeader(data)) data.clear();
+        }
+    }
+
+    VkPipelineCacheCreateInfo createInfo{};
+    createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    createInfo.initialDataSize = data.size();
+    createInfo.pInitialData = data.empty() ? nullptr : data.data();
+
+    if (vkCreatePipelineCache(device, &createInfo, nullptr, &cache) != VK_SUCCESS) {
+        // Driver menolak data lama: jangan gagal startup, mulai dari cache kosong
+        LOG_WARN("PipelineCache: data ditolak driver, mulai kosong");
+        createInfo.initialDataSize = 0;
+        createInfo.pInitialData = nullptr;
+        data.clear();
+        if (vkCreatePipelineCache(device, &createInfo, nullptr, &cache) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Pipeline Cache!");
+        }
+    }
+
+    warm = !data.empty();
+    LOG_INFO("PipelineCache: " + (warm ? "loaded " + std::to_string(data.size()) + " bytes from " + path
+                                       : std::string("cold (no valid cache file)")));
+}
+
+bool PipelineCache::validateHeader(const std::vector<uint8_t>& data) const {
+    // Layout VkPipelineCacheHeaderVersionOne (spec): 4 x uint32 + UUID, semua little-endian
+    constexpr size_t HEADER_SIZE = 16 + VK_UUID_SIZE;
+    if (data.size() < HEADER_SIZE) {
+        LOG_WARN("PipelineCache: file terlalu kecil, diabaikan");
+        return false;
+    }
+
+    uint32_t headerSize, headerVersion, vendorID, deviceID;
+    std::memcpy(&headerSize, data.data() + 0, sizeof(uint32_t));
+    std::memcpy(&headerVersion, data.data() + 4, sizeof(uint32_t));
+    std::memcpy(&vendorID, data.data() + 8, sizeof(uint32_t));
+    std::memcpy(&deviceID, data.data() + 12, sizeof(uint32_t));
+
+    if (headerSize < HEADER_SIZE || headerSize > data.size() || headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) {
+        LOG_WARN("PipelineCache: header tidak valid, diabaikan");
+        return false;
+    }
+    if (vendorID != properties.vendorID || deviceID != properties.deviceID) {
+        LOG_WARN("PipelineCache: dibuat untuk GPU lain, diabaikan");
+        return false;
+    }
+    if (std::memcmp(data.data() + 16, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0) {
+        LOG_WARN("PipelineCache: UUID driver berbeda (driver di-update?), diabaikan");
+        return false;
+    }
+    return true;
+}
+
+void PipelineCache::save() {
+    if (cache == VK_NULL_HANDLE || path.empty()) return;
+
+    size_t size = 0;
+    if (vkGetPipelineCacheData(device, cache, &size, nullptr) != VK_SUCCESS || size == 0) return;
+    std::vector<uint8_t> data(size);
+    if (vkGetPipelineCacheData(device, cache, &size, data.data()) != VK_SUCCESS) {
+        LOG_WARN("PipelineCache: gagal membaca data cache");
+        return;
+    }
+
+    const std::string tempPath = path + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            LOG_WARN("PipelineCache: tidak bisa menulis " + tempPath);
+            return;
+        }
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(size));
+        if (!file) {
+            LOG_WARN("PipelineCache: gagal menulis " + tempPath);
+            return;
+        }
+    }
+    std::remove(path.c_str()); // rename tidak menimpa file yang ada di Windows
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        LOG_WARN("PipelineCache: gagal rename ke " + path);
+        return;
+    }
+    LOG_INFO("PipelineCache: saved " + std::to_string(size) + " bytes to " + path);
+}
+
+void PipelineCache::shutdown() {
+    if (cache == VK_NULL_HANDLE) return;
+    save();
+    vkDestroyPipelineCache(device, cache, nullptr);
+    cache = VK_NULL_HANDLE;
+}
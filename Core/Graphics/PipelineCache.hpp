@@ -0,0 +1,31 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// [NEW] VkPipelineCache level device yang disimpan ke disk. Startup berikutnya driver tidak perlu
+// compile ulang shader yang sama (warm start). Data dari disk hanya dipakai kalau header cocok
+// dengan GPU + driver sekarang (vendorID, deviceID, pipelineCacheUUID); selain itu mulai kosong.
+// vkCreate*Pipelines boleh dipanggil paralel dengan cache yang sama (internally synchronized).
+class PipelineCache {
+public:
+    void init(VkDevice device, VkPhysicalDevice physicalDevice, const std::string& path);
+    // Tulis isi cache ke disk (file sementara lalu rename, supaya crash tidak meninggalkan file rusak)
+    void save();
+    // save() lalu destroy handle
+    void shutdown();
+
+    VkPipelineCache get() const { return cache; }
+    bool isWarm() const { return warm; } // true = data dari disk valid dan dipakai
+    const std::string& getPath() const { return path; }
+
+private:
+    bool validateHeader(const std::vector<uint8_t>& data) const;
+
+    VkDevice device = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties properties{};
+    VkPipelineCache cache = VK_NULL_HANDLE;
+    std::string path; // Kosong = persist dimatikan
+    bool warm = false;
+};
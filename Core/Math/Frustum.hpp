@@ -1,5 +1,6 @@
 #pragma once
 #include <array>
+#include <cstdint>
 #include <glm/glm.hpp>
 
 namespace Cogent::Math {
@@ -28,9 +29,25 @@ namespace Cogent::Math {
         glm::vec3 getExtent() const { return (max - min) * 0.5f; }
     };
 
+    // [NEW] Local AABB -> World AABB (Arvo): center ditransform, extent dikali |M3x3|
+    inline AABB transformAABB(const AABB& local, const glm::mat4& m) {
+        glm::vec3 center = glm::vec3(m * glm::vec4(local.getCenter(), 1.0f));
+        glm::vec3 extent = local.getExtent();
+
+        glm::vec3 worldExtent =
+            glm::abs(glm::vec3(m[0])) * extent.x +
+            glm::abs(glm::vec3(m[1])) * extent.y +
+            glm::abs(glm::vec3(m[2])) * extent.z;
+
+        return { center - worldExtent, center + worldExtent };
+    }
+
+    enum class Intersection { Outside = 0, Intersect, Inside };
+
     class Frustum {
     public:
         enum Side { LEFT = 0, RIGHT, TOP, BOTTOM, BACK, FRONT };
+        static constexpr uint32_t ALL_PLANES = 0x3F;
         std::array<Plane, 6> planes;
 
         void update(const glm::mat4& viewProj) {
@@ -86,5 +103,45 @@ namespace Cogent::Math {
             }
             return true;
         }
+
+        // [NEW] Test untuk hierarchy dengan temporal coherence:
+        // - planeMask: bit i = plane i masih perlu dites (parent belum sepenuhnya di dalam plane itu)
+        // - outMask: plane yang masih memotong box, diwariskan ke anak (0 = sepenuhnya di dalam)
+        // - lastPlane: plane yang terakhir menolak box ini, dites duluan dan di-update saat reject
+        Intersection classifyAABB(const AABB& box, uint32_t planeMask, uint32_t& outMask, uint8_t& lastPlane, uint32_t* planeTests = nullptr) const {
+            const glm::vec3 center = box.getCenter();
+            const glm::vec3 extent = box.getExtent();
+            outMask = planeMask;
+            uint32_t tests = 0;
+
+            auto testPlane = [&](uint32_t index) {
+                const Plane& plane = planes[index];
+                const float dist = plane.getSignedDistance(center);
+                const float radius = glm::dot(glm::abs(plane.normal), extent);
+                tests++;
+                if (dist + radius < 0.0f) return false;
+                if (dist - radius >= 0.0f) outMask &= ~(1u << index);
+                return true;
+            };
+
+            Intersection result = Intersection::Intersect;
+            const uint32_t cached = lastPlane < 6 ? lastPlane : 0;
+            if ((planeMask & (1u << cached)) && !testPlane(cached)) {
+                result = Intersection::Outside;
+            } else {
+                for (uint32_t i = 0; i < 6; ++i) {
+                    if (i == cached || !(planeMask & (1u << i))) continue;
+                    if (!testPlane(i)) {
+                        lastPlane = static_cast<uint8_t>(i);
+                        result = Intersection::Outside;
+                        break;
+                    }
+                }
+            }
+
+            if (planeTests) *planeTests += tests;
+            if (result == Intersection::Outside) return result;
+            return outMask == 0 ? Intersection::Inside : Intersection::Intersect;
+        }
     };
 }
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstdint>
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+// [NEW] Deteksi SIMD compile-time. SSE2 = baseline di x86-64 (GCC/Clang/MSVC),
+// selain itu jatuh ke jalur scalar.
+#if !defined(COGENT_FORCE_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define COGENT_SIMD_SSE2 1
+    #include <emmintrin.h>
+#else
+    #define COGENT_SIMD_SSE2 0
+#endif
+
+// AVX2 / AVX-512 dikompilasi per fungsi (tanpa flag global), dipilih saat runtime
+#if COGENT_SIMD_SSE2
+    #include <immintrin.h>
+    #if defined(_MSC_VER) && !defined(__clang__)
+        #define COGENT_TARGET_AVX2
+        #define COGENT_TARGET_AVX512
+    #else
+        #define COGENT_TARGET_AVX2 __attribute__((target("avx2")))
+        #define COGENT_TARGET_AVX512 __attribute__((target("avx512f")))
+    #endif
+#endif
+
+namespace Cogent::Math::Simd {
+
+    enum class Level { Scalar = 0, SSE2, AVX2, AVX512 };
+
+    inline const char* levelName(Level level) {
+        switch (level) {
+            case Level::SSE2:   return "SSE2";
+            case Level::AVX2:   return "AVX2";
+            case Level::AVX512: return "AVX-512";
+            default:            return "Scalar";
+        }
+    }
+
+    // Level tertinggi yang didukung CPU + OS (cek XSAVE state lewat xgetbv)
+    inline Level detectLevel() {
+#if COGENT_SIMD_SSE2
+    #if defined(_MSC_VER) && !defined(__clang__)
+        int info[4];
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        if (!osxsave || !avx) return Level::SSE2;
+
+        const unsigned long long xcr0 = _xgetbv(0);
+        if ((xcr0 & 0x6) != 0x6) return Level::SSE2;
+
+        __cpuidex(info, 7, 0);
+        const bool avx2 = (info[1] & (1 << 5)) != 0;
+        const bool avx512f = (info[1] & (1 << 16)) != 0;
+        if (avx512f && (xcr0 & 0xE6) == 0xE6) return Level::AVX512;
+        return avx2 ? Level::AVX2 : Level::SSE2;
+    #else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return Level::AVX512;
+        if (__builtin_cpu_supports("avx2")) return Level::AVX2;
+        return Level::SSE2;
+    #endif
+#else
+        return Level::Scalar;
+#endif
+    }
+
+    inline uint32_t countTrailingZeros(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+        unsigned long index;
+        _BitScanForward64(&index, value);
+        return static_cast<uint32_t>(index);
+#else
+        return static_cast<uint32_t>(__builtin_ctzll(value));
+#endif
+    }
+}
@@ -1,11 +1,17 @@
 #pragma once
 #include <functional>
+#include <cstdint>
 #include <atomic>
 #include <thread>
 #include <vector>
 #include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <string>
+#include <memory>
+#include <exception>
+#include <algorithm>
+#include "../Diagnostics/Profiler.hpp"
 
 namespace Cogent::Threading {
 
@@ -26,7 +32,9 @@ namespace Cogent::Threading {
             _shutDown = false;
 
             for (unsigned int i = 0; i < numCores; ++i) {
-                _workerThreads.emplace_back([this] {
+                _workerThreads.emplace_back([this, i] {
+                    // [NEW] Track per worker di trace profiler
+                    Cogent::Diagnostics::Profiler::Get().SetThreadName("Worker " + std::to_string(i));
                     while (true) {
                         Job job;
                         {
@@ -38,7 +46,10 @@ namespace Cogent::Threading {
                             job = std::move(_jobQueue.front());
                             _jobQueue.pop();
                         }
-                        job();
+                        {
+                            PROFILE_SCOPE("Job");
+                            job();
+                        }
                         _finishedLabel.fetch_add(1);
                     }
                 });
@@ -54,13 +65,63 @@ namespace Cogent::Threading {
             _condition.notify_one();
         }
 
+        // [NEW] Data-parallel: func(jobIndex) untuk jobIndex di [0, jobCount), dipecah per groupSize.
+        // Blocking; thread pemanggil ikut mengerjakan group milik dispatch ini saja (bukan job lain di queue),
+        // tetap jalan walau belum Initialize. Exception dari func dilempar ulang di pemanggil setelah semua group selesai.
+        void Dispatch(uint32_t jobCount, uint32_t groupSize, const std::function<void(uint32_t)>& func) {
+            if (jobCount == 0 || groupSize == 0) return;
+
+            const uint32_t groupCount = (jobCount + groupSize - 1) / groupSize;
+            if (groupCount == 1 || _workerThreads.empty()) {
+                for (uint32_t i = 0; i < jobCount; ++i) func(i);
+                return;
+            }
+
+            // State di heap: helper yang baru jalan setelah Dispatch return hanya menyentuh state ini,
+            // func hanya dipanggil untuk group yang berhasil di-claim (Dispatch belum boleh return)
+            struct DispatchState {
+                std::atomic<uint32_t> nextGroup{0};
+                std::atomic<uint32_t> remaining{0};
+                std::mutex errorMutex;
+                std::exception_ptr error;
+            };
+            auto state = std::make_shared<DispatchState>();
+            state->remaining.store(groupCount);
+
+            const std::function<void(uint32_t)>* funcPtr = &func;
+            auto runGroups = [state, funcPtr, groupCount, groupSize, jobCount] {
+                for (uint32_t group = state->nextGroup.fetch_add(1); group < groupCount; group = state->nextGroup.fetch_add(1)) {
+                    const uint32_t begin = group * groupSize;
+                    const uint32_t end = (begin + groupSize < jobCount) ? begin + groupSize : jobCount;
+                    try {
+                        for (uint32_t i = begin; i < end; ++i) (*funcPtr)(i);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(state->errorMutex);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    state->remaining.fetch_sub(1);
+                }
+            };
+
+            // Satu helper per worker (maks groupCount - 1); group dibagi lewat counter, bukan satu job per group
+            const uint32_t helperCount = std::min(groupCount - 1, static_cast<uint32_t>(_workerThreads.size()));
+            for (uint32_t i = 0; i < helperCount; ++i) Execute(runGroups);
+
+            runGroups();
+            while (state->remaining.load() > 0) std::this_thread::yield();
+
+            if (state->error) std::rethrow_exception(state->error);
+        }
+
+        uint32_t GetWorkerCount() const { return static_cast<uint32_t>(_workerThreads.size()); }
+
         bool IsBusy() {
             return _finishedLabel.load() < _currentLabel;
         }
 
         void Wait() {
             while (IsBusy()) {
-                std::this_thread::yield();
+                if (!RunPendingJob()) std::this_thread::yield();
             }
         }
 
@@ -77,6 +138,23 @@ namespace Cogent::Threading {
         }
 
     private:
+        // [NEW] Ambil satu job dari queue dan jalankan di thread pemanggil (dipakai Wait)
+        bool RunPendingJob() {
+            Job job;
+            {
+                std::lock_guard<std::mutex> lock(_queueMutex);
+                if (_jobQueue.empty()) return false;
+                job = std::move(_jobQueue.front());
+                _jobQueue.pop();
+            }
+            {
+                PROFILE_SCOPE("Job");
+                job();
+            }
+            _finishedLabel.fetch_add(1);
+            return true;
+        }
+
         JobSystem() : _currentLabel(0), _finishedLabel(0), _shutDown(false) {}
         ~JobSystem() { Shutdown(); }
 
@@ -7,9 +7,7 @@
 #include <string>
 #include <functional> // Required for std::hash
 
-// GLM Configuration
-#define GLM_FORCE_RADIANS
-#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+// GLM Configuration (GLM_FORCE_RADIANS + GLM_FORCE_DEPTH_ZERO_TO_ONE diset di CMakeLists untuk semua TU)
 #define GLM_ENABLE_EXPERIMENTAL // Required for gtx/hash
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -121,31 +119,7 @@ struct GlobalLightUBO {
 };
 
 // ==========================================
-// 5. GAME OBJECT (Scene Representation)
-// ==========================================
-struct GameObject {
-    std::string name;       // Name of the object (for editor)
-    glm::mat4 model;        // Transform model (position, rotation, scale)
-    glm::vec4 color;        // Color for editor visualization
-    int id;                 // Unique ID for picking
-    int meshID;             // [FIX] Added meshID to identify mesh type (0=Cube, 1=Sphere, etc.)
-    
-    // Bounding Volume (World Space) - Updated when model matrix changes
-    // Using a simple struct or including Frustum header if safely forward declared.
-    // To avoid header cycles, we define struct here or use glm::vec3 min/max directly.
-    glm::vec3 aabbMin = glm::vec3(-1.0f);
-    glm::vec3 aabbMax = glm::vec3(1.0f);
-
-    ObjectPushConstant getPushConstant() const {
-        ObjectPushConstant pc{};
-        pc.model = model;
-        pc.color = color;
-        return pc;
-    }
-};
-
-// ==========================================
-// 6. HASH SPECIALIZATION
+// 5. HASH SPECIALIZATION
 // ==========================================
 namespace std {
     // Note: hash<glm::vec3> and hash<glm::vec2> are now handled by <glm/gtx/hash.hpp>
@@ -8,12 +8,13 @@
 #include "../Core/Types.hpp"
 #include "../Core/Camera.hpp"
 #include "../Core/Logger.hpp"
+#include "../Core/Diagnostics/Profiler.hpp"
 
 namespace fs = std::filesystem;
 
 void EditorUI::Init(GLFWwindow* window, VkInstance instance, VkPhysicalDevice physicalDevice, 
                     VkDevice device, uint32_t queueFamily, VkQueue queue, 
-                    VkRenderPass renderPass, uint32_t minImageCount) 
+                    VkRenderPass renderPass, uint32_t minImageCount, VkPipelineCache pipelineCache) 
 {
     // 1. Create Descriptor Pool
     VkDescriptorPoolSize pool_sizes[] = {
@@ -66,7 +67,7 @@ void EditorUI::Init(GLFWwindow* window, VkInstance instance, VkPhysicalDevice ph
     init_info.Device = device;
     init_info.QueueFamily = queueFamily;
     init_info.Queue = queue;
-    init_info.PipelineCache = VK_NULL_HANDLE;
+    init_info.PipelineCache = pipelineCache; // [MODIFIED] Cache device (persist ke disk)
     init_info.DescriptorPool = imguiPool;
     init_info.MinImageCount = minImageCount;
     init_info.ImageCount = minImageCount;
@@ -79,7 +80,7 @@ void EditorUI::Init(GLFWwindow* window, VkInstance instance, VkPhysicalDevice ph
 }
 
 // [FIX] Parameter fungsi ditambahkan: onSpawn callback, outSceneSize, textureSize
-void EditorUI::Update(AppState& currentState, bool& showCursor, float& deltaTime, Camera& camera, ObjectPushConstant& selectedObject, std::vector<GameObject>& gameObjects, int& selectedIndex, VkDescriptorSet sceneTexture, std::function<void(int)> onSpawn, glm::vec2* outSceneSize, glm::vec2 textureSize) {
+void EditorUI::Update(AppState& currentState, bool& showCursor, float& deltaTime, Camera& camera, ObjectPushConstant& selectedObject, Cogent::Scene::World& world, int& selectedIndex, VkDescriptorSet sceneTexture, std::function<void(int)> onSpawn, glm::vec2* outSceneSize, glm::vec2 textureSize, PickCallback onPick) {
     
     // 1. Setup Frame ImGui
     ImGui_ImplVulkan_NewFrame();
@@ -116,7 +117,7 @@ void EditorUI::Update(AppState& currentState, bool& showCursor, float& deltaTime
     else if (currentState == AppState::EDITOR) {
         // [FIX] Passing data Camera & Object ke Workspace
         // Agar Gizmo dan Inspector bisa bekerja!
-        RenderEditorWorkspace(showCursor, deltaTime, camera, selectedObject, gameObjects, selectedIndex, sceneTexture, onSpawn, outSceneSize, textureSize);
+        RenderEditorWorkspace(showCursor, deltaTime, camera, selectedObject, world, selectedIndex, sceneTexture, onSpawn, outSceneSize, textureSize, onPick);
     }
 
     // 4. Render Draw Data
@@ -807,7 +808,7 @@ void EditorUI::RenderFolderBrowserModal() {
 //                          MODERN EDITOR WORKSPACE
 // ==================================================================================
 
-   void EditorUI::RenderEditorWorkspace(bool showCursor, float deltaTime, Camera& camera, ObjectPushConstant& selectedObject, std::vector<GameObject>& gameObjects, int& selectedIndex, VkDescriptorSet sceneTexture, std::function<void(int)> onSpawn, glm::vec2* outSceneSize, glm::vec2 textureSize) {
+   void EditorUI::RenderEditorWorkspace(bool showCursor, float deltaTime, Camera& camera, ObjectPushConstant& selectedObject, Cogent::Scene::World& world, int& selectedIndex, VkDescriptorSet sceneTexture, std::function<void(int)> onSpawn, glm::vec2* outSceneSize, glm::vec2 textureSize, PickCallback onPick) {
     
     // 1. Setup DockSpace
     ImGuiID dockspace_id = ImGui::GetID("MyDockSpace");
@@ -916,6 +917,24 @@ void EditorUI::RenderFolderBrowserModal() {
             }
 
             ImGui::Image((ImTextureID)sceneTexture, windowSize, uv0, uv1);
+
+            // [NEW] Klik kiri di Scene View -> ray dari kamera, query BVH lewat onPick
+            if (showCursor && onPick && ImGui::IsItemHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left) &&
+                !ImGuizmo::IsOver() && !ImGuizmo::IsUsing()) {
+                ImVec2 imageMin = ImGui::GetItemRectMin();
+                ImVec2 mouse = ImGui::GetIO().MousePos;
+                float ndcX = (mouse.x - imageMin.x) / windowSize.x * 2.0f - 1.0f;
+                float ndcY = (mouse.y - imageMin.y) / windowSize.y * 2.0f - 1.0f; // Proj sudah Y-flip
+
+                glm::mat4 invViewProj = glm::inverse(camera.getProjectionMatrix(windowSize.x / windowSize.y) * camera.getViewMatrix());
+                glm::vec4 nearPoint = invViewProj * glm::vec4(ndcX, ndcY, 0.0f, 1.0f);
+                glm::vec4 farPoint = invViewProj * glm::vec4(ndcX, ndcY, 1.0f, 1.0f);
+                glm::vec3 rayOrigin = glm::vec3(nearPoint) / nearPoint.w;
+                glm::vec3 rayDir = glm::normalize(glm::vec3(farPoint) / farPoint.w - rayOrigin);
+
+                int hit = onPick(rayOrigin, rayDir);
+                if (hit >= 0) selectedIndex = hit;
+            }
         } else {
              ImGui::TextDisabled("No Scene Texture Available");
         }
@@ -1016,14 +1035,17 @@ void EditorUI::RenderFolderBrowserModal() {
     ImGui::End();
 
     // 6. Hierarchy Panel
-    RenderHierarchy(gameObjects, selectedIndex, camera, onSpawn);
+    RenderHierarchy(world, selectedIndex, camera, onSpawn);
 
     // 7. Console Panel
     RenderConsole();
+
+    // 8. Profiler Panel
+    RenderProfiler();
 }
 
 // Tambahkan parameter list object dan index yang dipilih
-void EditorUI::RenderHierarchy(std::vector<GameObject>& objects, int& selectedIndex, Camera& camera, std::function<void(int)> onSpawn) {
+void EditorUI::RenderHierarchy(Cogent::Scene::World& world, int& selectedIndex, Camera& camera, std::function<void(int)> onSpawn) {
     ImGui::Begin("Hierarchy");
     
     // [New] Explicit Create Button
@@ -1048,22 +1070,28 @@ void EditorUI::RenderHierarchy(std::vector<GameObject>& objects, int& selectedIn
         ImGui::EndPopup();
     }
     // Loop semua object
-    for (int i = 0; i < objects.size(); i++) {
-        ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_Leaf | ImGuiTreeNodeFlags_NoTreePushOnOpen;
-        if (selectedIndex == i) {
-            flags |= ImGuiTreeNodeFlags_Selected;
+    // [NEW] Tree parent/child: root dulu, child di bawah parent-nya. Drag node ke node lain = reparent,
+    // drop ke area kosong = jadikan root. Reparent ditunda sampai loop selesai (child list sedang dibaca).
+    pendingReparent = {};
+    const auto& hierarchy = world.hierarchy();
+    for (uint32_t row = 0; row < world.size(); row++) {
+        if (hierarchy[row].parent == Cogent::Scene::Entity::INVALID) {
+            RenderHierarchyNode(world, row, selectedIndex, camera);
         }
+    }
 
-        ImGui::TreeNodeEx((void*)(intptr_t)i, flags, "%s", objects[i].name.c_str());
-
-        if (ImGui::IsItemClicked()) {
-            selectedIndex = i;
-            
-            // [New] Focus Camera on Click
-            glm::vec3 objPos = glm::vec3(objects[i].model[3]);
-            camera.Focus(objPos, 5.0f);
+    ImGui::Dummy(ImGui::GetContentRegionAvail());
+    if (ImGui::BeginDragDropTarget()) {
+        if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("COGENT_ENTITY")) {
+            pendingReparent = { *static_cast<const Cogent::Scene::Entity*>(payload->Data), Cogent::Scene::Entity{}, true };
         }
+        ImGui::EndDragDropTarget();
+    }
+
+    if (pendingReparent.active) {
+        world.setParent(pendingReparent.child, pendingReparent.parent);
     }
+
     // Klik area kosong untuk unselect
     if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered() && !ImGui::IsAnyItemHovered()) {
         selectedIndex = -1;
@@ -1071,6 +1099,51 @@ void EditorUI::RenderHierarchy(std::vector<GameObject>& objects, int& selectedIn
     ImGui::End();
 }
 
+void EditorUI::RenderHierarchyNode(Cogent::Scene::World& world, uint32_t row, int& selectedIndex, Camera& camera) {
+    const Cogent::Scene::Hierarchy& node = world.hierarchy()[row];
+    const Cogent::Scene::Entity entity = world.entityAt(row);
+
+    ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_SpanAvailWidth;
+    if (node.firstChild == Cogent::Scene::Entity::INVALID) {
+        flags |= ImGuiTreeNodeFlags_Leaf;
+    }
+    if (selectedIndex == (int)row) {
+        flags |= ImGuiTreeNodeFlags_Selected;
+    }
+
+    // ID = entity index (stabil walaupun row bergeser)
+    bool open = ImGui::TreeNodeEx((void*)(intptr_t)entity.index, flags, "%s", world.names()[row].c_str());
+
+    if (ImGui::IsItemClicked() && !ImGui::IsItemToggledOpen()) {
+        selectedIndex = (int)row;
+        
+        // [New] Focus Camera on Click
+        glm::vec3 objPos = glm::vec3(world.transforms()[row][3]);
+        camera.Focus(objPos, 5.0f);
+    }
+
+    if (ImGui::BeginDragDropSource()) {
+        ImGui::SetDragDropPayload("COGENT_ENTITY", &entity, sizeof(entity));
+        ImGui::Text("%s", world.names()[row].c_str());
+        ImGui::EndDragDropSource();
+    }
+    if (ImGui::BeginDragDropTarget()) {
+        if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("COGENT_ENTITY")) {
+            pendingReparent = { *static_cast<const Cogent::Scene::Entity*>(payload->Data), entity, true };
+        }
+        ImGui::EndDragDropTarget();
+    }
+
+    if (open) {
+        for (uint32_t child = node.firstChild; child != Cogent::Scene::Entity::INVALID; ) {
+            const uint32_t childRow = world.rowOfIndex(child);
+            RenderHierarchyNode(world, childRow, selectedIndex, camera);
+            child = world.hierarchy()[childRow].nextSibling;
+        }
+        ImGui::TreePop();
+    }
+}
+
 void EditorUI::RenderConsole() {
     ImGui::Begin("Console");
     if (ImGui::Button("Clear")) consoleLogs.clear();
@@ -1097,3 +1170,39 @@ void EditorUI::RenderConsole() {
     ImGui::EndChild();
     ImGui::End();
 }
+
+void EditorUI::RenderProfiler() {
+    Cogent::Diagnostics::Profiler& profiler = Cogent::Diagnostics::Profiler::Get();
+    ImGui::Begin("Profiler");
+
+    bool enabled = profiler.IsEnabled();
+    if (ImGui::Checkbox("Enabled", &enabled)) profiler.SetEnabled(enabled);
+    ImGui::SameLine();
+    if (profiler.IsRecording()) {
+        ImGui::TextDisabled("Capturing...");
+    } else if (ImGui::Button("Capture 120 frames")) {
+        profiler.CaptureFrames(120, "cogent_trace.json");
+    }
+    ImGui::Separator();
+
+    constexpr ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("ProfilerScopes", 7, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+        for (const char* column : { "Calls/frame", "Mean ms", "p50", "p95", "p99", "Max" }) {
+            ImGui::TableSetupColumn(column, ImGuiTableColumnFlags_WidthFixed);
+        }
+        ImGui::TableHeadersRow();
+
+        for (const Cogent::Diagnostics::ScopeStats& stats : profiler.GetScopeStats()) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn(); ImGui::TextUnformatted(stats.name);
+            ImGui::TableNextColumn(); ImGui::Text("%.1f", stats.callsPerFrame);
+            for (double value : { stats.meanMs, stats.p50Ms, stats.p95Ms, stats.p99Ms, stats.maxMs }) {
+                ImGui::TableNextColumn(); ImGui::Text("%.3f", value);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
@@ -11,6 +11,7 @@
 #include <filesystem>
 #include "../Core/Types.hpp"
 #include "../Core/Camera.hpp"
+#include "../Scene/World.hpp"
 
 enum class AppState {
     LOADING,
@@ -20,14 +21,17 @@ enum class AppState {
 
 class EditorUI {
 public:
+    // [NEW] Picking: (ray origin, ray direction world space) -> row di Scene::World atau -1
+    using PickCallback = std::function<int(const glm::vec3&, const glm::vec3&)>;
+
     void Init(GLFWwindow* window, VkInstance instance, VkPhysicalDevice physicalDevice, 
               VkDevice device, uint32_t queueFamily, VkQueue queue, 
-              VkRenderPass renderPass, uint32_t minImageCount);
+              VkRenderPass renderPass, uint32_t minImageCount, VkPipelineCache pipelineCache = VK_NULL_HANDLE);
 
     // [New] Check if Scene View is focused for Input
     bool isSceneViewFocused = false;
 
-    void Update(AppState& currentState, bool& showCursor, float& deltaTime, Camera& camera, ObjectPushConstant& selectedObject, std::vector<GameObject>& gameObjects, int& selectedIndex, VkDescriptorSet sceneTexture = VK_NULL_HANDLE, std::function<void(int)> onSpawn = nullptr, glm::vec2* outSceneSize = nullptr, glm::vec2 textureSize = {0,0});
+    void Update(AppState& currentState, bool& showCursor, float& deltaTime, Camera& camera, ObjectPushConstant& selectedObject, Cogent::Scene::World& world, int& selectedIndex, VkDescriptorSet sceneTexture = VK_NULL_HANDLE, std::function<void(int)> onSpawn = nullptr, glm::vec2* outSceneSize = nullptr, glm::vec2 textureSize = {0,0}, PickCallback onPick = nullptr);
     void Draw(VkCommandBuffer commandBuffer);
     void Cleanup(VkDevice device);
     
@@ -36,13 +40,22 @@ private:
     void ApplyModernDarkTheme();
     void RenderLoadingScreen(AppState& currentState);
     void RenderProjectHub(AppState& currentState, bool& showCursor);
-    void RenderEditorWorkspace(bool showCursor, float deltaTime, Camera& camera, ObjectPushConstant& selectedObject, std::vector<GameObject>& gameObjects, int& selectedIndex, VkDescriptorSet sceneTexture, std::function<void(int)> onSpawn, glm::vec2* outSceneSize = nullptr, glm::vec2 textureSize = {0,0});
-    void RenderHierarchy(std::vector<GameObject>& objects, int& selectedIndex, Camera& camera, std::function<void(int)> onSpawn);
+    void RenderEditorWorkspace(bool showCursor, float deltaTime, Camera& camera, ObjectPushConstant& selectedObject, Cogent::Scene::World& world, int& selectedIndex, VkDescriptorSet sceneTexture, std::function<void(int)> onSpawn, glm::vec2* outSceneSize = nullptr, glm::vec2 textureSize = {0,0}, PickCallback onPick = nullptr);
+    void RenderHierarchy(Cogent::Scene::World& world, int& selectedIndex, Camera& camera, std::function<void(int)> onSpawn);
+    void RenderHierarchyNode(Cogent::Scene::World& world, uint32_t row, int& selectedIndex, Camera& camera); // [NEW] Rekursif per child
     void RenderConsole(); // [New]
+    void RenderProfiler(); // [NEW] Statistik scope CPU (window frame terakhir)
     void RenderFolderBrowserModal(); 
 
     VkDescriptorPool imguiPool;
     float loadingProgress = 0.0f;
+
+    // [NEW] Reparent dari drag-drop hierarchy, diterapkan setelah tree selesai digambar
+    struct PendingReparent {
+        Cogent::Scene::Entity child;
+        Cogent::Scene::Entity parent;
+        bool active = false;
+    } pendingReparent;
     
     // Console State
     std::vector<std::string> consoleLogs;
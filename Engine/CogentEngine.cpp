@@ -2,6 +2,11 @@
 #include <set>
 #include <algorithm>
 #include <fstream>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <exception>
+#include <functional>
 #include "../Resources/ResourceManager.hpp"
 
 // Statically link the callback for GLFW
@@ -36,13 +41,37 @@ void CogentEngine::mouse_callback(GLFWwindow* window, double xposIn, double ypos
 }
 
 // Constructor
-CogentEngine::CogentEngine() 
-    : graphicsDevice(true), 
-      gBuffer(graphicsDevice, WIDTH, HEIGHT) 
+CogentEngine::CogentEngine(const HeadlessOptions& headlessOptions)
+    : headless(headlessOptions),
+      graphicsDevice(true, headlessOptions.enabled),
+      gBuffer(graphicsDevice, WIDTH, HEIGHT),
+      geometryPool(graphicsDevice)
 {
     // Initialize other members if needed
 }
 
+// [NEW] Argumen command line menimpa env
+HeadlessOptions HeadlessOptions::parse(int argc, char** argv) {
+    HeadlessOptions options;
+    if (const char* value = std::getenv("COGENT_HEADLESS")) options.enabled = std::string(value) != "0";
+    if (const char* value = std::getenv("COGENT_HEADLESS_FRAMES")) options.frames = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+    if (const char* value = std::getenv("COGENT_HEADLESS_TIMINGS")) options.timingsPath = value;
+    if (const char* value = std::getenv("COGENT_HEADLESS_DUMP")) options.dumpDir = value;
+    if (const char* value = std::getenv("COGENT_HEADLESS_DUMP_INTERVAL")) options.dumpInterval = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--headless") options.enabled = true;
+        else if (arg == "--frames" && hasValue) options.frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--timings" && hasValue) options.timingsPath = argv[++i];
+        else if (arg == "--dump" && hasValue) options.dumpDir = argv[++i];
+        else if (arg == "--dump-interval" && hasValue) options.dumpInterval = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else LOG_WARN("Unknown argument: " + arg);
+    }
+    return options;
+}
+
 void CogentEngine::framebufferResizeCallback(GLFWwindow* window, int width, int height) {
     auto app = reinterpret_cast<CogentEngine*>(glfwGetWindowUserPointer(window));
     app->framebufferResized = true;
@@ -53,15 +82,37 @@ void CogentEngine::run() {
     Cogent::Threading::JobSystem::Get().Initialize();
     LOG_INFO("Job System Initialized");
 
-    initWindow();
+    // [NEW] Trace CPU: COGENT_TRACE_FRAMES=N -> Chrome tracing JSON untuk N frame (COGENT_TRACE_PATH)
+    auto& profiler = Cogent::Diagnostics::Profiler::Get();
+    profiler.SetThreadName("Main");
+    if (const char* traceFrames = std::getenv("COGENT_TRACE_FRAMES")) {
+        const char* tracePath = std::getenv("COGENT_TRACE_PATH");
+        profiler.CaptureFrames(static_cast<uint32_t>(std::strtoul(traceFrames, nullptr, 10)), tracePath ? tracePath : "cogent_trace.json");
+    }
+
+    if (!headless.enabled) initWindow(); // [MODIFIED] Headless: tanpa GLFW
+    const auto startupBegin = std::chrono::steady_clock::now();
     initVulkan();
     initResources();
+
+    // [NEW] Cold (tanpa cache valid) vs warm (pipeline_cache.bin dari run sebelumnya)
+    const double startupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startupBegin).count();
+    LOG_INFO("Startup: " + std::to_string(startupMs) + " ms (" +
+             (graphicsDevice.getPipelineCacheStore().isWarm() ? "warm" : "cold") + " pipeline cache)");
+    graphicsDevice.getPipelineCacheStore().save(); // Simpan sekarang juga, jangan tunggu shutdown (crash)
     
     LOG_INFO("--- DIAGNOSTIC CHECK ---");
     // ... (Keep original diagnostic logs if needed)
     
     LOG_INFO("--- ALL SYSTEMS GO ---");
 
+    if (headless.enabled) {
+        // [NEW] Tanpa catch: exception naik ke main() -> exit code gagal (untuk CI / regression test)
+        headlessLoop();
+        cleanup();
+        return;
+    }
+
     try {
         mainLoop();
     } catch (const std::exception& e) {
@@ -93,14 +144,28 @@ void CogentEngine::initWindow() {
 
 void CogentEngine::initVulkan() {
     // Instance created in GraphicsDevice constructor
-    createSurface();
+    if (!headless.enabled) createSurface(); // [MODIFIED] Headless: surface tetap VK_NULL_HANDLE
     graphicsDevice.init(surface);
+    Cogent::Renderer::ShaderRegistry::Get().Init(graphicsDevice.getDevice()); // [NEW]
     createDescriptorSetLayout();
+    // [NEW] Jumlah frame in flight (default 2). 1 = perilaku lama (CPU menunggu GPU setiap frame).
+    if (const char* value = std::getenv("COGENT_FRAMES_IN_FLIGHT")) {
+        framesInFlight = std::clamp<uint32_t>(static_cast<uint32_t>(std::atoi(value)), 1u, MAX_FRAMES_IN_FLIGHT);
+    }
+    frames.resize(framesInFlight);
+    LOG_INFO("Frames in flight: " + std::to_string(framesInFlight));
+
     // Command Pool created in GraphicsDevice
-    createCommandBuffer();
+    createCommandBuffers();
     createSyncObjects();
-    createSwapchain();
-    createSwapchainImageViews();
+    Cogent::Diagnostics::GpuProfiler::Get().Init(graphicsDevice, framesInFlight); // [NEW] Range query per frame in flight
+    if (headless.enabled) {
+        createOffscreenTargets(); // [NEW]
+        createFrameTimestamps();
+    } else {
+        createSwapchain();
+        createSwapchainImageViews();
+    }
 }
 
 void CogentEngine::createSurface() {
@@ -110,6 +175,20 @@ void CogentEngine::createSurface() {
 }
 
 void CogentEngine::initResources() {
+    // [NEW] Baca semua SPIR-V startup paralel sebelum pipeline dibuat
+    Cogent::Renderer::ShaderRegistry::Get().preload({
+        "Shaders/gbuffer.vert.spv", "Shaders/gbuffer.frag.spv", "Shaders/lighting.vert.spv", "Shaders/lighting.frag.spv",
+        "Shaders/sss.comp.spv", "Shaders/cull.comp.spv", "Shaders/hiz.comp.spv", "Shaders/raytrace.comp.spv"
+    });
+
+    // [NEW] Preset kualitas: COGENT_PERF_MODE=raw|balanced|performance|low_power (default: balanced)
+    if (const char* value = std::getenv("COGENT_PERF_MODE")) {
+        using Cogent::Optimization::PerformanceMode;
+        const std::string name(value);
+        optimizer.setMode(name == "raw" ? PerformanceMode::RAW : name == "performance" ? PerformanceMode::PERFORMANCE
+                        : name == "low_power" ? PerformanceMode::LOW_POWER : PerformanceMode::BALANCED);
+    }
+
     LOG_INFO("Initializing G-Buffer...");
     // gBuffer is initialized in constructor, but we need to trigger init() explicitly now
     gBuffer.init();
@@ -120,7 +199,7 @@ void CogentEngine::initResources() {
     // Initialize ResourceManager with Streamer
     Cogent::Resources::ResourceManager::Get().Init(graphicsDevice.getDevice(), graphicsDevice.getPhysicalDevice(), graphicsDevice.getCommandPool(), graphicsDevice.getGraphicsQueue(), streamer.get());
     
-    createUniformBuffer();
+    createUniformBuffers();
     createDescriptorPool();
     createDescriptorSets();
     
@@ -130,54 +209,110 @@ void CogentEngine::initResources() {
     
     createTextureDescriptors();
 
-    LOG_INFO("Building Graphics Pipeline...");
-    std::vector<VkDescriptorSetLayout> layouts = { descriptorSetLayout, textureDescriptorLayout };
-    gBufferPipeline.init(graphicsDevice.getDevice(), gBuffer.getRenderPass(), {WIDTH, HEIGHT}, layouts);
-    
     LOG_INFO("Generating Primitive Meshes...");
-    meshes.resize(3);
+    // [NEW] Semua mesh masuk ke satu GeometryPool (meshID = urutan addMesh)
+    geometryPool.init();
     PrimitiveMesh generator;
 
+    visibilitySystem = std::make_unique<Cogent::Renderer::VisibilitySystem>();
+
+    // [NEW] Mesh yang sama juga jadi geometry occluder untuk software occlusion culling
+    auto addPrimitive = [&](PrimitiveMesh& mesh) {
+        uint32_t meshID = geometryPool.addMesh(mesh.vertices, mesh.indices);
+
+        std::vector<glm::vec3> positions;
+        positions.reserve(mesh.vertices.size());
+        for (const auto& v : mesh.vertices) positions.push_back(v.pos);
+        visibilitySystem->getOcclusionCuller().registerMesh(static_cast<int>(meshID), positions, mesh.indices);
+    };
+
     generator.createCube();
-    meshes[0].loadFromMesh(graphicsDevice.getDevice(), graphicsDevice.getPhysicalDevice(), generator.vertices, generator.indices);
+    addPrimitive(generator);   // 0
 
     generator.createSphere(1.0f, 32, 32);
-    meshes[1].loadFromMesh(graphicsDevice.getDevice(), graphicsDevice.getPhysicalDevice(), generator.vertices, generator.indices);
+    addPrimitive(generator);   // 1
 
     generator.createCapsule(0.5f, 2.0f, 32, 16);
-    meshes[2].loadFromMesh(graphicsDevice.getDevice(), graphicsDevice.getPhysicalDevice(), generator.vertices, generator.indices);
+    addPrimitive(generator);   // 2
+
+    // [NEW] GPU diskrit: instance di-copy ke buffer DEVICE_LOCAL (ring host jadi staging).
+    // COGENT_HOST_INSTANCES=1 untuk paksa baca langsung dari memory host-visible.
+    VkPhysicalDeviceProperties deviceProperties{};
+    vkGetPhysicalDeviceProperties(graphicsDevice.getPhysicalDevice(), &deviceProperties);
+    const bool deviceLocalInstances = deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU &&
+                                      std::getenv("COGENT_HOST_INSTANCES") == nullptr;
+    instanceBuffer = std::make_unique<Cogent::Renderer::InstanceBuffer>(graphicsDevice, framesInFlight, deviceLocalInstances);
+    LOG_INFO(std::string("Instance Stream: ") + (deviceLocalInstances ? "device-local (staging ring)" : "host-visible ring"));
+
+    // [NEW] Record G-Buffer paralel ke secondary command buffer (COGENT_NO_PARALLEL_RECORD=1 untuk inline)
+    if (std::getenv("COGENT_NO_PARALLEL_RECORD") == nullptr) {
+        const uint32_t slots = Cogent::Threading::JobSystem::Get().GetWorkerCount() + 1; // + main thread
+        secondaryRecorder = std::make_unique<Cogent::Renderer::SecondaryCommandRecorder>(graphicsDevice, framesInFlight, slots);
+        workerStateCaches.resize(slots);
+    }
+
+    // [NEW] GPU-driven culling kalau device support drawIndirectCount (COGENT_CPU_CULLING=1 untuk paksa CPU path)
+    useGpuCulling = graphicsDevice.supportsDrawIndirectCount() && std::getenv("COGENT_CPU_CULLING") == nullptr;
+    validateGpuCulling = std::getenv("COGENT_VALIDATE_CULLING") != nullptr;
+    // [NEW] Kernel frustum SIMD dipilih via cpuid; COGENT_CULL_KERNEL=scalar|sse2|avx2|avx512 untuk override
+    if (const char* kernel = std::getenv("COGENT_CULL_KERNEL")) {
+        std::string name(kernel);
+        using Cogent::Math::Simd::Level;
+        Level level = name == "avx512" ? Level::AVX512 : name == "avx2" ? Level::AVX2 : name == "sse2" ? Level::SSE2 : Level::Scalar;
+        Cogent::Renderer::CullingKernels::setActiveLevel(level);
+    }
+    // [NEW] BVH frustum query (default) vs scan SIMD linear (COGENT_CULL_LINEAR=1)
+    visibilitySystem->setUseBVH(std::getenv("COGENT_CULL_LINEAR") == nullptr);
+    visibilitySystem->setTemporalCoherence(std::getenv("COGENT_NO_CULL_COHERENCE") == nullptr);
+    LOG_INFO(std::string("Frustum Culling Kernel: ") + Cogent::Math::Simd::levelName(Cogent::Renderer::CullingKernels::getActiveLevel()));
+
+    // [NEW] CPU path: software occlusion setelah frustum (tanpa GPU readback). COGENT_NO_OCCLUSION=1 untuk mematikan.
+    visibilitySystem->setOcclusionEnabled(!useGpuCulling && std::getenv("COGENT_NO_OCCLUSION") == nullptr);
+    LOG_INFO(std::string("Culling Path: ") + (useGpuCulling ? "GPU (vkCmdDrawIndexedIndirectCount)" : "CPU (instanced)"));
 
     createTextureSampler(); 
     // createLightingDescriptors();  // REMOVED: Handled by DeferredLightingPass
     createLightingRenderPass(); 
     createSwapchainFramebuffers(); 
     
-    // Initialize Deferred Lighting Pass (and internal descriptors)
-    // Initialize Deferred Lighting Pass (and internal descriptors)
-    deferredLightingPass = std::make_unique<DeferredLightingPass>(graphicsDevice, lightingRenderPass, swapchainExtent);
-    deferredLightingPass->init(descriptorSetLayout); // [MODIFIED] Pass Global Layout
-    deferredLightingPass->updateDescriptorSets(gBuffer);
+    // [MODIFIED] G-Buffer pipeline, Deferred Lighting, SSS, GPU culling dibuat paralel
+    createStartupPipelines();
+
+    if (useGpuCulling) {
+        // [NEW] Hi-Z two-phase occlusion (COGENT_NO_OCCLUSION=1 untuk frustum-only)
+        // Serial: konstruktor transisi layout pyramid lewat single-time command (queue tidak thread-safe)
+        hiZPass = std::make_unique<Cogent::Renderer::HiZPass>(graphicsDevice, gBuffer.getDepthImageView(), VkExtent2D{ gBuffer.getWidth(), gBuffer.getHeight() });
+        gpuCullingPass->setDepthPyramid(hiZPass->getPyramidView(), hiZPass->getSampler(), hiZPass->getWidth(), hiZPass->getHeight());
+        gpuCullingPass->setOcclusionEnabled(std::getenv("COGENT_NO_OCCLUSION") == nullptr);
+    }
 
-    // Initialize SSS
-    screenSpaceShadows = std::make_unique<ScreenSpaceShadows>(graphicsDevice, swapchainExtent);
-    // screenSpaceShadows->init(); // Removed: Called in constructor
-    screenSpaceShadows->updateDescriptorSets(gBuffer.getDepthImageView(), textureSampler, uniformBuffer);
+    deferredLightingPass->updateDescriptorSets(gBuffer);
+    // Binding 2 = slice camera di UniformRing (dynamic offset per frame)
+    screenSpaceShadows->updateDescriptorSets(gBuffer.getDepthImageView(), textureSampler, uniformRing->getBuffer(), sizeof(CameraUBO));
 
     LOG_INFO("Resources Initialized Successfully!");
 
-    LOG_INFO("Initializing ImGui Editor UI...");
-    
-    // We need to fetch Graphics Family Index again or expose it from GraphicsDevice
-    auto indices = GraphicsDevice::findQueueFamilies(graphicsDevice.getPhysicalDevice(), surface);
+    if (headless.enabled) {
+        // [NEW] Tanpa editor: scene langsung dirender full viewport
+        currentState = AppState::EDITOR;
+        renderingViewportSize = { (float)swapchainExtent.width, (float)swapchainExtent.height };
+    } else {
+        LOG_INFO("Initializing ImGui Editor UI...");
 
-    editorUI.Init(window, graphicsDevice.getInstance(), graphicsDevice.getPhysicalDevice(), graphicsDevice.getDevice(), 
-                indices.graphicsFamily.value(),
-                graphicsDevice.getGraphicsQueue(), lightingRenderPass, 2);
+        // We need to fetch Graphics Family Index again or expose it from GraphicsDevice
+        auto indices = GraphicsDevice::findQueueFamilies(graphicsDevice.getPhysicalDevice(), surface);
 
-    sceneDescriptorSet = ImGui_ImplVulkan_AddTexture(textureSampler, gBuffer.getAlbedoView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        editorUI.Init(window, graphicsDevice.getInstance(), graphicsDevice.getPhysicalDevice(), graphicsDevice.getDevice(), 
+                    indices.graphicsFamily.value(),
+                    graphicsDevice.getGraphicsQueue(), lightingRenderPass, 2, graphicsDevice.getPipelineCache());
+
+        sceneDescriptorSet = ImGui_ImplVulkan_AddTexture(textureSampler, gBuffer.getAlbedoView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    }
 
     LOG_INFO("Initializing Ray Tracer...");
-    rayTracer.init(graphicsDevice.getDevice(), graphicsDevice.getPhysicalDevice(), graphicsDevice.getCommandPool(), graphicsDevice.getGraphicsQueue(), swapchainExtent);
+    rayTracer.setMaxBounces(static_cast<uint32_t>(optimizer.getSettings().rayBounces));
+    rayTracer.init(graphicsDevice.getDevice(), graphicsDevice.getPhysicalDevice(), graphicsDevice.getCommandPool(), graphicsDevice.getGraphicsQueue(), swapchainExtent, *uniformRing,
+                   graphicsDevice.getPipelineCache());
 
     LOG_INFO("Spawning Demo Scene...");
     
@@ -187,56 +322,113 @@ void CogentEngine::initResources() {
     // 2. Surrounding Lights (Spheres with Bright Colors)
     // We use meshID 1 (Sphere) and manually set color/name
     
+    auto label = [&](Cogent::Scene::Entity entity, const char* name, const glm::vec4& color) {
+        const uint32_t row = world.rowOf(entity);
+        if (row == Cogent::Scene::Entity::INVALID) return;
+        world.names()[row] = name;
+        world.colors()[row] = color; // >1.0 for manual bloom/emissive look if supported, else just bright
+    };
+
     // Right (Red)
-    spawnObject(1, glm::vec3(2.5f, 0.0f, 0.0f));
-    gameObjects.back().name = "Light_Red";
-    gameObjects.back().color = glm::vec4(2.0f, 0.2f, 0.2f, 1.0f); // >1.0 for manual bloom/emissive look if supported, else just bright
+    label(spawnObject(1, glm::vec3(2.5f, 0.0f, 0.0f)), "Light_Red", glm::vec4(2.0f, 0.2f, 0.2f, 1.0f));
     
     // Left (Blue)
-    spawnObject(1, glm::vec3(-2.5f, 0.0f, 0.0f));
-    gameObjects.back().name = "Light_Blue";
-    gameObjects.back().color = glm::vec4(0.2f, 0.2f, 2.0f, 1.0f);
+    label(spawnObject(1, glm::vec3(-2.5f, 0.0f, 0.0f)), "Light_Blue", glm::vec4(0.2f, 0.2f, 2.0f, 1.0f));
 
     // Front (Green)
-    spawnObject(1, glm::vec3(0.0f, 2.5f, 0.0f)); // Y is Up/Forward depending on coord system. Vulkan Y is down, Z is depth? 
-    // Let's assume Z is depth for now based on previous camera setup
-    gameObjects.back().name = "Light_Green";
-    gameObjects.back().color = glm::vec4(0.2f, 2.0f, 0.2f, 1.0f);
+    // Y is Up/Forward depending on coord system. Let's assume Z is depth for now based on previous camera setup
+    label(spawnObject(1, glm::vec3(0.0f, 2.5f, 0.0f)), "Light_Green", glm::vec4(0.2f, 2.0f, 0.2f, 1.0f));
 
     // Back (Yellow) - Adjusted position to be visible
-    spawnObject(1, glm::vec3(0.0f, -2.5f, 0.0f));
-    gameObjects.back().name = "Light_Yellow";
-    gameObjects.back().color = glm::vec4(2.0f, 2.0f, 0.2f, 1.0f);
+    label(spawnObject(1, glm::vec3(0.0f, -2.5f, 0.0f)), "Light_Yellow", glm::vec4(2.0f, 2.0f, 0.2f, 1.0f));
     
     // Sun
     // Sun is a sphere (meshID=1, handled specially inside spawnObject)
+
+    // [NEW] Benchmark scene: COGENT_BENCH_OBJECTS=100000 -> grid cube di belakang demo scene
+    if (const char* benchCount = std::getenv("COGENT_BENCH_OBJECTS")) {
+        spawnBenchmarkScene(static_cast<uint32_t>(std::strtoul(benchCount, nullptr, 10)));
+    }
 }
 
-void CogentEngine::spawnObject(int meshID, glm::vec3 position) {
+void CogentEngine::createStartupPipelines() {
+    LOG_INFO("Building Pipelines...");
+    const auto start = std::chrono::steady_clock::now();
+    const VkPipelineCache pipelineCache = graphicsDevice.getPipelineCache();
+    const std::vector<VkDescriptorSetLayout> layouts = { descriptorSetLayout, bindlessHeap->getLayout() };
+
+    // Tiap job hanya membuat objek miliknya sendiri (layout, pool, image, pipeline): aman paralel.
+    // Pass yang submit ke queue saat konstruksi (Hi-Z, RayTracer) tetap serial di main thread.
+    std::vector<std::function<void()>> jobs;
+    jobs.push_back([&] {
+        gBufferPipeline.init(graphicsDevice.getDevice(), gBuffer.getRenderPass(), {WIDTH, HEIGHT}, layouts, pipelineCache);
+    });
+    jobs.push_back([&] {
+        deferredLightingPass = std::make_unique<DeferredLightingPass>(graphicsDevice, lightingRenderPass, swapchainExtent);
+        deferredLightingPass->init(descriptorSetLayout); // [MODIFIED] Pass Global Layout
+    });
+    jobs.push_back([&] {
+        screenSpaceShadows = std::make_unique<ScreenSpaceShadows>(graphicsDevice, swapchainExtent,
+                                                                  ScreenSpaceShadows::Quality::fromLevel(optimizer.getSettings().shadowQuality));
+    });
+    if (useGpuCulling) {
+        jobs.push_back([&] {
+            gpuCullingPass = std::make_unique<Cogent::Renderer::GpuCullingPass>(graphicsDevice, framesInFlight);
+        });
+    }
+
+    // Exception dari job dilempar ulang oleh Dispatch setelah semua job selesai
+    Cogent::Threading::JobSystem::Get().Dispatch(static_cast<uint32_t>(jobs.size()), 1, [&](uint32_t i) { jobs[i](); });
+
+    const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    LOG_INFO("Pipelines built in " + std::to_string(ms) + " ms (" + std::to_string(jobs.size()) + " jobs, " +
+             (graphicsDevice.getPipelineCacheStore().isWarm() ? "warm" : "cold") + " pipeline cache)");
+}
+
+void CogentEngine::spawnBenchmarkScene(uint32_t count) {
+    if (count == 0) return;
+
+    world.reserve(world.size() + count);
+    uint32_t side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+    const float spacing = 3.0f;
+
+    // [FIX] Bulk path: tanpa log per object dan tanpa ganti seleksi, satu log per batch
+    for (uint32_t i = 0; i < count; i++) {
+        float x = (static_cast<float>(i % side) - side * 0.5f) * spacing;
+        float y = (static_cast<float>(i / side) + 2.0f) * spacing; // Mulai di depan demo scene
+        createObject(static_cast<int>(i % geometryPool.getMeshCount()), glm::vec3(x, y, 0.0f));
+    }
+    sceneDirty = true;
+    LOG_INFO("Spawned Benchmark Scene: " + std::to_string(count) + " objects");
+}
+
+Cogent::Scene::Entity CogentEngine::spawnObject(int meshID, glm::vec3 position) {
     LOG_INFO("Attempting to Spawn Object with MeshID: " + std::to_string(meshID));
-    GameObject obj;
-    obj.id = (int)gameObjects.size();
     
-    if (meshID < 0 || meshID >= meshes.size()) {
+    if (meshID < 0 || meshID >= (int)geometryPool.getMeshCount()) {
         LOG_ERROR("Invalid MeshID: " + std::to_string(meshID));
-        return;
+        return {};
     }
 
-    obj.meshID = meshID; 
+    Cogent::Scene::Entity entity = createObject(meshID, position);
 
-    if (meshID == 0) obj.name = "Cube " + std::to_string(obj.id);
-    else if (meshID == 1) obj.name = "Sphere " + std::to_string(obj.id);
-    else if (meshID == 2) obj.name = "Capsule " + std::to_string(obj.id);
-    else obj.name = "Object " + std::to_string(obj.id);
+    sceneDirty = true;
+    selectedObjectIndex = static_cast<int>(world.rowOf(entity));
     
-    obj.model = glm::translate(glm::mat4(1.0f), position);
-    if (obj.color == glm::vec4(0.0f)) // Only set default if not already set
-        obj.color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f); 
+    LOG_INFO("Spawned Object: " + world.names()[selectedObjectIndex]);
+    return entity;
+}
 
-    gameObjects.push_back(obj);
-    selectedObjectIndex = obj.id;
+Cogent::Scene::Entity CogentEngine::createObject(int meshID, glm::vec3 position) {
+    const std::string number = std::to_string(world.size());
+    std::string name;
+    if (meshID == 0) name = "Cube " + number;
+    else if (meshID == 1) name = "Sphere " + number;
+    else if (meshID == 2) name = "Capsule " + number;
+    else name = "Object " + number;
     
-    LOG_INFO("Spawned Object: " + obj.name);
+    // World AABB dihitung di VisibilitySystem::updateBounds (row baru otomatis dirty)
+    return world.create(meshID, glm::translate(glm::mat4(1.0f), position), glm::vec4(1.0f), std::move(name));
 }
 
 void CogentEngine::mainLoop() {
@@ -244,10 +436,14 @@ void CogentEngine::mainLoop() {
         float currentFrame = static_cast<float>(glfwGetTime());
         deltaTime = currentFrame - lastFrame;
         lastFrame = currentFrame;
+        simulationTime = currentFrame;
 
         // Update Streamer
         glm::vec3 camPos = mainCamera.position; 
-        streamer->update(camPos, deltaTime);
+        {
+            PROFILE_SCOPE("Streamer::update");
+            streamer->update(camPos, deltaTime);
+        }
 
         glfwPollEvents();
 
@@ -268,42 +464,137 @@ void CogentEngine::mainLoop() {
             }
         }
 
-        editorUI.Update(currentState, showCursor, deltaTime, mainCamera, selectedObject, gameObjects, selectedObjectIndex, sceneDescriptorSet, [&](int meshID) {
+        editorUI.Update(currentState, showCursor, deltaTime, mainCamera, selectedObject, world, selectedObjectIndex, sceneDescriptorSet, [&](int meshID) {
             spawnObject(meshID, glm::vec3(0, 0, 0)); 
-        }, &renderingViewportSize, { (float)swapchainExtent.width, (float)swapchainExtent.height });
-
-        LOG_INFO("MainLoop: EditorUI::Update returned");
+        }, &renderingViewportSize, { (float)swapchainExtent.width, (float)swapchainExtent.height },
+        [&](const glm::vec3& origin, const glm::vec3& direction) {
+            return visibilitySystem->raycast(origin, direction).objectIndex; // [NEW] BVH picking
+        });
 
         if (currentState == AppState::EDITOR && selectedObjectIndex != -1) {
-            if (selectedObjectIndex >= 0 && selectedObjectIndex < gameObjects.size()) {
-                 gameObjects[selectedObjectIndex].model = selectedObject.model;
-                 gameObjects[selectedObjectIndex].color = selectedObject.color;
+            if (selectedObjectIndex >= 0 && selectedObjectIndex < (int)world.size()) {
+                 glm::vec4& targetColor = world.colors()[selectedObjectIndex];
+                 // [FIX] Seleksi baru (hierarchy / picking): load transform object ke gizmo dulu,
+                 // jangan timpa object dengan transform seleksi sebelumnya
+                 if (syncedSelectionIndex != selectedObjectIndex) {
+                     selectedObject.model = world.transforms()[selectedObjectIndex];
+                     selectedObject.color = targetColor;
+                     selectedObject.id = static_cast<int>(world.entityAt(selectedObjectIndex).index);
+                     syncedSelectionIndex = selectedObjectIndex;
+                     syncedSelectionModel = selectedObject.model;
+                 }
+                 // [NEW] Gizmo diubah -> local TRS dihitung dari matrix world (child ikut lewat updateTransforms).
+                 // Dibandingkan dengan nilai terakhir yang di-sync, bukan hasil decompose, supaya tidak drift tiap frame.
+                 if (selectedObject.model != syncedSelectionModel) {
+                     world.setWorldTransform(static_cast<uint32_t>(selectedObjectIndex), selectedObject.model);
+                     syncedSelectionModel = selectedObject.model;
+                 } else if (world.transforms()[selectedObjectIndex] != syncedSelectionModel) {
+                     // Digerakkan parent: gizmo ikut
+                     selectedObject.model = world.transforms()[selectedObjectIndex];
+                     syncedSelectionModel = selectedObject.model;
+                 }
+                 if (targetColor != selectedObject.color) {
+                     targetColor = selectedObject.color;
+                     sceneChangedRows.push_back(static_cast<uint32_t>(selectedObjectIndex));
+                 }
             }
         }
 
-        if (currentState == AppState::EDITOR) {
-            LOG_INFO("MainLoop: Calling updateUniformBuffer");
-            updateUniformBuffer();
-            LOG_INFO("MainLoop: updateUniformBuffer returned");
+        // [NEW] Transform hierarchy: world matrix hanya untuk subtree dirty -> bounds stage ikut dirty
+        if (world.updateTransforms(transformChanges) > 0) {
+            for (uint32_t row : transformChanges) visibilitySystem->markDirty(row);
+            sceneChangedRows.insert(sceneChangedRows.end(), transformChanges.begin(), transformChanges.end());
         }
 
-        LOG_INFO("MainLoop: Calling drawFrame");
         drawFrame();
-        LOG_INFO("MainLoop: drawFrame returned");
     } // End of main loop
     vkDeviceWaitIdle(graphicsDevice.getDevice());
 }
 
+// [NEW] Scene demo (+ COGENT_BENCH_OBJECTS) dengan camera orbit scripted dan delta time tetap:
+// dua run dengan argumen sama merender frame yang sama, jadi timing dan image bisa dibandingkan antar build.
+void CogentEngine::headlessLoop() {
+    constexpr float FIXED_DELTA = 1.0f / 60.0f;
+    constexpr float ORBIT_SECONDS = 10.0f; // Satu putaran camera
+    LOG_INFO("Headless: " + std::to_string(headless.frames) + " frames at " + std::to_string(swapchainExtent.width) +
+             "x" + std::to_string(swapchainExtent.height));
+
+    frameTimings.clear();
+    frameTimings.reserve(headless.frames);
+    for (uint32_t i = 0; i < headless.frames; i++) {
+        const auto frameBegin = std::chrono::steady_clock::now();
+        deltaTime = FIXED_DELTA;
+        simulationTime = static_cast<float>(i) * FIXED_DELTA;
+
+        mainCamera.yaw = 360.0f * simulationTime / ORBIT_SECONDS;
+        mainCamera.pitch = -20.0f;
+        mainCamera.processMouseMovement(0.0f, 0.0f); // Hitung ulang front/right/up
+        mainCamera.Focus(glm::vec3(0.0f), 10.0f);
+
+        streamer->update(mainCamera.position, deltaTime);
+        if (world.updateTransforms(transformChanges) > 0) {
+            for (uint32_t row : transformChanges) visibilitySystem->markDirty(row);
+            sceneChangedRows.insert(sceneChangedRows.end(), transformChanges.begin(), transformChanges.end());
+        }
+
+        FrameTiming timing;
+        timing.frame = frameNumber;
+        frameTimings.push_back(timing);
+        const uint32_t slot = currentFrame;
+        drawFrame();
+        if (frameQueryPool != VK_NULL_HANDLE) frameQueryOwner[slot] = static_cast<int64_t>(frameTimings.size() - 1);
+
+        FrameTiming& current = frameTimings.back();
+        current.frameMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameBegin).count();
+        current.cpuMs = current.frameMs - lastFenceWaitMs;
+
+        const bool finalFrame = i + 1 == headless.frames;
+        const bool dumpThis = headless.dumpInterval > 0 ? (i % headless.dumpInterval == 0) : finalFrame;
+        if (!headless.dumpDir.empty() && dumpThis) {
+            dumpOffscreenImage(lastImageIndex, headless.dumpDir + "/frame_" + std::to_string(i) + ".ppm");
+        }
+    }
+
+    vkDeviceWaitIdle(graphicsDevice.getDevice());
+    for (uint32_t slot = 0; slot < framesInFlight; slot++) collectFrameTimestamps(slot);
+
+    if (!frameTimings.empty()) {
+        double cpuTotal = 0.0, gpuTotal = 0.0, frameTotal = 0.0;
+        for (const FrameTiming& timing : frameTimings) {
+            frameTotal += timing.frameMs;
+            cpuTotal += timing.cpuMs;
+            gpuTotal += timing.gpuMs;
+        }
+        const double count = static_cast<double>(frameTimings.size());
+        LOG_INFO("Headless average: frame " + std::to_string(frameTotal / count) + " ms, CPU " +
+                 std::to_string(cpuTotal / count) + " ms, GPU " + std::to_string(gpuTotal / count) + " ms");
+    }
+
+    // [NEW] Scope CPU termahal atas window frame terakhir
+    const std::vector<Cogent::Diagnostics::ScopeStats> scopes = Cogent::Diagnostics::Profiler::Get().GetScopeStats();
+    for (size_t i = 0; i < std::min<size_t>(scopes.size(), 10); i++) {
+        const Cogent::Diagnostics::ScopeStats& stats = scopes[i];
+        LOG_INFO("Profiler " + std::string(stats.name) + ": " + std::to_string(stats.callsPerFrame) + " calls/frame, mean " +
+                 std::to_string(stats.meanMs) + " ms, p95 " + std::to_string(stats.p95Ms) + " ms, p99 " +
+                 std::to_string(stats.p99Ms) + " ms, max " + std::to_string(stats.maxMs) + " ms");
+    }
+    if (!headless.timingsPath.empty()) writeFrameTimings(headless.timingsPath);
+}
+
 void CogentEngine::cleanup() {
     LOG_INFO("Cleaning up resources...");
     vkDeviceWaitIdle(graphicsDevice.getDevice());
+    Cogent::Diagnostics::GpuProfiler::Get().Cleanup(); // [NEW] Hasil GPU terakhir masuk capture sebelum ditulis
+    Cogent::Diagnostics::Profiler::Get().EndSession(); // [NEW] Tulis capture yang belum selesai
     
     // [NEW] Shutdown Job System
     Cogent::Threading::JobSystem::Get().Shutdown();
 
-    vkDestroySemaphore(graphicsDevice.getDevice(), renderFinishedSemaphore, nullptr);
-    vkDestroySemaphore(graphicsDevice.getDevice(), imageAvailableSemaphore, nullptr);
-    vkDestroyFence(graphicsDevice.getDevice(), inFlightFence, nullptr);
+    for (FrameData& frame : frames) {
+        vkDestroySemaphore(graphicsDevice.getDevice(), frame.renderFinished, nullptr);
+        vkDestroySemaphore(graphicsDevice.getDevice(), frame.imageAvailable, nullptr);
+        vkDestroyFence(graphicsDevice.getDevice(), frame.inFlight, nullptr);
+    }
 
     // deferredLightingPass destructor handles cleanup (via RAII or manual call if needed)
     // But destructors are better. `LightingPass` had explicit cleanup. `DeferredLightingPass` has destructor.
@@ -320,10 +611,15 @@ void CogentEngine::cleanup() {
 
     lightingRenderPass = VK_NULL_HANDLE; // Will be destroyed
 
-    for (auto imageView : swapchainImageViews) {
-        vkDestroyImageView(graphicsDevice.getDevice(), imageView, nullptr);
+    if (headless.enabled) {
+        destroyOffscreenTargets(); // [NEW]
+        vkDestroyQueryPool(graphicsDevice.getDevice(), frameQueryPool, nullptr);
+    } else {
+        for (auto imageView : swapchainImageViews) {
+            vkDestroyImageView(graphicsDevice.getDevice(), imageView, nullptr);
+        }
+        vkDestroySwapchainKHR(graphicsDevice.getDevice(), swapchain, nullptr);
     }
-    vkDestroySwapchainKHR(graphicsDevice.getDevice(), swapchain, nullptr);
 
     // Command Pool destroyed by GraphicsDevice
     // vkDestroyCommandPool(device, commandPool, nullptr); 
@@ -331,14 +627,22 @@ void CogentEngine::cleanup() {
     // gBuffer cleanup handled by destructor
     rayTracer.cleanup(graphicsDevice.getDevice());
     myModel.cleanup(graphicsDevice.getDevice());
+    geometryPool.cleanup();
+    instanceBuffer.reset();
+    secondaryRecorder.reset();
+    hiZPass.reset();
+    gpuCullingPass.reset();
+    graphicsDevice.getDeletionQueue().flush(); // [NEW] Sisa deferred destroy (device sudah idle)
+    bindlessHeap.reset(); // Setelah flush: release slot tertunda masih memegang pointer heap
+    graphicsDevice.getPipelineCacheStore().shutdown(); // [NEW] Simpan pipeline yang dibuat setelah startup (resize, dll)
+    Cogent::Renderer::ShaderRegistry::Get().Shutdown();
 
     vkDestroyDescriptorPool(graphicsDevice.getDevice(), descriptorPool, nullptr);
     vkDestroyDescriptorSetLayout(graphicsDevice.getDevice(), descriptorSetLayout, nullptr);
-    vkDestroyDescriptorPool(graphicsDevice.getDevice(), textureDescriptorPool, nullptr);
-    vkDestroyDescriptorSetLayout(graphicsDevice.getDevice(), textureDescriptorLayout, nullptr);
     myTexture.cleanup(graphicsDevice.getDevice());
-    vkDestroyBuffer(graphicsDevice.getDevice(), uniformBuffer, nullptr);
-    vkFreeMemory(graphicsDevice.getDevice(), uniformBufferMemory, nullptr);
+    uniformRing.reset();
+
+    if (headless.enabled) return; // [NEW] Tanpa surface, ImGui, dan window
 
     // Device destroyed by GraphicsDevice destructor
     // vkDestroyDevice(device, nullptr); 
@@ -360,16 +664,19 @@ void CogentEngine::cleanup() {
 // Implementations of Core Helpers
 // Core Helpers Removed (Moved to GraphicsDevice)
 
-void CogentEngine::createCommandBuffer() {
+void CogentEngine::createCommandBuffers() {
+    std::vector<VkCommandBuffer> commandBuffers(frames.size());
+
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.commandPool = graphicsDevice.getCommandPool();
     allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandBufferCount = 1;
+    allocInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
 
-    if (vkAllocateCommandBuffers(graphicsDevice.getDevice(), &allocInfo, &commandBuffer) != VK_SUCCESS) {
+    if (vkAllocateCommandBuffers(graphicsDevice.getDevice(), &allocInfo, commandBuffers.data()) != VK_SUCCESS) {
         throw std::runtime_error("Gagal mengalokasikan Command Buffer!");
     }
+    for (size_t i = 0; i < frames.size(); i++) frames[i].commandBuffer = commandBuffers[i];
 }
 
 void CogentEngine::createSyncObjects() {
@@ -380,10 +687,12 @@ void CogentEngine::createSyncObjects() {
     fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
     fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-    if (vkCreateSemaphore(graphicsDevice.getDevice(), &semaphoreInfo, nullptr, &imageAvailableSemaphore) != VK_SUCCESS ||
-        vkCreateSemaphore(graphicsDevice.getDevice(), &semaphoreInfo, nullptr, &renderFinishedSemaphore) != VK_SUCCESS ||
-        vkCreateFence(graphicsDevice.getDevice(), &fenceInfo, nullptr, &inFlightFence) != VK_SUCCESS) {
-        throw std::runtime_error("Gagal membuat objek sinkronisasi!");
+    for (FrameData& frame : frames) {
+        if (vkCreateSemaphore(graphicsDevice.getDevice(), &semaphoreInfo, nullptr, &frame.imageAvailable) != VK_SUCCESS ||
+            vkCreateSemaphore(graphicsDevice.getDevice(), &semaphoreInfo, nullptr, &frame.renderFinished) != VK_SUCCESS ||
+            vkCreateFence(graphicsDevice.getDevice(), &fenceInfo, nullptr, &frame.inFlight) != VK_SUCCESS) {
+            throw std::runtime_error("Gagal membuat objek sinkronisasi!");
+        }
     }
 }
 
@@ -445,6 +754,7 @@ void CogentEngine::createSwapchain() {
     vkGetSwapchainImagesKHR(graphicsDevice.getDevice(), swapchain, &imageCount, nullptr);
     swapchainImages.resize(imageCount);
     vkGetSwapchainImagesKHR(graphicsDevice.getDevice(), swapchain, &imageCount, swapchainImages.data());
+    imagesInFlight.assign(imageCount, VK_NULL_HANDLE); // [NEW] Belum ada frame yang memakai image baru
 
     swapchainImageFormat = surfaceFormat.format;
     swapchainExtent = extent;
@@ -484,6 +794,7 @@ void CogentEngine::recreateSwapchain() {
     }
 
     vkDeviceWaitIdle(graphicsDevice.getDevice());
+    graphicsDevice.getDeletionQueue().flush(); // GPU idle: semua yang tertunda aman dilepas
 
     for (auto framebuffer : swapchainFramebuffers) {
         vkDestroyFramebuffer(graphicsDevice.getDevice(), framebuffer, nullptr);
@@ -501,9 +812,172 @@ void CogentEngine::recreateSwapchain() {
 
     gBuffer.resize(swapchainExtent.width, swapchainExtent.height);
 
+    // [NEW] Hi-Z mengikuti ukuran depth buffer baru
+    if (hiZPass) {
+        hiZPass = std::make_unique<Cogent::Renderer::HiZPass>(graphicsDevice, gBuffer.getDepthImageView(), VkExtent2D{ gBuffer.getWidth(), gBuffer.getHeight() });
+        gpuCullingPass->setDepthPyramid(hiZPass->getPyramidView(), hiZPass->getSampler(), hiZPass->getWidth(), hiZPass->getHeight());
+    }
+
     sceneDescriptorSet = ImGui_ImplVulkan_AddTexture(textureSampler, gBuffer.getAlbedoView(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 }
 
+void CogentEngine::createOffscreenTargets() {
+    // Format dan ukuran sama dengan swapchain biasa, supaya lighting pass + pipeline identik
+    swapchainImageFormat = VK_FORMAT_B8G8R8A8_SRGB;
+    swapchainExtent = {WIDTH, HEIGHT};
+    swapchainImages.resize(framesInFlight);
+    swapchainImageViews.resize(framesInFlight);
+    offscreenMemory.resize(framesInFlight);
+    imagesInFlight.assign(framesInFlight, VK_NULL_HANDLE);
+
+    for (uint32_t i = 0; i < framesInFlight; i++) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.format = swapchainImageFormat;
+        imageInfo.extent = { swapchainExtent.width, swapchainExtent.height, 1 };
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        if (vkCreateImage(graphicsDevice.getDevice(), &imageInfo, nullptr, &swapchainImages[i]) != VK_SUCCESS) {
+            throw std::runtime_error("Gagal membuat offscreen image!");
+        }
+
+        VkMemoryRequirements memRequirements;
+        vkGetImageMemoryRequirements(graphicsDevice.getDevice(), swapchainImages[i], &memRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memRequirements.size;
+        allocInfo.memoryTypeIndex = graphicsDevice.findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if (vkAllocateMemory(graphicsDevice.getDevice(), &allocInfo, nullptr, &offscreenMemory[i]) != VK_SUCCESS) {
+            throw std::runtime_error("Gagal mengalokasikan memory offscreen image!");
+        }
+        vkBindImageMemory(graphicsDevice.getDevice(), swapchainImages[i], offscreenMemory[i], 0);
+    }
+
+    createSwapchainImageViews();
+    LOG_INFO("Headless: " + std::to_string(framesInFlight) + " offscreen targets (no surface / swapchain)");
+}
+
+void CogentEngine::destroyOffscreenTargets() {
+    for (size_t i = 0; i < swapchainImages.size(); i++) {
+        vkDestroyImageView(graphicsDevice.getDevice(), swapchainImageViews[i], nullptr);
+        vkDestroyImage(graphicsDevice.getDevice(), swapchainImages[i], nullptr);
+        vkFreeMemory(graphicsDevice.getDevice(), offscreenMemory[i], nullptr);
+    }
+    swapchainImageViews.clear();
+    swapchainImages.clear();
+    offscreenMemory.clear();
+}
+
+void CogentEngine::createFrameTimestamps() {
+    VkPhysicalDeviceProperties properties{};
+    vkGetPhysicalDeviceProperties(graphicsDevice.getPhysicalDevice(), &properties);
+
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(graphicsDevice.getPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(graphicsDevice.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+    // Queue tanpa timestamp (timestampValidBits = 0): GPU time dilaporkan 0, CPU time tetap jalan
+    if (queueFamilies[graphicsDevice.getGraphicsQueueFamily()].timestampValidBits == 0) {
+        LOG_WARN("Headless: graphics queue tidak mendukung timestamp, GPU time tidak diukur");
+        return;
+    }
+    timestampPeriod = properties.limits.timestampPeriod;
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = framesInFlight * 2;
+
+    if (vkCreateQueryPool(graphicsDevice.getDevice(), &poolInfo, nullptr, &frameQueryPool) != VK_SUCCESS) {
+        throw std::runtime_error("Gagal membuat timestamp query pool!");
+    }
+    frameQueryOwner.assign(framesInFlight, -1);
+}
+
+void CogentEngine::collectFrameTimestamps(uint32_t slot) {
+    if (frameQueryPool == VK_NULL_HANDLE || frameQueryOwner[slot] < 0) return;
+
+    uint64_t ticks[2] = {};
+    if (vkGetQueryPoolResults(graphicsDevice.getDevice(), frameQueryPool, slot * 2, 2, sizeof(ticks), ticks,
+                              sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS) {
+        frameTimings[static_cast<size_t>(frameQueryOwner[slot])].gpuMs =
+            static_cast<double>(ticks[1] - ticks[0]) * timestampPeriod / 1000000.0;
+    }
+    frameQueryOwner[slot] = -1;
+}
+
+void CogentEngine::dumpOffscreenImage(uint32_t imageIndex, const std::string& path) {
+    // Dump jarang (opsional): cukup tunggu GPU idle lalu copy lewat single-time command
+    vkDeviceWaitIdle(graphicsDevice.getDevice());
+
+    const uint32_t width = swapchainExtent.width;
+    const uint32_t height = swapchainExtent.height;
+    const VkDeviceSize size = static_cast<VkDeviceSize>(width) * height * 4;
+
+    VkBuffer readback;
+    VkDeviceMemory readbackMemory;
+    graphicsDevice.createBuffer(size, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, readback, readbackMemory);
+
+    // Image sudah TRANSFER_SRC_OPTIMAL (finalLayout lighting pass headless)
+    VkCommandBuffer commandBuffer = graphicsDevice.beginSingleTimeCommands();
+    VkBufferImageCopy region{};
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = { width, height, 1 };
+    vkCmdCopyImageToBuffer(commandBuffer, swapchainImages[imageIndex], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readback, 1, &region);
+    graphicsDevice.endSingleTimeCommands(commandBuffer);
+
+    void* mapped = nullptr;
+    vkMapMemory(graphicsDevice.getDevice(), readbackMemory, 0, size, 0, &mapped);
+    const uint8_t* bgra = static_cast<const uint8_t*>(mapped);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_WARN("Headless: tidak bisa menulis " + path);
+    } else {
+        file << "P6\n" << width << " " << height << "\n255\n";
+        std::vector<uint8_t> row(static_cast<size_t>(width) * 3);
+        for (uint32_t y = 0; y < height; y++) {
+            const uint8_t* src = bgra + static_cast<size_t>(y) * width * 4;
+            for (uint32_t x = 0; x < width; x++) {
+                row[x * 3 + 0] = src[x * 4 + 2];
+                row[x * 3 + 1] = src[x * 4 + 1];
+                row[x * 3 + 2] = src[x * 4 + 0];
+            }
+            file.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(row.size()));
+        }
+        LOG_INFO("Headless: dumped " + path);
+    }
+
+    vkUnmapMemory(graphicsDevice.getDevice(), readbackMemory);
+    vkDestroyBuffer(graphicsDevice.getDevice(), readback, nullptr);
+    vkFreeMemory(graphicsDevice.getDevice(), readbackMemory, nullptr);
+}
+
+void CogentEngine::writeFrameTimings(const std::string& path) const {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_WARN("Headless: tidak bisa menulis " + path);
+        return;
+    }
+    file << "frame,frame_ms,cpu_ms,gpu_ms\n";
+    for (const FrameTiming& timing : frameTimings) {
+        file << timing.frame << "," << timing.frameMs << "," << timing.cpuMs << "," << timing.gpuMs << "\n";
+    }
+    LOG_INFO("Headless: timings written to " + path);
+}
+
 void CogentEngine::createLightingRenderPass() {
     VkAttachmentDescription colorAttachment{};
     colorAttachment.format = swapchainImageFormat;
@@ -513,7 +987,8 @@ void CogentEngine::createLightingRenderPass() {
     colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
     colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
     colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+    // [MODIFIED] Headless: image offscreen siap di-copy (dump) setelah pass
+    colorAttachment.finalLayout = headless.enabled ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 
     VkAttachmentReference colorAttachmentRef{};
     colorAttachmentRef.attachment = 0;
@@ -593,7 +1068,7 @@ void CogentEngine::createTextureSampler() {
 void CogentEngine::createDescriptorSetLayout() {
     VkDescriptorSetLayoutBinding uboLayoutBinding{};
     uboLayoutBinding.binding = 0;
-    uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; // Offset slice UniformRing saat bind
     uboLayoutBinding.descriptorCount = 1;
     uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT; 
     uboLayoutBinding.pImmutableSamplers = nullptr;
@@ -608,13 +1083,9 @@ void CogentEngine::createDescriptorSetLayout() {
     }
 }
 
-void CogentEngine::createUniformBuffer() {
-    VkDeviceSize bufferSize = sizeof(CameraUBO);
-    createBuffer(bufferSize, 
-                 VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 
-                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 
-                 uniformBuffer, uniformBufferMemory);
-    vkMapMemory(graphicsDevice.getDevice(), uniformBufferMemory, 0, bufferSize, 0, &uniformBufferMapped);
+// [NEW] Semua uniform per frame (camera, ray tracer, SSS) dialokasi dari satu ring persistently mapped
+void CogentEngine::createUniformBuffers() {
+    uniformRing = std::make_unique<Cogent::Renderer::UniformRing>(graphicsDevice, framesInFlight);
 }
 
 void CogentEngine::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
@@ -653,14 +1124,14 @@ void CogentEngine::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkM
 
 void CogentEngine::createDescriptorPool() {
     VkDescriptorPoolSize poolSize{};
-    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSize.descriptorCount = 1;
 
     VkDescriptorPoolCreateInfo poolInfo{};
     poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
     poolInfo.poolSizeCount = 1;
     poolInfo.pPoolSizes = &poolSize;
-    poolInfo.maxSets = 1;
+    poolInfo.maxSets = 1; // Frame in flight dibedakan lewat dynamic offset, bukan set
 
     if (vkCreateDescriptorPool(graphicsDevice.getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
         throw std::runtime_error("Gagal membuat descriptor pool!");
@@ -679,8 +1150,8 @@ void CogentEngine::createDescriptorSets() {
     }
 
     VkDescriptorBufferInfo bufferInfo{};
-    bufferInfo.buffer = uniformBuffer;      
-    bufferInfo.offset = 0;                  
+    bufferInfo.buffer = uniformRing->getBuffer();      
+    bufferInfo.offset = 0;                  // + dynamic offset saat bind
     bufferInfo.range = sizeof(CameraUBO);   
 
     VkWriteDescriptorSet descriptorWrite{};
@@ -688,7 +1159,7 @@ void CogentEngine::createDescriptorSets() {
     descriptorWrite.dstSet = descriptorSet;
     descriptorWrite.dstBinding = 0;         
     descriptorWrite.dstArrayElement = 0;
-    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER; 
+    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; 
     descriptorWrite.descriptorCount = 1;
     descriptorWrite.pBufferInfo = &bufferInfo; 
 
@@ -696,6 +1167,7 @@ void CogentEngine::createDescriptorSets() {
 }
 
 void CogentEngine::updateUniformBuffer() {
+    PROFILE_FUNCTION();
     static auto startTime = std::chrono::high_resolution_clock::now();
     auto currentTime = std::chrono::high_resolution_clock::now();
     float time = std::chrono::duration<float, std::chrono::seconds::period>(currentTime - startTime).count();
@@ -715,7 +1187,7 @@ void CogentEngine::updateUniformBuffer() {
     lastProj = ubo.proj;
 
     ubo.viewPos = mainCamera.position;
-    ubo.time = time;
+    ubo.time = headless.enabled ? simulationTime : time; // [MODIFIED] Headless deterministik
     ubo.deltaTime = deltaTime;
 
     // Hardcoded Sun for now (to debug "No Lighting")
@@ -724,114 +1196,104 @@ void CogentEngine::updateUniformBuffer() {
     ubo.lightColor = glm::vec3(1.0f, 0.95f, 0.8f); // Warm Sun
     ubo.lightIntensity = 2.0f;
 
-    memcpy(uniformBufferMapped, &ubo, sizeof(ubo));
+    cameraUBO = ubo; // Di-push ke UniformRing di drawFrame
 }
 
+// [MODIFIED] Material texture masuk ke BindlessHeap global (bukan set per material).
+// Index stabil; gbuffer.frag meng-index lewat InstanceData::materialIndex, set 1 di-bind sekali per pass.
 void CogentEngine::createTextureDescriptors() {
-    VkDescriptorSetLayoutBinding samplerLayoutBinding{};
-    samplerLayoutBinding.binding = 0;
-    samplerLayoutBinding.descriptorCount = 1; 
-    samplerLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    samplerLayoutBinding.pImmutableSamplers = nullptr; 
-    samplerLayoutBinding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+    bindlessHeap = std::make_unique<Cogent::Renderer::BindlessHeap>(graphicsDevice);
 
-    VkDescriptorSetLayoutCreateInfo layoutInfo{};
-    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutInfo.bindingCount = 1;
-    layoutInfo.pBindings = &samplerLayoutBinding;
-
-    if (vkCreateDescriptorSetLayout(graphicsDevice.getDevice(), &layoutInfo, nullptr, &textureDescriptorLayout) != VK_SUCCESS) {
-        throw std::runtime_error("FATAL ERROR: Failed to create Texture Descriptor Layout!");
-    }
-
-    VkDescriptorPoolSize poolSize{};
-    poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    poolSize.descriptorCount = 1;
-
-    VkDescriptorPoolCreateInfo poolInfo{};
-    poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-    poolInfo.poolSizeCount = 1;
-    poolInfo.pPoolSizes = &poolSize;
-    poolInfo.maxSets = 1; 
-
-    if (vkCreateDescriptorPool(graphicsDevice.getDevice(), &poolInfo, nullptr, &textureDescriptorPool) != VK_SUCCESS) {
-        throw std::runtime_error("FATAL ERROR: Failed to create Texture Descriptor Pool!");
-    }
-
-    VkDescriptorSetAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-    allocInfo.descriptorPool = textureDescriptorPool;
-    allocInfo.descriptorSetCount = 1;
-    allocInfo.pSetLayouts = &textureDescriptorLayout;
-
-    if (vkAllocateDescriptorSets(graphicsDevice.getDevice(), &allocInfo, &textureDescriptorSet) != VK_SUCCESS) {
-        throw std::runtime_error("FATAL ERROR: Failed to allocate Texture Descriptor Set!");
-    }
-
-    VkDescriptorImageInfo imageInfo{};
-    imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    imageInfo.imageView = whiteTexture.getImageView();
-    imageInfo.sampler = whiteTexture.getSampler();
-
-    VkWriteDescriptorSet descriptorWrite{};
-    descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    descriptorWrite.dstSet = textureDescriptorSet;
-    descriptorWrite.dstBinding = 0; 
-    descriptorWrite.dstArrayElement = 0;
-    descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    descriptorWrite.descriptorCount = 1;
-    descriptorWrite.pImageInfo = &imageInfo;
-
-    vkUpdateDescriptorSets(graphicsDevice.getDevice(), 1, &descriptorWrite, 0, nullptr);
+    // Material 0 = texture default
+    materialTextures.push_back(bindlessHeap->registerTexture(whiteTexture.getImageView(), whiteTexture.getSampler()));
+    drawBatcher.setMaterialTable(materialTextures);
 }
 
 void CogentEngine::drawFrame() {
-    LOG_INFO("drawFrame: Waiting for Fences");
-    vkWaitForFences(graphicsDevice.getDevice(), 1, &inFlightFence, VK_TRUE, UINT64_MAX);
-    LOG_INFO("drawFrame: Fences Ready");
+    Cogent::Diagnostics::Profiler::Get().BeginFrame(frameNumber); // [NEW] Batas frame capture trace
+    PROFILE_FUNCTION();
+
+    // [NEW] Hanya menunggu frame yang memakai slot ini (framesInFlight frame lalu), bukan frame sebelumnya
+    FrameData& frame = frames[currentFrame];
+    const auto waitBegin = std::chrono::steady_clock::now();
+    {
+        PROFILE_SCOPE("WaitForFences");
+        vkWaitForFences(graphicsDevice.getDevice(), 1, &frame.inFlight, VK_TRUE, UINT64_MAX);
+    }
+    lastFenceWaitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - waitBegin).count();
+    collectFrameTimestamps(currentFrame); // [NEW] Frame lama di slot ini sudah selesai di GPU
+    Cogent::Diagnostics::GpuProfiler::Get().Collect(); // [NEW] Scope GPU frame lain yang sudah selesai (non-blocking)
+
+    // [NEW] Fence slot ini selesai = semua frame <= frameNumber - framesInFlight sudah retire di GPU.
+    // Handle yang di-destroy selama frame ini direkam di-tag frameNumber.
+    DeletionQueue& deletionQueue = graphicsDevice.getDeletionQueue();
+    if (frameNumber >= framesInFlight) deletionQueue.retire(frameNumber - framesInFlight);
+    deletionQueue.setCurrentFrame(frameNumber);
+    uniformRing->beginFrame(currentFrame); // Region ring milik slot ini sudah tidak dibaca GPU
+
+    // [MODIFIED] Headless: image offscreen milik slot ini, tanpa acquire (fence slot sudah di-wait)
+    uint32_t imageIndex = currentFrame;
+    VkResult result = VK_SUCCESS;
+    if (!headless.enabled) {
+        PROFILE_SCOPE("AcquireImage");
+        result = vkAcquireNextImageKHR(graphicsDevice.getDevice(), swapchain, UINT64_MAX, frame.imageAvailable, VK_NULL_HANDLE, &imageIndex);
+
+        if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+            recreateSwapchain();
+            return; 
+        } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+            throw std::runtime_error("Failed to acquire swapchain image!");
+        }
 
-    uint32_t imageIndex;
-    VkResult result = vkAcquireNextImageKHR(graphicsDevice.getDevice(), swapchain, UINT64_MAX, imageAvailableSemaphore, VK_NULL_HANDLE, &imageIndex);
-    LOG_INFO("drawFrame: Image Acquired Index: " + std::to_string(imageIndex));
+        // Image bisa di-acquire out-of-order: tunggu frame lain yang masih merender ke image ini
+        if (imagesInFlight[imageIndex] != VK_NULL_HANDLE && imagesInFlight[imageIndex] != frame.inFlight) {
+            vkWaitForFences(graphicsDevice.getDevice(), 1, &imagesInFlight[imageIndex], VK_TRUE, UINT64_MAX);
+        }
+        imagesInFlight[imageIndex] = frame.inFlight;
+    }
 
-    if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-        recreateSwapchain();
-        return; 
-    } else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
-        throw std::runtime_error("Failed to acquire swapchain image!");
+    if (currentState == AppState::EDITOR) {
+        updateUniformBuffer();
     }
+    // Slice camera baru tiap frame (di luar EDITOR isinya tetap UBO terakhir)
+    cameraUniformOffset = uniformRing->push(cameraUBO);
 
-    LOG_INFO("drawFrame: Resetting Fences");
-    vkResetFences(graphicsDevice.getDevice(), 1, &inFlightFence);
+    vkResetFences(graphicsDevice.getDevice(), 1, &frame.inFlight);
     
-    LOG_INFO("drawFrame: Resetting Command Buffer");
-    vkResetCommandBuffer(commandBuffer, 0);
+    vkResetCommandBuffer(frame.commandBuffer, 0);
     
-    LOG_INFO("drawFrame: Recording Command Buffer");
-    recordCommandBuffer(commandBuffer, imageIndex);
-    LOG_INFO("drawFrame: Command Buffer Recorded");
+    recordCommandBuffer(frame.commandBuffer, imageIndex);
 
     VkSubmitInfo submitInfo{};
     submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
 
-    VkSemaphore waitSemaphores[] = {imageAvailableSemaphore};
+    // [MODIFIED] Headless: tidak ada acquire/present yang perlu disinkronkan
+    VkSemaphore waitSemaphores[] = {frame.imageAvailable};
     VkPipelineStageFlags waitStages[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
-    submitInfo.waitSemaphoreCount = 1;
+    submitInfo.waitSemaphoreCount = headless.enabled ? 0 : 1;
     submitInfo.pWaitSemaphores = waitSemaphores;
     submitInfo.pWaitDstStageMask = waitStages;
 
     submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &commandBuffer;
+    submitInfo.pCommandBuffers = &frame.commandBuffer;
 
-    VkSemaphore signalSemaphores[] = {renderFinishedSemaphore};
-    submitInfo.signalSemaphoreCount = 1;
+    VkSemaphore signalSemaphores[] = {frame.renderFinished};
+    submitInfo.signalSemaphoreCount = headless.enabled ? 0 : 1;
     submitInfo.pSignalSemaphores = signalSemaphores;
 
-    LOG_INFO("drawFrame: Submitting Queue");
-    if (vkQueueSubmit(graphicsDevice.getGraphicsQueue(), 1, &submitInfo, inFlightFence) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to submit draw command buffer!");
+    {
+        PROFILE_SCOPE("QueueSubmit");
+        if (vkQueueSubmit(graphicsDevice.getGraphicsQueue(), 1, &submitInfo, frame.inFlight) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to submit draw command buffer!");
+        }
+    }
+    lastImageIndex = imageIndex;
+
+    if (headless.enabled) {
+        currentFrame = (currentFrame + 1) % framesInFlight;
+        frameNumber++;
+        return;
     }
-    LOG_INFO("drawFrame: Queue Submitted");
 
     VkPresentInfoKHR presentInfo{};
     presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -843,7 +1305,13 @@ void CogentEngine::drawFrame() {
     presentInfo.pSwapchains = swapchains;
     presentInfo.pImageIndices = &imageIndex;
 
-    result = vkQueuePresentKHR(graphicsDevice.getPresentQueue(), &presentInfo);
+    {
+        PROFILE_SCOPE("QueuePresent");
+        result = vkQueuePresentKHR(graphicsDevice.getPresentQueue(), &presentInfo);
+    }
+
+    currentFrame = (currentFrame + 1) % framesInFlight;
+    frameNumber++;
 
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || framebufferResized) {
         framebufferResized = false;
@@ -853,7 +1321,115 @@ void CogentEngine::drawFrame() {
     }
 }
 
+// [NEW] Tunggu semua frame in flight selain slot yang sedang direkam (fence slot ini sudah di-reset)
+void CogentEngine::waitForOtherFrames() {
+    std::vector<VkFence> fences;
+    for (uint32_t i = 0; i < framesInFlight; i++) {
+        if (i != currentFrame) fences.push_back(frames[i].inFlight);
+    }
+    if (!fences.empty()) {
+        vkWaitForFences(graphicsDevice.getDevice(), static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX);
+    }
+}
+
+// [NEW] Viewport/scissor + state dasar G-Buffer. Dipanggil sekali per command buffer (primary atau
+// secondary): state tidak diwariskan ke secondary command buffer.
+void CogentEngine::bindGBufferState(VkCommandBuffer commandBuffer, Cogent::Renderer::CommandStateCache& cache) {
+    VkViewport viewport{};
+    viewport.x = 0.0f;
+    viewport.y = 0.0f;
+    viewport.width = (float)swapchainExtent.width;
+    viewport.height = (float)swapchainExtent.height;
+    viewport.minDepth = 0.0f;
+    viewport.maxDepth = 1.0f;
+    vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+
+    VkRect2D scissor{};
+    scissor.offset = {0, 0};
+    scissor.extent = swapchainExtent;
+    vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+    // Semua bind lewat state cache: bind yang sama dengan state terakhir tidak di-record
+    cache.reset(commandBuffer);
+    const VkPipelineLayout layout = gBufferPipeline.getPipelineLayout();
+    cache.bindPipeline(gBufferPipeline.getPipeline());
+    cache.bindDescriptorSet(layout, 0, descriptorSet, cameraUniformOffset);
+    cache.bindDescriptorSet(layout, 1, bindlessHeap->getDescriptorSet()); // Semua material, sekali per pass
+
+    // Satu bind VB/IB untuk seluruh pass + instance stream di binding 1
+    cache.bindVertexBuffer(0, geometryPool.getVertexBuffer());
+    cache.bindIndexBuffer(geometryPool.getIndexBuffer());
+}
+
+// [NEW] Instanced draw untuk batch [beginBatch, endBatch). Batch sudah urut per DrawKey
+// (pipeline -> material -> mesh). Hanya pipeline 0 (G-Buffer) untuk sekarang.
+// Material lewat bindless (InstanceData::materialIndex): tidak ada descriptor bind per draw.
+void CogentEngine::recordGBufferBatches(VkCommandBuffer commandBuffer, Cogent::Renderer::CommandStateCache& cache,
+                                        uint32_t beginBatch, uint32_t endBatch) {
+    const auto& batches = drawBatcher.getBatches();
+    cache.bindVertexBuffer(Cogent::Renderer::InstanceData::BINDING, instanceBuffer->getBuffer(), instanceBuffer->getOffset());
+
+    for (uint32_t i = beginBatch; i < endBatch; i++) {
+        const auto& batch = batches[i];
+        if (batch.pipelineID != 0) continue;
+        cache.bindPipeline(gBufferPipeline.getPipeline());
+        geometryPool.draw(commandBuffer, batch.meshID, batch.instanceCount, batch.firstInstance);
+    }
+}
+
+// Isi G-Buffer pass secara inline di primary (dipakai phase 0 dan phase 1 occlusion culling)
+void CogentEngine::recordGBufferGeometry(VkCommandBuffer commandBuffer, uint32_t phase) {
+    bindGBufferState(commandBuffer, stateCache);
+
+    if (useGpuCulling) {
+        gpuCullingPass->draw(commandBuffer, phase);
+    } else if (instanceBuffer->getInstanceCount() > 0) {
+        recordGBufferBatches(commandBuffer, stateCache, 0, static_cast<uint32_t>(drawBatcher.getBatches().size()));
+    }
+}
+
+// [NEW] Begin/end G-Buffer render pass. CPU path dengan banyak batch: batch dipecah per chunk dan
+// di-record paralel ke secondary command buffer (satu state cache per chunk), lalu dieksekusi primary.
+// GPU path cuma beberapa indirect draw, tetap inline.
+void CogentEngine::recordGBufferPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo& passInfo, uint32_t phase) {
+    PROFILE_FUNCTION();
+    GPU_PROFILE_SCOPE(commandBuffer, "GBuffer");
+    const auto& batches = drawBatcher.getBatches();
+    const uint32_t batchCount = static_cast<uint32_t>(batches.size());
+    const uint32_t chunkCount = std::min(secondaryRecorder ? secondaryRecorder->getSlotCount() : 0u,
+                                         batchCount / PARALLEL_RECORD_MIN_BATCHES);
+
+    if (useGpuCulling || instanceBuffer->getInstanceCount() == 0 || chunkCount < 2) {
+        vkCmdBeginRenderPass(commandBuffer, &passInfo, VK_SUBPASS_CONTENTS_INLINE);
+            recordGBufferGeometry(commandBuffer, phase);
+        vkCmdEndRenderPass(commandBuffer);
+    } else {
+        vkCmdBeginRenderPass(commandBuffer, &passInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+        const auto& secondaries = secondaryRecorder->record(passInfo.renderPass, 0, passInfo.framebuffer, chunkCount,
+            [&](VkCommandBuffer secondary, uint32_t chunk) {
+                // Range batch rata per chunk (batch = satu draw call)
+                const uint32_t begin = static_cast<uint32_t>(uint64_t(batchCount) * chunk / chunkCount);
+                const uint32_t end = static_cast<uint32_t>(uint64_t(batchCount) * (chunk + 1) / chunkCount);
+                Cogent::Renderer::CommandStateCache& cache = workerStateCaches[chunk];
+                bindGBufferState(secondary, cache);
+                recordGBufferBatches(secondary, cache, begin, end);
+            });
+        vkCmdExecuteCommands(commandBuffer, static_cast<uint32_t>(secondaries.size()), secondaries.data());
+        vkCmdEndRenderPass(commandBuffer);
+    }
+
+    // SceneAnalyzer tidak thread-safe: statistik draw dicatat di main thread setelah record
+    if (!useGpuCulling && instanceBuffer->getInstanceCount() > 0) {
+        auto& analyzer = Cogent::Optimization::SceneAnalyzer::Get();
+        for (const auto& batch : batches) {
+            if (batch.pipelineID != 0) continue;
+            analyzer.registerDrawCall(geometryPool.getMesh(batch.meshID).indexCount / 3 * batch.instanceCount);
+        }
+    }
+}
+
 void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+    PROFILE_FUNCTION();
     VkCommandBufferBeginInfo beginInfo{};
     beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 
@@ -861,6 +1437,10 @@ void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t i
         throw std::runtime_error("Failed to start recording command buffer!");
     }
 
+    // [NEW] Scope GPU frame ini (fence slot sudah di-wait di drawFrame); pass di bawah nested di "GPU Frame"
+    auto& gpuProfiler = Cogent::Diagnostics::GpuProfiler::Get();
+    gpuProfiler.BeginFrame(commandBuffer, currentFrame);
+
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderPassInfo.renderPass = gBuffer.getRenderPass();
@@ -877,53 +1457,111 @@ void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t i
     renderPassInfo.clearValueCount = static_cast<uint32_t>(clearValues.size());
     renderPassInfo.pClearValues = clearValues.data();
 
-    rayTracer.render(commandBuffer, VK_NULL_HANDLE, mainCamera, static_cast<float>(glfwGetTime()));
+    // [NEW] Timestamp awal frame (headless). Reset di command buffer: query slot ini sudah dibaca
+    if (frameQueryPool != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(commandBuffer, frameQueryPool, currentFrame * 2, 2);
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, frameQueryPool, currentFrame * 2);
+    }
 
-    vkCmdBeginRenderPass(commandBuffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
+    {
+        GPU_PROFILE_SCOPE(commandBuffer, "RayTracer");
+        rayTracer.render(commandBuffer, VK_NULL_HANDLE, mainCamera, simulationTime); // [MODIFIED] Waktu scene, bukan glfwGetTime
+    }
 
-        VkViewport viewport{};
-        viewport.x = 0.0f;
-        viewport.y = 0.0f;
-        viewport.width = (float)swapchainExtent.width;
-        viewport.height = (float)swapchainExtent.height;
-        viewport.minDepth = 0.0f;
-        viewport.maxDepth = 1.0f;
-        vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+    // [NEW] Culling + batching stage (fence sudah di-wait, buffer aman di-overwrite)
+    auto& analyzer = Cogent::Optimization::SceneAnalyzer::Get();
+    analyzer.resetFrame();
+    stateCache.resetStats();
+    for (auto& cache : workerStateCaches) cache.resetStats();
+    if (secondaryRecorder) secondaryRecorder->beginFrame(currentFrame); // Fence slot ini sudah di-wait
+    if (gpuCullingPass) gpuCullingPass->beginFrame(currentFrame);
+
+    glm::mat4 viewProj = mainCamera.getProjectionMatrix(renderingViewportSize.x / renderingViewportSize.y) * mainCamera.getViewMatrix();
+    visibilitySystem->update(viewProj);
+    visibilitySystem->updateBounds(world, geometryPool); // [NEW] Hanya transform dirty
+
+    if (useGpuCulling) {
+        // Readback slot ini = hasil GPU dari frame terakhir yang memakai slot ini; bandingkan dengan CPU reference
+        // yang dihitung di frame itu juga (scene + frustum sama). Dengan occlusion, GPU boleh lebih sedikit
+        // (object tertutup) tapi tidak boleh lebih banyak.
+        if (validateGpuCulling) {
+            const uint32_t cpuReference = cpuReferenceVisibleCount[currentFrame];
+            const uint32_t gpuVisible = gpuCullingPass->getLastVisibleCount();
+            const bool mismatch = gpuCullingPass->isOcclusionEnabled() ? (gpuVisible > cpuReference) : (gpuVisible != cpuReference);
+            if (mismatch) {
+                LOG_WARN("GPU culling mismatch: GPU=" + std::to_string(gpuVisible) + " CPU=" + std::to_string(cpuReference));
+            }
+        }
 
-        VkRect2D scissor{};
-        scissor.offset = {0, 0};
-        scissor.extent = swapchainExtent;
-        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+        if (sceneDirty) {
+            visibleObjects.resize(world.size());
+            std::iota(visibleObjects.begin(), visibleObjects.end(), 0u);
+
+            drawBatcher.build(world, visibleObjects, geometryPool.getMeshCount());
+            // Staging per slot: hanya realokasi (descriptor set dipakai bersama semua frame) yang perlu menunggu
+            if (!gpuCullingPass->fitsCapacity(drawBatcher)) waitForOtherFrames();
+            gpuCullingPass->uploadScene(drawBatcher, geometryPool);
+            sceneDirty = false;
+        } else if (!sceneChangedRows.empty()) {
+            // [NEW] Transform/color berubah: layout batch sama, upload hanya row instance yang berubah
+            drawBatcher.refreshInstances(world, sceneChangedRows, changedInstances);
+            gpuCullingPass->updateInstances(drawBatcher, changedInstances);
+        }
 
-        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, gBufferPipeline.getPipeline());
-        
-        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, 
-            gBufferPipeline.getPipelineLayout(), 0, 1, &descriptorSet, 0, nullptr);
-        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, 
-            gBufferPipeline.getPipelineLayout(), 1, 1, &textureDescriptorSet, 0, nullptr);
-
-
-        for (const auto& obj : gameObjects) {
-             // LOG_INFO("recordCommandBuffer: Drawing Object " + obj.name + " MeshID: " + std::to_string(obj.meshID));
-            ObjectPushConstant pc = obj.getPushConstant();  
-            vkCmdPushConstants(
-                commandBuffer, 
-                gBufferPipeline.getPipelineLayout(), 
-                VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 
-                0, 
-                sizeof(ObjectPushConstant), 
-                &pc
-            );
-
-            if (obj.meshID >= 0 && obj.meshID < meshes.size()) {
-                meshes[obj.meshID].draw(commandBuffer);
-            } else {
-                 LOG_ERROR("Invalid Mesh ID: " + std::to_string(obj.meshID));
-            }
+        if (validateGpuCulling) {
+            visibilitySystem->cull(world, visibleObjects);
+            cpuReferenceVisibleCount[currentFrame] = static_cast<uint32_t>(visibleObjects.size());
         }
 
-    vkCmdEndRenderPass(commandBuffer);
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "Culling");
+            gpuCullingPass->execute(commandBuffer, visibilitySystem->getFrustum(), viewProj, 0);
+        }
+        analyzer.registerIndirectDraws(gpuCullingPass->getLastDrawCount());
+        analyzer.setVisibleObjects(gpuCullingPass->getLastVisibleCount());
+    } else {
+        // CPU reference path: frustum cull -> batch per mesh -> upload InstanceData
+        visibilitySystem->cull(world, visibleObjects);
+        drawBatcher.build(world, visibleObjects, geometryPool.getMeshCount());
+        instanceBuffer->update(drawBatcher.getInstances(), currentFrame); // Hanya page yang berubah
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "InstanceUpload");
+            instanceBuffer->recordUpload(commandBuffer);
+        }
+        analyzer.setVisibleObjects(static_cast<uint32_t>(visibleObjects.size()));
+        if (visibilitySystem->isOcclusionEnabled()) {
+            analyzer.setOcclusionCulled(visibilitySystem->getOcclusionCulledFraction());
+        }
+    }
+    sceneChangedRows.clear(); // Sudah di-upload (GPU path); CPU path build ulang tiap frame
+
+    recordGBufferPass(commandBuffer, renderPassInfo, 0);
+
+    // [NEW] Two-phase occlusion: Hi-Z dari depth phase 0, lalu gambar object yang baru ter-disocclude
+    if (useGpuCulling && gpuCullingPass->isOcclusionEnabled()) {
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "HiZ");
+            hiZPass->execute(commandBuffer, gBuffer.getDepthImage());
+        }
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "Culling");
+            gpuCullingPass->execute(commandBuffer, visibilitySystem->getFrustum(), viewProj, 1);
+        }
+
+        VkRenderPassBeginInfo loadPassInfo = renderPassInfo;
+        loadPassInfo.renderPass = gBuffer.getLoadRenderPass();
+        loadPassInfo.clearValueCount = 0;
+        loadPassInfo.pClearValues = nullptr;
+
+        recordGBufferPass(commandBuffer, loadPassInfo, 1);
+    }
+
+    {
+        // [NEW] Bind count G-Buffer pass (semua phase, primary + secondary) untuk mengukur efek sort + state cache
+        Cogent::Renderer::CommandStateCache::Stats binds = stateCache.getStats();
+        for (const auto& cache : workerStateCaches) binds += cache.getStats();
+        analyzer.registerBinds(binds.pipelineBinds, binds.descriptorBinds, binds.bufferBinds, binds.skippedBinds);
+    }
 
     std::array<VkImageMemoryBarrier, 3> barriers{};
 
@@ -1007,10 +1645,11 @@ void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t i
         // Need to ensure Depth is readable. (Depth Attachment Store Op was STORE, Layout DEPTH_STENCIL_ATTACHMENT_OPTIMAL or similar)
         // Transition Depth to Shader Read Only if needed, or use Combined Image Sampler layout.
         
-        // Transition SSS Image to GENERAL for Compute Write
+        // [FIX] SSS image dipakai bersama semua frame in flight dan sudah GENERAL sejak dibuat.
+        // Tunggu frame sebelumnya selesai membaca (lighting fragment) / menulis (SSS compute) sebelum ditimpa.
         VkImageMemoryBarrier sssImageBarrier{};
         sssImageBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-        sssImageBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED; 
+        sssImageBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
         sssImageBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
         sssImageBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
         sssImageBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
@@ -1020,7 +1659,7 @@ void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t i
         sssImageBarrier.subresourceRange.levelCount = 1;
         sssImageBarrier.subresourceRange.baseArrayLayer = 0;
         sssImageBarrier.subresourceRange.layerCount = 1;
-        sssImageBarrier.srcAccessMask = 0;
+        sssImageBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
         sssImageBarrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
 
         // Ensure Depth is readable by SSS (Synchronize GBuffer Write -> Compute Read)
@@ -1046,7 +1685,8 @@ void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t i
 
         vkCmdPipelineBarrier(
             commandBuffer,
-            VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
             0,
             0, nullptr,
@@ -1057,7 +1697,10 @@ void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t i
         // Dispatch SSS:
         // Use a fixed light direction for now (e.g. from top-right-front)
         glm::vec4 lightDir = glm::vec4(normalize(glm::vec3(0.5f, -1.0f, 0.2f)), 0.0f);
-        screenSpaceShadows->execute(commandBuffer, mainCamera.getViewMatrix(), mainCamera.getProjectionMatrix(), lightDir);
+        {
+            GPU_PROFILE_SCOPE(commandBuffer, "ScreenSpaceShadows");
+            screenSpaceShadows->execute(commandBuffer, mainCamera.getViewMatrix(), mainCamera.getProjectionMatrix(), lightDir, cameraUniformOffset);
+        }
 
         // Memory Barrier: Ensure SSS Write finishes before Lighting Pass reads it? 
         // (If Lighting Pass reads shadow mask)
@@ -1076,6 +1719,8 @@ void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t i
         if (lightRenderPassInfo.renderPass == VK_NULL_HANDLE) LOG_ERROR("FATAL: Lighting RenderPass is NULL!");
         if (lightRenderPassInfo.framebuffer == VK_NULL_HANDLE) LOG_ERROR("FATAL: Lighting Framebuffer is NULL!");
 
+        static const Cogent::Diagnostics::ScopeID lightingScope = gpuProfiler.RegisterScope("Lighting");
+        gpuProfiler.BeginScope(commandBuffer, lightingScope);
         vkCmdBeginRenderPass(commandBuffer, &lightRenderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
 
         VkViewport viewportFullscreen{};
@@ -1103,17 +1748,23 @@ void CogentEngine::recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t i
         // Execute Lighting Pass (Fullscreen Quad)
         // Pass the Global UBO (Camera) descriptor set if needed, or scene descriptor.
         // The DeferredLightingPass::execute signature might need checking. 
-        // Checked header: void execute(VkCommandBuffer cmd, VkDescriptorSet sceneGlobalDescSet);
+        // Checked header: void execute(VkCommandBuffer cmd, VkDescriptorSet sceneGlobalDescSet, uint32_t cameraOffset);
         if (!deferredLightingPass) {
              LOG_ERROR("FATAL: deferredLightingPass is NULL!");
              throw std::runtime_error("deferredLightingPass is NULL");
         }
         
-        deferredLightingPass->execute(commandBuffer, descriptorSet); // descriptorSet is UBO set
+        deferredLightingPass->execute(commandBuffer, descriptorSet, cameraUniformOffset); // descriptorSet is UBO set
 
-        editorUI.Draw(commandBuffer);
+        if (!headless.enabled) editorUI.Draw(commandBuffer);
 
     vkCmdEndRenderPass(commandBuffer);
+    gpuProfiler.EndScope(commandBuffer); // Lighting (+ editor UI)
+
+    if (frameQueryPool != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frameQueryPool, currentFrame * 2 + 1);
+    }
+    gpuProfiler.EndFrame(commandBuffer);
 
     if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
         throw std::runtime_error("Failed to stop recording command buffer!");
@@ -4,13 +4,12 @@
 #include <GLFW/glfw3.h>
 
 // Library Matematika (GLM)
-#define GLM_FORCE_RADIANS
-#define GLM_FORCE_DEPTH_ZERO_TO_ONE
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <iostream>
 #include <vector>
+#include <string>
 #include <stdexcept>
 #include <memory>
 #include <optional>
@@ -23,6 +22,7 @@
 #include "../RayTracing/RayTracer.hpp"
 #include "../Renderer/GBuffer.hpp"
 #include "../Resources/Model.hpp"
+#include "../Resources/GeometryPool.hpp"
 #include "../Renderer/RenderPipeline.hpp"
 #include "../Core/Types.hpp"
 #include "../Core/VulkanUtils.hpp"
@@ -37,23 +37,74 @@
 #include "../Core/Memory/LinearAllocator.hpp"
 #include "../Renderer/Graph/RenderGraph.hpp"
 #include "../Renderer/Visibility/VisibilitySystem.hpp"
+#include "../Scene/World.hpp"
 #include "../Core/Threading/JobSystem.hpp"
+#include "../Core/Diagnostics/Profiler.hpp"
+#include "../Core/Diagnostics/GpuProfiler.hpp"
 #include "../Core/Graphics/GraphicsDevice.hpp"
 #include "../Renderer/DeferredLightingPass.hpp"
 #include "../Renderer/ScreenSpaceShadows.hpp"
+#include "../Renderer/InstanceBuffer.hpp"
+#include "../Renderer/UniformRing.hpp"
+#include "../Renderer/BindlessHeap.hpp"
+#include "../Renderer/DrawBatcher.hpp"
+#include "../Renderer/CommandStateCache.hpp"
+#include "../Renderer/SecondaryCommandRecorder.hpp"
+#include "../Renderer/Visibility/GpuCullingPass.hpp"
+#include "../Renderer/Visibility/HiZPass.hpp"
+#include "../Optimization/SceneAnalyzer.hpp"
+#include "../Optimization/OptimizerAI.hpp"
+#include "../Renderer/ShaderRegistry.hpp"
 
 // QueueFamilyIndices struct is defined in GraphicsDevice.hpp
 
+// [NEW] Mode headless: device tanpa surface, render ke image offscreen, scene + camera scripted
+// selama N frame dengan delta time tetap. Jalan di ICD software (lavapipe / SwiftShader) tanpa GPU.
+// Argumen: --headless [--frames N] [--timings file.csv] [--dump dir] [--dump-interval N]
+// Env: COGENT_HEADLESS=1, COGENT_HEADLESS_FRAMES, COGENT_HEADLESS_TIMINGS, COGENT_HEADLESS_DUMP, COGENT_HEADLESS_DUMP_INTERVAL
+struct HeadlessOptions {
+    bool enabled = false;
+    uint32_t frames = 300;
+    std::string timingsPath = "headless_timings.csv"; // CSV per frame (kosong = tidak ditulis)
+    std::string dumpDir;       // Kosong = tidak dump image
+    uint32_t dumpInterval = 0; // Dump tiap N frame; 0 = hanya frame terakhir
+
+    static HeadlessOptions parse(int argc, char** argv);
+};
+
+// [NEW] Timing satu frame. GPU = timestamp awal..akhir command buffer frame (0 kalau tidak tersedia)
+struct FrameTiming {
+    uint64_t frame = 0;
+    double frameMs = 0.0; // Wall time satu iterasi loop
+    double cpuMs = 0.0;   // frameMs tanpa waktu menunggu fence GPU
+    double gpuMs = 0.0;
+};
+
 class CogentEngine {
 public:
-    CogentEngine();
+    explicit CogentEngine(const HeadlessOptions& headless = {});
     void run();
 
+    const std::vector<FrameTiming>& getFrameTimings() const { return frameTimings; } // [NEW] Hasil run headless
+
+    static constexpr uint32_t MAX_FRAMES_IN_FLIGHT = 3;
+    static constexpr uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
+
 private:
+    // [NEW] Resource milik satu frame in flight
+    struct FrameData {
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkSemaphore imageAvailable = VK_NULL_HANDLE;
+        VkSemaphore renderFinished = VK_NULL_HANDLE;
+        VkFence inFlight = VK_NULL_HANDLE;
+    };
+
     void initWindow();
     void initVulkan();
     void initResources();
+    void createStartupPipelines(); // [NEW] Pass yang independen dibuat paralel di JobSystem
     void mainLoop();
+    void headlessLoop(); // [NEW] N frame scripted, tanpa window/present
     void cleanup();
     void drawFrame();
     void updateCamera();
@@ -61,20 +112,26 @@ private:
     // Core Vulkan Helpers
     void createSurface();
     void createDescriptorSetLayout();
-    void createCommandBuffer();
+    void createCommandBuffers();
     void createSyncObjects();
     void createSwapchain();
     void createSwapchainImageViews();
     void recreateSwapchain();
+    void createOffscreenTargets();  // [NEW] Headless: pengganti swapchain (satu image per frame in flight)
+    void destroyOffscreenTargets();
+    void createFrameTimestamps();   // [NEW] Query pool timestamp per slot frame
+    void collectFrameTimestamps(uint32_t slot); // Dipanggil setelah fence slot di-wait
+    void dumpOffscreenImage(uint32_t imageIndex, const std::string& path); // PPM (RGB 8-bit)
+    void writeFrameTimings(const std::string& path) const;
     
     bool isDeviceSuitable(VkPhysicalDevice device);
     // QueueFamilyIndices findQueueFamilies(VkPhysicalDevice device); // Removed, use GraphicsDevice::findQueueFamilies
     
     // Resource Helpers
-    void createUniformBuffer();
+    void createUniformBuffers();
     void createDescriptorPool();
     void createDescriptorSets();
-    void updateUniformBuffer();
+    void updateUniformBuffer(); // Isi cameraUBO (di-push ke UniformRing tiap frame)
     void createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory);
     
     // Texture Helpers
@@ -88,9 +145,17 @@ private:
     
     // Rendering Helpers
     void recordCommandBuffer(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+    void recordGBufferGeometry(VkCommandBuffer commandBuffer, uint32_t phase);
+    void waitForOtherFrames();
+    void recordGBufferPass(VkCommandBuffer commandBuffer, const VkRenderPassBeginInfo& passInfo, uint32_t phase);
+    void bindGBufferState(VkCommandBuffer commandBuffer, Cogent::Renderer::CommandStateCache& cache);
+    void recordGBufferBatches(VkCommandBuffer commandBuffer, Cogent::Renderer::CommandStateCache& cache,
+                              uint32_t beginBatch, uint32_t endBatch);
     
     // Game Logic Helpers
-    void spawnObject(int meshID, glm::vec3 position);
+    Cogent::Scene::Entity spawnObject(int meshID, glm::vec3 position);
+    void spawnBenchmarkScene(uint32_t count); // [NEW] Stress test instancing (N object via createObject)
+    Cogent::Scene::Entity createObject(int meshID, glm::vec3 position); // [NEW] Tambah row tanpa log/seleksi (bulk spawn)
     
     // Static Callbacks
     static void mouse_callback(GLFWwindow* window, double xposIn, double yposIn);
@@ -98,14 +163,15 @@ private:
 
     // --- Member Variables (Previously Globals) ---
     
-    GLFWwindow* window;
+    GLFWwindow* window = nullptr;
+    HeadlessOptions headless; // [NEW]
     
     // Subsystems
     GraphicsDevice graphicsDevice; // Main Graphics Device
 
     // Vulkan Handles (Legacy/Direct Access) - Consider removing if GraphicsDevice covers all
     VkInstance instance = VK_NULL_HANDLE;
-    VkSurfaceKHR surface;
+    VkSurfaceKHR surface = VK_NULL_HANDLE; // Tetap null kalau headless
     VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
     VkDevice device;
     VkQueue graphicsQueue;
@@ -113,11 +179,15 @@ private:
     VkQueue presentQueue;
     
     VkCommandPool commandPool;
-    VkCommandBuffer commandBuffer;
-    
-    VkSemaphore imageAvailableSemaphore;
-    VkSemaphore renderFinishedSemaphore;
-    VkFence inFlightFence;
+
+    // [NEW] Frames in flight: CPU merekam frame N+1 selagi GPU mengerjakan frame N.
+    // Semua resource yang ditulis CPU per frame punya satu salinan per slot, dan slot baru boleh
+    // disentuh lagi setelah inFlight fence-nya di-wait (frameNumber - framesInFlight sudah selesai).
+    std::vector<FrameData> frames;
+    uint32_t framesInFlight = DEFAULT_FRAMES_IN_FLIGHT; // COGENT_FRAMES_IN_FLIGHT=1..MAX_FRAMES_IN_FLIGHT
+    uint32_t currentFrame = 0;   // Slot di frames
+    uint64_t frameNumber = 0;    // Monotonic, naik setiap submit
+    std::vector<VkFence> imagesInFlight; // Fence frame yang terakhir memakai swapchain image ini
     
     VkSwapchainKHR swapchain;
     std::vector<VkImage> swapchainImages;
@@ -125,9 +195,19 @@ private:
     VkExtent2D swapchainExtent;
     std::vector<VkImageView> swapchainImageViews;
     std::vector<VkFramebuffer> swapchainFramebuffers;
+    std::vector<VkDeviceMemory> offscreenMemory; // [NEW] Headless: memory image pengganti swapchain
+
+    // [NEW] Timestamp awal/akhir command buffer per slot (2 query per slot)
+    VkQueryPool frameQueryPool = VK_NULL_HANDLE;
+    float timestampPeriod = 1.0f;                // ns per tick
+    std::vector<int64_t> frameQueryOwner;        // Slot -> index frameTimings yang menunggu hasil (-1 = kosong)
+    std::vector<FrameTiming> frameTimings;
+    double lastFenceWaitMs = 0.0;
+    uint32_t lastImageIndex = 0;
     
     // Rendering Subsystems
     GBuffer gBuffer;
+    Cogent::Resources::GeometryPool geometryPool; // [NEW] Mega VB/IB untuk semua mesh
     Model myModel;
     RenderPipeline gBufferPipeline;
     RayTracer rayTracer;
@@ -143,11 +223,13 @@ private:
     // Descriptors
     VkDescriptorSetLayout descriptorSetLayout;      // UBO Camera
     VkDescriptorPool descriptorPool;
-    VkDescriptorSet descriptorSet;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE; // [NEW] Satu set, UBO dynamic ke UniformRing
+    std::unique_ptr<Cogent::Renderer::UniformRing> uniformRing; // [NEW] Uniform per frame (camera, ray tracer, ...)
+    CameraUBO cameraUBO{};
+    uint32_t cameraUniformOffset = 0; // Dynamic offset slice camera frame ini
     
-    VkDescriptorSetLayout textureDescriptorLayout;  // Material Textures
-    VkDescriptorPool textureDescriptorPool;
-    VkDescriptorSet textureDescriptorSet;
+    std::unique_ptr<Cogent::Renderer::BindlessHeap> bindlessHeap; // [NEW] Set 1: semua texture material (descriptor indexing)
+    std::vector<uint32_t> materialTextures; // materialID -> index texture di bindlessHeap
     
     VkDescriptorSetLayout lightingDescriptorLayout; // G-Buffer Input
     VkDescriptorPool lightingDescriptorPool;
@@ -156,28 +238,42 @@ private:
     VkDescriptorPool imguiPool;
     VkDescriptorSet sceneDescriptorSet = VK_NULL_HANDLE;
     
-    // Uniform Buffers
-    VkBuffer uniformBuffer;
-    VkDeviceMemory uniformBufferMemory;
-    void* uniformBufferMapped;
-    
     // Systems
     std::unique_ptr<Cogent::Memory::LinearAllocator> frameAllocator;
     std::unique_ptr<RenderGraph> renderGraph; // Fixed namespace
     std::unique_ptr<Cogent::Renderer::VisibilitySystem> visibilitySystem;
     std::unique_ptr<Cogent::Resources::Streamer> streamer;
+    Cogent::Renderer::DrawBatcher drawBatcher;
+    std::unique_ptr<Cogent::Renderer::InstanceBuffer> instanceBuffer; // [NEW] Instance stream CPU path (ring per frame)
+    Cogent::Renderer::CommandStateCache stateCache; // [NEW] Skip bind redundant saat record G-Buffer
+    std::unique_ptr<Cogent::Renderer::SecondaryCommandRecorder> secondaryRecorder; // [NEW] Record G-Buffer paralel
+    std::vector<Cogent::Renderer::CommandStateCache> workerStateCaches;              // Satu per slot recorder
+    static constexpr uint32_t PARALLEL_RECORD_MIN_BATCHES = 256; // Draw per chunk minimum (di bawah ini inline lebih murah)
+    std::unique_ptr<Cogent::Renderer::GpuCullingPass> gpuCullingPass; // [NEW] GPU-driven culling + MDI
+    std::unique_ptr<Cogent::Renderer::HiZPass> hiZPass;               // [NEW] Depth pyramid untuk occlusion
+    Cogent::Optimization::OptimizerAI optimizer; // [NEW] Preset kualitas -> variant shader (specialization constant)
+    bool useGpuCulling = false;        // false = CPU reference path (VisibilitySystem + DrawBatcher)
+    bool validateGpuCulling = false;   // Bandingkan visible count GPU vs CPU (COGENT_VALIDATE_CULLING)
+    bool sceneDirty = true;            // Object ditambah: build batch + upload ulang object SSBO penuh
+    // [FIX] CPU reference per frame slot, dibandingkan dengan readback GPU slot yang sama
+    // (0 = belum direkam, cocok dengan readback yang di-zero saat dibuat)
+    uint32_t cpuReferenceVisibleCount[MAX_FRAMES_IN_FLIGHT] = {};
     
     // Scene Data
-    std::vector<GameObject> gameObjects;
-    std::vector<const GameObject*> visibleObjects; // Results from culling
+    Cogent::Scene::World world;              // [NEW] ECS scene storage (SoA per komponen)
+    std::vector<uint32_t> visibleObjects;    // Results from culling (row di world)
+    std::vector<uint32_t> transformChanges;  // [NEW] Row yang world matrix-nya berubah frame ini
+    std::vector<uint32_t> sceneChangedRows;  // [NEW] Row dengan transform/color baru sejak upload GPU culling terakhir
+    std::vector<uint32_t> changedInstances;  // Scratch: index instance dari sceneChangedRows
     // Camera mainCamera; // Removed private duplicate
     
     // Game State
     AppState currentState = AppState::LOADING;
     EditorUI editorUI;
     
-    std::vector<Model> meshes; 
     int selectedObjectIndex = -1;
+    int syncedSelectionIndex = -1; // [NEW] Index yang transform-nya sudah di-load ke selectedObject
+    glm::mat4 syncedSelectionModel{1.0f}; // [NEW] Matrix gizmo terakhir yang ditulis ke world
     ObjectPushConstant selectedObject{};
     
     // Input State
@@ -190,6 +286,7 @@ private:
     // Time
     float deltaTime = 0.0f;
     float lastFrame = 0.0f;
+    float simulationTime = 0.0f; // [NEW] Waktu scene (glfwGetTime, atau frame * dt tetap kalau headless)
     
     // Viewport
     glm::vec2 renderingViewportSize = {1920, 1080};
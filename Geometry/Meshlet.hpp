@@ -1,4 +1,5 @@
 #pragma once
+#include <cfloat>
 #include <vector>
 #include <vulkan/vulkan.h>
 #include <glm/glm.hpp>
@@ -17,6 +17,9 @@ namespace Cogent::Optimization {
         int shadowQuality = 2; // 0=Low, 1=Med, 2=High
         float lodBias = 0.0f;
         int taaSamples = 4;
+        // [NEW] Variant shader (specialization constant): dipilih saat pipeline dibuat, tanpa compile ulang
+        int rayBounces = 3;          // raytrace.comp MAX_BOUNCES
+        float temporalBlend = 0.90f; // ANSR.comp BLEND_WEIGHT
     };
 
     class OptimizerAI {
@@ -75,10 +78,13 @@ namespace Cogent::Optimization {
         void applyPreset(PerformanceMode m) {
             switch (m) {
                 case PerformanceMode::RAW: 
-                    currentSettings = {1.0f, 2, 0.0f, 8}; break;
+                    currentSettings = {1.0f, 2, 0.0f, 8, 4, 0.90f}; break;
                 case PerformanceMode::BALANCED: 
-                    currentSettings = {1.0f, 1, 0.0f, 4}; break;
-                // ...
+                    currentSettings = {1.0f, 1, 0.0f, 4, 3, 0.90f}; break;
+                case PerformanceMode::PERFORMANCE:
+                    currentSettings = {0.75f, 0, 0.5f, 2, 2, 0.85f}; break;
+                case PerformanceMode::LOW_POWER:
+                    currentSettings = {0.5f, 0, 1.0f, 1, 1, 0.80f}; break;
             }
         }
 
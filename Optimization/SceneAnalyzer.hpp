@@ -9,7 +9,13 @@ namespace Cogent::Optimization {
         uint32_t drawCalls = 0;
         uint32_t triangleCount = 0;
         uint32_t visibleObjects = 0;
+        float occlusionCulledFraction = 0.0f; // [NEW] Fraksi survivor frustum yang dibuang occlusion culling
         float gpuTime = 0.0f;   // ms
+        // [NEW] State change di command buffer G-Buffer (setelah sort key + state cache)
+        uint32_t pipelineBinds = 0;
+        uint32_t descriptorBinds = 0;
+        uint32_t bufferBinds = 0;
+        uint32_t skippedBinds = 0;
     };
 
     class SceneAnalyzer {
@@ -23,6 +29,11 @@ namespace Cogent::Optimization {
             stats.drawCalls = 0;
             stats.triangleCount = 0;
             stats.visibleObjects = 0;
+            stats.occlusionCulledFraction = 0.0f;
+            stats.pipelineBinds = 0;
+            stats.descriptorBinds = 0;
+            stats.bufferBinds = 0;
+            stats.skippedBinds = 0;
         }
 
         void registerDrawCall(uint32_t triCount) {
@@ -30,6 +41,18 @@ namespace Cogent::Optimization {
             stats.triangleCount += triCount;
         }
 
+        // GPU-driven path: jumlah draw diketahui dari counter GPU, triangle count tidak
+        void registerIndirectDraws(uint32_t drawCount) {
+            stats.drawCalls += drawCount;
+        }
+
+        void registerBinds(uint32_t pipeline, uint32_t descriptor, uint32_t buffer, uint32_t skipped) {
+            stats.pipelineBinds += pipeline;
+            stats.descriptorBinds += descriptor;
+            stats.bufferBinds += buffer;
+            stats.skippedBinds += skipped;
+        }
+
         void setFrameTime(float ms) {
             stats.frameTime = ms;
         }
@@ -38,6 +61,10 @@ namespace Cogent::Optimization {
             stats.visibleObjects = count;
         }
 
+        void setOcclusionCulled(float fraction) {
+            stats.occlusionCulledFraction = fraction;
+        }
+
         const EngineStats& getStats() const { return stats; }
 
     private:
@@ -1,32 +1,20 @@
 #include "RayTracer.hpp"
-#include <fstream>
 #include <vector>
 #include <cstring>
 #include <cmath> // [FIX] Required for sin/cos
 #include <stdexcept> // [FIX] Required for runtime_error
 #include <string> // [FIX] Required for std::string
 #include "../Core/VulkanUtils.hpp"
+#include "../Renderer/ShaderRegistry.hpp"
 
-// Utility to read file (duplicate logic from main/utils if not header-only)
-static std::vector<char> readFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("failed to open file: " + filename);
-    }
-    size_t fileSize = (size_t)file.tellg();
-    std::vector<char> buffer(fileSize);
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
-    return buffer;
-}
-
-void RayTracer::init(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue, VkExtent2D extent) {
+void RayTracer::init(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue, VkExtent2D extent,
+                     Cogent::Renderer::UniformRing& uniformRing, VkPipelineCache pipelineCache) {
     this->device = device;
+    this->pipelineCache = pipelineCache;
     this->extent = extent;
+    this->uniformRing = &uniformRing;
 
     createStorageImage(physicalDevice);
-    createUniformBuffer(physicalDevice);
     createSphereBuffer(physicalDevice, commandPool, queue); // Send Initial Scene Data
     createDescriptors();
     createPipeline();
@@ -43,9 +31,6 @@ void RayTracer::cleanup(VkDevice device) {
     vkFreeMemory(device, storageImageMemory, nullptr);
     vkDestroySampler(device, sampler, nullptr);
 
-    vkDestroyBuffer(device, uniformBuffer, nullptr);
-    vkFreeMemory(device, uniformBufferMemory, nullptr);
-    
     vkDestroyBuffer(device, sphereBuffer, nullptr);
     vkFreeMemory(device, sphereBufferMemory, nullptr);
 }
@@ -59,10 +44,8 @@ void RayTracer::render(VkCommandBuffer cmd, VkDescriptorSet targetImageDescripto
     ubo.lightPos = glm::vec4(5.0f * std::sin(time), 5.0f, 5.0f * std::cos(time), 1.0f);
     ubo.time = time;
     
-    void* data;
-    vkMapMemory(device, uniformBufferMemory, 0, sizeof(RayTracingUniform), 0, &data);
-    memcpy(data, &ubo, sizeof(RayTracingUniform));
-    vkUnmapMemory(device, uniformBufferMemory);
+    // [FIX] Slice baru di UniformRing (tanpa map/unmap, tidak menimpa UBO yang masih dibaca frame lain)
+    const uint32_t uboOffset = uniformRing->push(ubo);
 
     // 2. Transition Layout (To Write)
     VkImageMemoryBarrier barrier{};
@@ -80,12 +63,14 @@ void RayTracer::render(VkCommandBuffer cmd, VkDescriptorSet targetImageDescripto
     barrier.srcAccessMask = 0;
     barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
     
-    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 
+    // [FIX] storageImage dipakai bersama semua frame in flight: UNDEFINED boleh (isi ditimpa penuh),
+    // tapi transisinya harus menunggu fragment shader frame sebelumnya selesai membaca (WAR)
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 
                          0, 0, nullptr, 0, nullptr, 1, &barrier);
 
     // 3. Dispatch Compute
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
-    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 1, &uboOffset);
     
     vkCmdDispatch(cmd, extent.width / 16, extent.height / 16, 1);
 
@@ -170,21 +155,14 @@ void RayTracer::createStorageImage(VkPhysicalDevice physicalDevice) {
     }
 }
 
-void RayTracer::createUniformBuffer(VkPhysicalDevice physicalDevice) {
-    VkDeviceSize bufferSize = sizeof(RayTracingUniform);
-    createBuffer(physicalDevice, bufferSize, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, 
-                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, 
-                 uniformBuffer, uniformBufferMemory);
-}
-
 void RayTracer::createSphereBuffer(VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue) {
-    VkDeviceSize bufferSize = sizeof(Sphere) * 3; // 3 Spheres
-    
     // Initial Data
     std::vector<Sphere> spheres(3);
     spheres[0] = { {0.0f, 0.0f, 0.0f}, 1.0f, {1.0f, 0.0f, 0.0f}, 0.0f }; // Red Center
     spheres[1] = { {2.0f, 0.5f, 1.0f}, 0.5f, {0.0f, 1.0f, 0.0f}, 0.0f }; // Green Right
     spheres[2] = { {-2.0f, 0.5f, -1.0f}, 0.5f, {0.0f, 0.0f, 1.0f}, 0.0f }; // Blue Left
+    sphereCount = static_cast<uint32_t>(spheres.size());
+    VkDeviceSize bufferSize = sizeof(Sphere) * sphereCount;
 
     // Staging
     VkBuffer stagingBuffer;
@@ -228,7 +206,7 @@ void RayTracer::createDescriptors() {
     bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
     bindings[1].binding = 1;
-    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     bindings[1].descriptorCount = 1;
     bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
     
@@ -249,7 +227,7 @@ void RayTracer::createDescriptors() {
     VkDescriptorPoolSize poolSizes[3] = {};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
     poolSizes[0].descriptorCount = 1;
-    poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSizes[1].descriptorCount = 1;
     poolSizes[2].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
     poolSizes[2].descriptorCount = 1;
@@ -279,8 +257,8 @@ void RayTracer::createDescriptors() {
     imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
 
     VkDescriptorBufferInfo bufferInfo{};
-    bufferInfo.buffer = uniformBuffer;
-    bufferInfo.offset = 0;
+    bufferInfo.buffer = uniformRing->getBuffer();
+    bufferInfo.offset = 0; // + dynamic offset saat bind
     bufferInfo.range = sizeof(RayTracingUniform);
     
     VkDescriptorBufferInfo sphereInfo{};
@@ -300,7 +278,7 @@ void RayTracer::createDescriptors() {
     descriptorWrites[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     descriptorWrites[1].dstSet = descriptorSet;
     descriptorWrites[1].dstBinding = 1;
-    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptorWrites[1].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptorWrites[1].descriptorCount = 1;
     descriptorWrites[1].pBufferInfo = &bufferInfo;
     
@@ -315,31 +293,21 @@ void RayTracer::createDescriptors() {
 }
 
 void RayTracer::createPipeline() {
-    auto computeShaderCode = readFile("Shaders/raytrace.comp.spv");
-
-    VkShaderModule computeShaderModule;
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = computeShaderCode.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(computeShaderCode.data());
-
-    if (vkCreateShaderModule(device, &createInfo, nullptr, &computeShaderModule) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create shader module!");
-    }
-
-    VkPipelineShaderStageCreateInfo shaderStageInfo{};
-    shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    shaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-    shaderStageInfo.module = computeShaderModule;
-    shaderStageInfo.pName = "main";
-
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 1;
-    pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
-
-    if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
-        throw std::runtime_error("failed to create pipeline layout!");
+    // [MODIFIED] Module dari ShaderRegistry; jumlah sphere + bounce jadi konstanta compile-time pipeline
+    Cogent::Renderer::SpecializationConstants specialization;
+    specialization.set(0, static_cast<int32_t>(sphereCount)).set(1, static_cast<int32_t>(maxBounces));
+    VkPipelineShaderStageCreateInfo shaderStageInfo =
+        Cogent::Renderer::ShaderRegistry::Get().stage(VK_SHADER_STAGE_COMPUTE_BIT, "Shaders/raytrace.comp.spv", specialization.get());
+
+    if (pipelineLayout == VK_NULL_HANDLE) {
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+
+        if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create pipeline layout!");
+        }
     }
 
     VkComputePipelineCreateInfo pipelineInfo{};
@@ -347,11 +315,20 @@ void RayTracer::createPipeline() {
     pipelineInfo.layout = pipelineLayout;
     pipelineInfo.stage = shaderStageInfo;
 
-    if (vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    if (vkCreateComputePipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("failed to create compute pipeline!");
     }
+}
+
+void RayTracer::setMaxBounces(uint32_t bounces) {
+    if (bounces == 0 || bounces == maxBounces) return;
+    maxBounces = bounces;
+    if (pipeline == VK_NULL_HANDLE) return; // Dipakai saat init
 
-    vkDestroyShaderModule(device, computeShaderModule, nullptr);
+    // RayTracer tidak pegang GraphicsDevice (DeletionQueue): ganti variant jarang, cukup tunggu idle
+    vkDeviceWaitIdle(device);
+    vkDestroyPipeline(device, pipeline, nullptr);
+    createPipeline();
 }
 
 void RayTracer::createBuffer(VkPhysicalDevice physDevice, VkDeviceSize size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, VkBuffer& buffer, VkDeviceMemory& bufferMemory) {
@@ -6,6 +6,7 @@
 #include <glm/glm.hpp>
 #include "../Core/Types.hpp"
 #include "../Core/Camera.hpp"
+#include "../Renderer/UniformRing.hpp"
 
 // Struktur data yang dikirim ke Compute Shader
 struct RayTracingUniform {
@@ -26,16 +27,24 @@ struct Sphere {
 
 class RayTracer {
 public:
-    void init(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue, VkExtent2D extent);
+    // [MODIFIED] UBO per frame dialokasi dari UniformRing (binding 1 = dynamic)
+    void init(VkDevice device, VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue, VkExtent2D extent,
+              Cogent::Renderer::UniformRing& uniformRing, VkPipelineCache pipelineCache = VK_NULL_HANDLE);
     void cleanup(VkDevice device);
     void render(VkCommandBuffer cmd, VkDescriptorSet targetImageDescriptor, Camera& camera, float time);
     
     VkDescriptorSet getOutputDescriptorSet() { return descriptorSet; }
 
+    // [NEW] Jumlah bounce = specialization constant 1 di raytrace.comp (loop bisa di-unroll driver).
+    // Sebelum init: hanya disimpan. Sesudah init: pipeline dibuat ulang (tunggu device idle).
+    void setMaxBounces(uint32_t bounces);
+    uint32_t getMaxBounces() const { return maxBounces; }
+
 private:
    
     VkDevice device;
     VkExtent2D extent;
+    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
     
     VkPipeline pipeline = VK_NULL_HANDLE;
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
@@ -49,14 +58,14 @@ private:
     VkImageView storageImageView;
     VkSampler sampler;
 
-    VkBuffer uniformBuffer;
-    VkDeviceMemory uniformBufferMemory;
+    Cogent::Renderer::UniformRing* uniformRing = nullptr;
 
     VkBuffer sphereBuffer;
     VkDeviceMemory sphereBufferMemory;
+    uint32_t sphereCount = 0;  // Specialization constant 0 (harus sama dengan isi sphereBuffer)
+    uint32_t maxBounces = 3;
 
     void createStorageImage(VkPhysicalDevice physicalDevice);
-    void createUniformBuffer(VkPhysicalDevice physicalDevice);
     void createSphereBuffer(VkPhysicalDevice physicalDevice, VkCommandPool commandPool, VkQueue queue);
     void createDescriptors();
     void createPipeline();
@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <array>
 #include "../../Core/VulkanUtils.hpp"
+#include "../ShaderRegistry.hpp"
 #include "../../Core/Logger.hpp"
 
 namespace Cogent::Renderer {
@@ -142,23 +143,20 @@ namespace Cogent::Renderer {
     }
 
     void ANSRPass::createPipeline() {
-        auto computeShaderCode = VulkanUtils::readFile("Shaders/ANSR.comp.spv");
-
-        VkShaderModule computeShaderModule = VulkanUtils::createShaderModule(device.getDevice(), computeShaderCode);
-
-        VkPipelineShaderStageCreateInfo computeShaderStageInfo{};
-        computeShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        computeShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-        computeShaderStageInfo.module = computeShaderModule;
-        computeShaderStageInfo.pName = "main";
-
-        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-        pipelineLayoutInfo.setLayoutCount = 1;
-        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
-
-        if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
-            throw std::runtime_error("Failed to create ANSR Pipeline Layout!");
+        SpecializationConstants specialization;
+        specialization.set(0, blendWeight);
+        VkPipelineShaderStageCreateInfo computeShaderStageInfo =
+            ShaderRegistry::Get().stage(VK_SHADER_STAGE_COMPUTE_BIT, "Shaders/ANSR.comp.spv", specialization.get());
+
+        if (pipelineLayout == VK_NULL_HANDLE) {
+            VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+            pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+            pipelineLayoutInfo.setLayoutCount = 1;
+            pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+
+            if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create ANSR Pipeline Layout!");
+            }
         }
 
         VkComputePipelineCreateInfo pipelineInfo{};
@@ -166,11 +164,18 @@ namespace Cogent::Renderer {
         pipelineInfo.layout = pipelineLayout;
         pipelineInfo.stage = computeShaderStageInfo;
 
-        if (vkCreateComputePipelines(device.getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+        if (vkCreateComputePipelines(device.getDevice(), device.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create ANSR Compute Pipeline!");
         }
+    }
+
+    void ANSRPass::setBlendWeight(float weight) {
+        if (weight == blendWeight) return;
+        blendWeight = weight;
 
-        vkDestroyShaderModule(device.getDevice(), computeShaderModule, nullptr);
+        VkPipeline oldPipeline = pipeline;
+        device.getDeletionQueue().push([oldPipeline](VkDevice dev) { vkDestroyPipeline(dev, oldPipeline, nullptr); });
+        createPipeline();
     }
 
     void ANSRPass::updateDescriptorSets(VkImageView inputColor, VkImageView inputMotion, VkImageView inputDepth) {
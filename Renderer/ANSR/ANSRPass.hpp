@@ -21,6 +21,11 @@ namespace Cogent::Renderer {
         VkImage getOutputImage() const { return displayImage; }
         VkImageView getOutputView() const { return displayView; }
 
+        // [NEW] Bobot history temporal (specialization constant 0 di ANSR.comp). Pipeline dibuat
+        // ulang dari module yang sama; pipeline lama di-destroy lewat DeletionQueue.
+        void setBlendWeight(float weight);
+        float getBlendWeight() const { return blendWeight; }
+
     private:
         void createResources();
         void createPipeline();
@@ -42,12 +47,13 @@ namespace Cogent::Renderer {
         VkImageView historyView;
 
         // Pipeline
-        VkPipeline pipeline;
-        VkPipelineLayout pipelineLayout;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
         VkDescriptorSetLayout descriptorSetLayout;
         VkDescriptorPool descriptorPool;
         VkDescriptorSet descriptorSet;
 
         bool firstFrame = true;
+        float blendWeight = 0.90f; // 90% History, 10% New
     };
 }
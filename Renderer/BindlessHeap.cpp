@@ -0,0 +1,134 @@
+#include "BindlessHeap.hpp"
+#include "../Core/Logger.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace Cogent::Renderer {
+
+    BindlessHeap::BindlessHeap(GraphicsDevice& device) : device(device) {
+        if (!device.supportsBindless()) {
+            throw std::runtime_error("BindlessHeap: GPU tidak mendukung descriptor indexing!");
+        }
+
+        // Kapasitas dibatasi limit update-after-bind device
+        VkPhysicalDeviceDescriptorIndexingProperties indexingProps{};
+        indexingProps.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+        VkPhysicalDeviceProperties2 props{};
+        props.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        props.pNext = &indexingProps;
+        vkGetPhysicalDeviceProperties2(device.getPhysicalDevice(), &props);
+
+        capacity = std::min({ MAX_TEXTURES, indexingProps.maxDescriptorSetUpdateAfterBindSampledImages,
+                              indexingProps.maxPerStageDescriptorUpdateAfterBindSampledImages });
+
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = 0;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        binding.descriptorCount = capacity;
+        binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        const VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo flagsInfo{};
+        flagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        flagsInfo.bindingCount = 1;
+        flagsInfo.pBindingFlags = &bindingFlags;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext = &flagsInfo;
+        layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &binding;
+
+        if (vkCreateDescriptorSetLayout(device.getDevice(), &layoutInfo, nullptr, &layout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Bindless Descriptor Set Layout!");
+        }
+
+        VkDescriptorPoolSize poolSize{};
+        poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSize.descriptorCount = capacity;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+
+        if (vkCreateDescriptorPool(device.getDevice(), &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Bindless Descriptor Pool!");
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = pool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &layout;
+
+        if (vkAllocateDescriptorSets(device.getDevice(), &allocInfo, &descriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate Bindless Descriptor Set!");
+        }
+
+        LOG_INFO("BindlessHeap: " + std::to_string(capacity) + " textures");
+    }
+
+    BindlessHeap::~BindlessHeap() {
+        vkDestroyDescriptorPool(device.getDevice(), pool, nullptr); // Ikut free set
+        vkDestroyDescriptorSetLayout(device.getDevice(), layout, nullptr);
+    }
+
+    uint32_t BindlessHeap::registerTexture(VkImageView view, VkSampler sampler, VkImageLayout imageLayout) {
+        uint32_t index;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!freeList.empty()) {
+                index = freeList.back();
+                freeList.pop_back();
+            } else if (next < capacity) {
+                index = next++;
+            } else {
+                throw std::runtime_error("BindlessHeap: table texture penuh (" + std::to_string(capacity) + ")");
+            }
+        }
+        updateTexture(index, view, sampler, imageLayout);
+        return index;
+    }
+
+    void BindlessHeap::updateTexture(uint32_t index, VkImageView view, VkSampler sampler, VkImageLayout imageLayout) {
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.imageLayout = imageLayout;
+        imageInfo.imageView = view;
+        imageInfo.sampler = sampler;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = 0;
+        write.dstArrayElement = index;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.descriptorCount = 1;
+        write.pImageInfo = &imageInfo;
+
+        // UPDATE_AFTER_BIND: slot berbeda boleh ditulis bersamaan, tapi vkUpdateDescriptorSets ke set yang sama tetap di-serialize
+        std::lock_guard<std::mutex> lock(mutex);
+        vkUpdateDescriptorSets(device.getDevice(), 1, &write, 0, nullptr);
+    }
+
+    void BindlessHeap::release(uint32_t index) {
+        if (index == INVALID_INDEX) return;
+        // Slot masih bisa dibaca frame in flight: kembalikan ke free list setelah frame ini retire
+        device.getDeletionQueue().push([this, index](VkDevice) { recycle(index); });
+    }
+
+    void BindlessHeap::recycle(uint32_t index) {
+        if (index == INVALID_INDEX) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        freeList.push_back(index);
+    }
+
+    uint32_t BindlessHeap::getUsed() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return next - static_cast<uint32_t>(freeList.size());
+    }
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include "../Core/Graphics/GraphicsDevice.hpp"
+
+namespace Cogent::Renderer {
+
+    // [NEW] Descriptor heap global (descriptor indexing / "bindless") untuk texture material.
+    // Satu set, binding 0 = array besar combined image sampler. Texture mendapat index stabil saat
+    // register; gbuffer.frag meng-index lewat InstanceData::materialIndex, jadi set cukup di-bind
+    // sekali per pass. Pass compute (SSS, Hi-Z, culling) tetap memakai set masing-masing.
+    // Set dibuat UPDATE_AFTER_BIND + PARTIALLY_BOUND: slot boleh ditulis selagi set dipakai frame
+    // lain, dan slot kosong tidak perlu valid selama tidak diakses.
+    class BindlessHeap {
+    public:
+        static constexpr uint32_t MAX_TEXTURES = 4096;
+        static constexpr uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+        explicit BindlessHeap(GraphicsDevice& device);
+        ~BindlessHeap();
+
+        uint32_t registerTexture(VkImageView view, VkSampler sampler,
+                                 VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        // Ganti isi slot (mis. texture streaming naik mip) tanpa mengubah index
+        void updateTexture(uint32_t index, VkImageView view, VkSampler sampler,
+                           VkImageLayout layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+        // Index baru bisa dipakai ulang setelah frame yang mungkin masih membacanya retire (DeletionQueue)
+        void release(uint32_t index);
+        // Kembalikan slot ke free list sekarang. Hanya dari deleter DeletionQueue yang sudah retire
+        // (mis. Texture::unload melepas image dan slot dalam satu entry).
+        void recycle(uint32_t index);
+
+        VkDescriptorSetLayout getLayout() const { return layout; }
+        VkDescriptorSet getDescriptorSet() const { return descriptorSet; }
+        uint32_t getCapacity() const { return capacity; }
+        uint32_t getUsed() const;
+
+    private:
+        GraphicsDevice& device;
+        VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+        VkDescriptorPool pool = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+        mutable std::mutex mutex; // Register bisa dari thread streaming
+        uint32_t capacity = 0;
+        uint32_t next = 0;              // Slot belum pernah dipakai berikutnya
+        std::vector<uint32_t> freeList; // Slot hasil release yang sudah retire
+    };
+}
@@ -0,0 +1,112 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <array>
+#include <cstdint>
+
+namespace Cogent::Renderer {
+
+    // [NEW] Shadow state command buffer: bind yang sama dengan state terakhir di-skip.
+    // Berlaku per render pass (reset() di awal), semua bind graphics harus lewat sini supaya cache valid.
+    class CommandStateCache {
+    public:
+        static constexpr uint32_t MAX_DESCRIPTOR_SETS = 4;
+        static constexpr uint32_t MAX_VERTEX_BINDINGS = 4;
+        static constexpr uint32_t NO_DYNAMIC_OFFSET = 0xFFFFFFFFu;
+
+        struct Stats {
+            uint32_t pipelineBinds = 0;
+            uint32_t descriptorBinds = 0;
+            uint32_t bufferBinds = 0;  // Vertex + index
+            uint32_t skippedBinds = 0; // Bind redundant yang tidak di-record
+
+            Stats& operator+=(const Stats& other) {
+                pipelineBinds += other.pipelineBinds;
+                descriptorBinds += other.descriptorBinds;
+                bufferBinds += other.bufferBinds;
+                skippedBinds += other.skippedBinds;
+                return *this;
+            }
+        };
+
+        void reset(VkCommandBuffer commandBuffer) {
+            cmd = commandBuffer;
+            pipeline = VK_NULL_HANDLE;
+            layout = VK_NULL_HANDLE;
+            descriptorSets.fill(VK_NULL_HANDLE);
+            vertexBuffers.fill(VK_NULL_HANDLE);
+            vertexOffsets.fill(0);
+            indexBuffer = VK_NULL_HANDLE;
+            indexOffset = 0;
+        }
+
+        void bindPipeline(VkPipeline newPipeline) {
+            if (newPipeline == pipeline) { stats.skippedBinds++; return; }
+            vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, newPipeline);
+            pipeline = newPipeline;
+            stats.pipelineBinds++;
+        }
+
+        void bindDescriptorSet(VkPipelineLayout pipelineLayout, uint32_t setIndex, VkDescriptorSet set) {
+            bindDescriptorSet(pipelineLayout, setIndex, set, NO_DYNAMIC_OFFSET);
+        }
+
+        // [NEW] Set dengan satu binding dynamic (UniformRing): offset beda = bind ulang walau set sama
+        void bindDescriptorSet(VkPipelineLayout pipelineLayout, uint32_t setIndex, VkDescriptorSet set, uint32_t dynamicOffset) {
+            // Layout beda = set lama tidak dijamin kompatibel, anggap semua set invalid
+            if (pipelineLayout != layout) {
+                descriptorSets.fill(VK_NULL_HANDLE);
+                layout = pipelineLayout;
+            }
+            if (setIndex < MAX_DESCRIPTOR_SETS && descriptorSets[setIndex] == set && dynamicOffsets[setIndex] == dynamicOffset) {
+                stats.skippedBinds++;
+                return;
+            }
+            const uint32_t offsetCount = (dynamicOffset == NO_DYNAMIC_OFFSET) ? 0 : 1;
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, setIndex, 1, &set, offsetCount, &dynamicOffset);
+            if (setIndex < MAX_DESCRIPTOR_SETS) {
+                descriptorSets[setIndex] = set;
+                dynamicOffsets[setIndex] = dynamicOffset;
+            }
+            stats.descriptorBinds++;
+        }
+
+        void bindVertexBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset = 0) {
+            if (binding < MAX_VERTEX_BINDINGS && vertexBuffers[binding] == buffer && vertexOffsets[binding] == offset) {
+                stats.skippedBinds++;
+                return;
+            }
+            vkCmdBindVertexBuffers(cmd, binding, 1, &buffer, &offset);
+            if (binding < MAX_VERTEX_BINDINGS) {
+                vertexBuffers[binding] = buffer;
+                vertexOffsets[binding] = offset;
+            }
+            stats.bufferBinds++;
+        }
+
+        void bindIndexBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkIndexType type = VK_INDEX_TYPE_UINT32) {
+            if (buffer == indexBuffer && offset == indexOffset) { stats.skippedBinds++; return; }
+            vkCmdBindIndexBuffer(cmd, buffer, offset, type);
+            indexBuffer = buffer;
+            indexOffset = offset;
+            stats.bufferBinds++;
+        }
+
+        // Bind dilakukan di luar cache (mis. pass lain) -> state GPU tidak diketahui lagi
+        void invalidate() { reset(cmd); }
+
+        const Stats& getStats() const { return stats; }
+        void resetStats() { stats = Stats{}; }
+
+    private:
+        VkCommandBuffer cmd = VK_NULL_HANDLE;
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout layout = VK_NULL_HANDLE;
+        std::array<VkDescriptorSet, MAX_DESCRIPTOR_SETS> descriptorSets{};
+        std::array<uint32_t, MAX_DESCRIPTOR_SETS> dynamicOffsets{};
+        std::array<VkBuffer, MAX_VERTEX_BINDINGS> vertexBuffers{};
+        std::array<VkDeviceSize, MAX_VERTEX_BINDINGS> vertexOffsets{};
+        VkBuffer indexBuffer = VK_NULL_HANDLE;
+        VkDeviceSize indexOffset = 0;
+        Stats stats;
+    };
+}
@@ -1,6 +1,7 @@
 #include "DeferredLightingPass.hpp"
 #include "../Core/VulkanUtils.hpp"
 #include "../Core/Logger.hpp"
+#include "ShaderRegistry.hpp"
 #include <array>
 
 DeferredLightingPass::DeferredLightingPass(GraphicsDevice& device, VkRenderPass renderPass, VkExtent2D extent)
@@ -134,25 +135,11 @@ void DeferredLightingPass::updateDescriptorSets(const GBuffer& gbuffer) {
 }
 
 void DeferredLightingPass::createPipeline(VkRenderPass renderPass) {
-    auto vertCode = VulkanUtils::readFile("Shaders/lighting.vert.spv");
-    auto fragCode = VulkanUtils::readFile("Shaders/lighting.frag.spv");
-
-    VkShaderModule vertModule = VulkanUtils::createShaderModule(device.getDevice(), vertCode);
-    VkShaderModule fragModule = VulkanUtils::createShaderModule(device.getDevice(), fragCode);
-
-    VkPipelineShaderStageCreateInfo vertStageInfo{};
-    vertStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-    vertStageInfo.module = vertModule;
-    vertStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo fragStageInfo{};
-    fragStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragStageInfo.module = fragModule;
-    fragStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo shaderStages[] = { vertStageInfo, fragStageInfo };
+    auto& shaders = Cogent::Renderer::ShaderRegistry::Get();
+    VkPipelineShaderStageCreateInfo shaderStages[] = {
+        shaders.stage(VK_SHADER_STAGE_VERTEX_BIT, "Shaders/lighting.vert.spv"),
+        shaders.stage(VK_SHADER_STAGE_FRAGMENT_BIT, "Shaders/lighting.frag.spv")
+    };
 
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
@@ -234,18 +221,15 @@ void DeferredLightingPass::createPipeline(VkRenderPass renderPass) {
     pipelineInfo.subpass = 0;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-    if (vkCreateGraphicsPipelines(device.getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(device.getDevice(), device.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create Lighting Pipeline!");
     }
-
-    vkDestroyShaderModule(device.getDevice(), fragModule, nullptr);
-    vkDestroyShaderModule(device.getDevice(), vertModule, nullptr);
 }
 
-void DeferredLightingPass::execute(VkCommandBuffer cmd, VkDescriptorSet sceneGlobalDescSet) {
+void DeferredLightingPass::execute(VkCommandBuffer cmd, VkDescriptorSet sceneGlobalDescSet, uint32_t cameraOffset) {
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
     
-    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &sceneGlobalDescSet, 0, nullptr);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &sceneGlobalDescSet, 1, &cameraOffset);
     vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 1, 1, &descriptorSet, 0, nullptr);
     
     vkCmdDraw(cmd, 3, 1, 0, 0); 
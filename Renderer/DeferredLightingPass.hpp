@@ -16,7 +16,7 @@ public:
     // Updates descriptors with G-Buffer views
     void updateDescriptorSets(const GBuffer& gbuffer);
 
-    void execute(VkCommandBuffer cmd, VkDescriptorSet sceneGlobalDescSet);
+    void execute(VkCommandBuffer cmd, VkDescriptorSet sceneGlobalDescSet, uint32_t cameraOffset); // cameraOffset = dynamic offset UniformRing
 
 private:
     void createDescriptorSetLayout();
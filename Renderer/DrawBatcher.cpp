@@ -0,0 +1,131 @@
+#include "DrawBatcher.hpp"
+#include "../Core/Threading/JobSystem.hpp"
+#include "../Core/Diagnostics/Profiler.hpp"
+#include <algorithm>
+
+namespace Cogent::Renderer {
+
+    namespace {
+        constexpr uint64_t INVALID_KEY = ~0ull;
+        constexpr uint32_t GATHER_CHUNK = Scene::World::CHUNK_SIZE;
+    }
+
+    void DrawBatcher::radixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch) {
+        const size_t count = entries.size();
+        if (count < 2) return;
+        scratch.resize(count);
+
+        // Histogram 8 digit dalam satu pass baca
+        uint32_t histograms[8][256] = {};
+        for (const SortEntry& entry : entries) {
+            for (uint32_t digit = 0; digit < 8; digit++) {
+                histograms[digit][(entry.key >> (digit * 8)) & 0xFF]++;
+            }
+        }
+
+        SortEntry* src = entries.data();
+        SortEntry* dst = scratch.data();
+        for (uint32_t digit = 0; digit < 8; digit++) {
+            const uint32_t shift = digit * 8;
+            uint32_t* histogram = histograms[digit];
+            if (histogram[(src[0].key >> shift) & 0xFF] == count) continue; // Semua key sama di digit ini
+
+            uint32_t offset = 0;
+            for (uint32_t bucket = 0; bucket < 256; bucket++) {
+                const uint32_t size = histogram[bucket];
+                histogram[bucket] = offset;
+                offset += size;
+            }
+            for (size_t i = 0; i < count; i++) {
+                dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+            }
+            std::swap(src, dst);
+        }
+        if (src != entries.data()) std::copy(src, src + count, entries.data());
+    }
+
+    void DrawBatcher::build(const Scene::World& world, const std::vector<uint32_t>& rows, uint32_t meshCount) {
+        PROFILE_FUNCTION();
+        batches.clear();
+
+        const auto& meshes = world.meshes();
+        const uint32_t count = static_cast<uint32_t>(rows.size());
+        const uint32_t chunks = (count + GATHER_CHUNK - 1) / GATHER_CHUNK;
+        auto& jobs = Threading::JobSystem::Get();
+
+        // 1. Key per row (paralel per chunk). Mesh invalid -> key maksimum, terbuang setelah sort.
+        sortEntries.resize(count);
+        jobs.Dispatch(chunks, 1, [&](uint32_t chunk) {
+            const uint32_t end = std::min(count, (chunk + 1) * GATHER_CHUNK);
+            for (uint32_t i = chunk * GATHER_CHUNK; i < end; i++) {
+                const uint32_t row = rows[i];
+                const Scene::MeshRenderer& mesh = meshes[row];
+                const bool valid = mesh.meshID >= 0 && static_cast<uint32_t>(mesh.meshID) < meshCount;
+
+                // Order = row: urutan di batch tidak tergantung urutan hasil cull (BVH) maupun kamera
+                sortEntries[i].key = valid ? DrawKey::encode(0, static_cast<uint32_t>(mesh.pipelineID), static_cast<uint32_t>(mesh.materialID),
+                                                             static_cast<uint32_t>(mesh.meshID), row)
+                                           : INVALID_KEY;
+                sortEntries[i].row = row;
+            }
+        });
+
+        radixSort(sortEntries, sortScratch);
+        while (!sortEntries.empty() && sortEntries.back().key == INVALID_KEY) sortEntries.pop_back();
+
+        // 2. Batch boundary = state (key tanpa order) berubah (serial, cuma baca key)
+        const uint32_t instanceCount = static_cast<uint32_t>(sortEntries.size());
+        instanceBatch.resize(instanceCount);
+        for (uint32_t i = 0; i < instanceCount; i++) {
+            const uint64_t state = sortEntries[i].key & DrawKey::STATE_MASK;
+            if (batches.empty() || batches.back().sortKey != state) {
+                DrawBatch batch;
+                batch.sortKey = state;
+                batch.pipelineID = DrawKey::pipeline(state);
+                batch.materialID = DrawKey::material(state);
+                batch.meshID = DrawKey::mesh(state);
+                batch.firstInstance = i;
+                batches.push_back(batch);
+            }
+            batches.back().instanceCount++;
+            instanceBatch[i] = static_cast<uint32_t>(batches.size() - 1);
+        }
+
+        rowInstance.assign(world.size(), ~0u);
+        for (uint32_t i = 0; i < instanceCount; i++) rowInstance[sortEntries[i].row] = i;
+
+        // 3. Gather InstanceData dari kolom transform/color (paralel, tiap instance slot sendiri)
+        const auto& transforms = world.transforms();
+        const auto& colors = world.colors();
+        const uint32_t materialCount = static_cast<uint32_t>(materialTable.size());
+        instances.resize(instanceCount);
+        const uint32_t instanceChunks = (instanceCount + GATHER_CHUNK - 1) / GATHER_CHUNK;
+        jobs.Dispatch(instanceChunks, 1, [&](uint32_t chunk) {
+            const uint32_t end = std::min(instanceCount, (chunk + 1) * GATHER_CHUNK);
+            for (uint32_t i = chunk * GATHER_CHUNK; i < end; i++) {
+                const uint32_t row = sortEntries[i].row;
+                InstanceData& data = instances[i];
+                data.model = transforms[row];
+                data.color = colors[row];
+                data.id = static_cast<int>(world.entityAt(row).index); // Picking ID = handle stabil
+                data.batchID = static_cast<int>(instanceBatch[i]);
+                const uint32_t materialID = static_cast<uint32_t>(meshes[row].materialID);
+                data.materialIndex = materialCount == 0 ? 0
+                                   : static_cast<int>(materialTable[materialID < materialCount ? materialID : 0]);
+            }
+        });
+    }
+
+    void DrawBatcher::refreshInstances(const Scene::World& world, const std::vector<uint32_t>& rows, std::vector<uint32_t>& outInstances) {
+        outInstances.clear();
+        const auto& transforms = world.transforms();
+        const auto& colors = world.colors();
+        for (uint32_t row : rows) {
+            if (row >= rowInstance.size() || rowInstance[row] == ~0u) continue;
+            const uint32_t instance = rowInstance[row];
+            instances[instance].model = transforms[row];
+            instances[instance].color = colors[row];
+            outInstances.push_back(instance);
+        }
+    }
+}
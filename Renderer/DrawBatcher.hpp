@@ -0,0 +1,58 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "../Core/Types.hpp"
+#include "../Scene/World.hpp"
+#include "InstanceBuffer.hpp"
+#include "DrawKey.hpp"
+
+namespace Cogent::Renderer {
+
+    // Satu instanced draw: semua object dengan (pass, pipeline, material, mesh) yang sama
+    struct DrawBatch {
+        uint64_t sortKey = 0;       // DrawKey tanpa order
+        uint32_t pipelineID = 0;
+        uint32_t materialID = 0;
+        uint32_t meshID = 0;
+        uint32_t firstInstance = 0; // Offset di instance buffer
+        uint32_t instanceCount = 0;
+    };
+
+    // [NEW] Batching stage: group visible objects per pipeline + mesh,
+    // tulis InstanceData secara berurutan supaya tiap batch = range kontigu.
+    // Key dan InstanceData di-gather dari kolom Scene::World per chunk secara paralel.
+    class DrawBatcher {
+    public:
+        // [MODIFIED] Instance di dalam batch urut row ECS, bukan depth: gerak kamera saja tidak mengubah
+        // urutan, jadi diff per page di InstanceBuffer tidak meng-upload apa-apa
+        void build(const Scene::World& world, const std::vector<uint32_t>& rows, uint32_t meshCount);
+
+        const std::vector<DrawBatch>& getBatches() const { return batches; }
+        const std::vector<InstanceData>& getInstances() const { return instances; }
+
+        // [NEW] Tulis ulang transform + color instance untuk row yang berubah sejak build terakhir, tanpa
+        // sort ulang (layout batch tetap). outInstances = index instance yang diubah (row di luar build di-skip).
+        void refreshInstances(const Scene::World& world, const std::vector<uint32_t>& rows, std::vector<uint32_t>& outInstances);
+
+        // [NEW] materialID (MeshRenderer) -> index texture BindlessHeap. ID di luar table jatuh ke entry 0.
+        void setMaterialTable(const std::vector<uint32_t>& table) { materialTable = table; }
+
+    private:
+        struct SortEntry {
+            uint64_t key;   // DrawKey
+            uint32_t row;   // Row di Scene::World
+        };
+
+        // LSD radix sort 8 bit per digit (stabil), digit yang sama untuk semua key di-skip
+        static void radixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& scratch);
+
+        // Disimpan sebagai member supaya kapasitas dipakai ulang antar frame
+        std::vector<SortEntry> sortEntries;
+        std::vector<SortEntry> sortScratch;
+        std::vector<DrawBatch> batches;
+        std::vector<InstanceData> instances;
+        std::vector<uint32_t> instanceBatch; // batch index per instance (urutan sorted)
+        std::vector<uint32_t> rowInstance;   // [NEW] Row World -> index instance build terakhir (~0u = tidak di-batch)
+        std::vector<uint32_t> materialTable;
+    };
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+
+namespace Cogent::Renderer::DrawKey {
+
+    // [NEW] 64-bit sort key per draw. Field paling signifikan = state paling mahal untuk diganti:
+    // [63..60] pass | [59..52] pipeline | [51..40] material (descriptor set) | [39..24] mesh (VB/IB range) | [23..0] order
+    // Sort ascending -> draw dengan state sama berdempetan. Di dalam satu batch urut row ECS (stabil antar frame,
+    // tidak ikut kamera), jadi InstanceBuffer hanya meng-upload page yang isinya memang berubah.
+    constexpr uint32_t PASS_BITS = 4;
+    constexpr uint32_t PIPELINE_BITS = 8;
+    constexpr uint32_t MATERIAL_BITS = 12;
+    constexpr uint32_t MESH_BITS = 16;
+    constexpr uint32_t ORDER_BITS = 24;
+
+    constexpr uint32_t ORDER_SHIFT = 0;
+    constexpr uint32_t MESH_SHIFT = ORDER_SHIFT + ORDER_BITS;
+    constexpr uint32_t MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+    constexpr uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+    constexpr uint32_t PASS_SHIFT = PIPELINE_SHIFT + PIPELINE_BITS;
+    static_assert(PASS_SHIFT + PASS_BITS == 64, "DrawKey harus pas 64 bit");
+
+    constexpr uint64_t fieldMask(uint32_t bits) { return (uint64_t(1) << bits) - 1; }
+
+    // Semua bit kecuali order: key dengan state sama = satu instanced batch
+    constexpr uint64_t STATE_MASK = ~(fieldMask(ORDER_BITS) << ORDER_SHIFT);
+
+    constexpr uint64_t encode(uint32_t pass, uint32_t pipeline, uint32_t material, uint32_t mesh, uint32_t order) {
+        return ((pass & fieldMask(PASS_BITS)) << PASS_SHIFT) |
+               ((pipeline & fieldMask(PIPELINE_BITS)) << PIPELINE_SHIFT) |
+               ((material & fieldMask(MATERIAL_BITS)) << MATERIAL_SHIFT) |
+               ((mesh & fieldMask(MESH_BITS)) << MESH_SHIFT) |
+               ((order & fieldMask(ORDER_BITS)) << ORDER_SHIFT);
+    }
+
+    constexpr uint32_t pass(uint64_t key) { return static_cast<uint32_t>((key >> PASS_SHIFT) & fieldMask(PASS_BITS)); }
+    constexpr uint32_t pipeline(uint64_t key) { return static_cast<uint32_t>((key >> PIPELINE_SHIFT) & fieldMask(PIPELINE_BITS)); }
+    constexpr uint32_t material(uint64_t key) { return static_cast<uint32_t>((key >> MATERIAL_SHIFT) & fieldMask(MATERIAL_BITS)); }
+    constexpr uint32_t mesh(uint64_t key) { return static_cast<uint32_t>((key >> MESH_SHIFT) & fieldMask(MESH_BITS)); }
+}
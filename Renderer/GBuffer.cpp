@@ -5,7 +5,7 @@
 
 GBuffer::GBuffer(GraphicsDevice& device, uint32_t width, uint32_t height)
     : device(device), width(width), height(height), 
-      renderPass(VK_NULL_HANDLE), framebuffer(VK_NULL_HANDLE), sampler(VK_NULL_HANDLE),
+      renderPass(VK_NULL_HANDLE), loadRenderPass(VK_NULL_HANDLE), framebuffer(VK_NULL_HANDLE), sampler(VK_NULL_HANDLE),
       descriptorSetLayout(VK_NULL_HANDLE), descriptorPool(VK_NULL_HANDLE), descriptorSet(VK_NULL_HANDLE) {
     // init() removed: Must be called explicitly after device creation
 }
@@ -79,14 +79,22 @@ void GBuffer::init() {
     subpass.pDepthStencilAttachment = &depthRef;
 
     // Dependencies
+    // [FIX] Attachment G-Buffer cuma satu instance untuk semua frame in flight: frame sebelumnya
+    // masih bisa membacanya (lighting fragment, SSS / Hi-Z compute) atau menulisnya (pass pertama
+    // sebelum load pass). Tunggu semua pembaca/penulis itu sebelum color/depth ditulis lagi (WAR/WAW).
     std::array<VkSubpassDependency, 2> dependencies;
     dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
     dependencies[0].dstSubpass = 0;
-    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                                   VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+                                   VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    dependencies[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                    VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+    // Bukan BY_REGION: sumbernya termasuk compute, bukan framebuffer-local
+    dependencies[0].dependencyFlags = 0;
 
     dependencies[1].srcSubpass = 0;
     dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
@@ -109,6 +117,27 @@ void GBuffer::init() {
         throw std::runtime_error("Failed to create G-Buffer Render Pass");
     }
 
+    // [NEW] Load Render Pass (Hi-Z two-phase culling): lanjut menggambar di atas hasil pass pertama.
+    // Compatible dengan framebuffer yang sama (hanya load op + layout yang beda).
+    for (int i = 0; i < 3; ++i) {
+        attachments[i].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+        attachments[i].initialLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+    }
+    attachments[3].loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    attachments[3].initialLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+
+    // Depth baru saja dibaca compute (Hi-Z build) -> tunggu sebelum ditulis lagi
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT |
+                                    VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[0].dependencyFlags = 0;
+
+    if (vkCreateRenderPass(device.getDevice(), &renderPassInfo, nullptr, &loadRenderPass) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create G-Buffer Load Render Pass");
+    }
+
     // 3. Create Framebuffer
     std::array<VkImageView, 4> attachViews = { position.view, normal.view, albedo.view, depth.view };
     VkFramebufferCreateInfo fbufInfo = {};
@@ -213,6 +242,7 @@ void GBuffer::cleanup() {
     vkDestroySampler(dev, sampler, nullptr);
     vkDestroyFramebuffer(dev, framebuffer, nullptr);
     vkDestroyRenderPass(dev, renderPass, nullptr);
+    vkDestroyRenderPass(dev, loadRenderPass, nullptr);
 
     auto destroyAttach = [&](FramebufferAttachment& att) {
         vkDestroyImageView(dev, att.view, nullptr);
@@ -19,6 +19,9 @@ public:
     void resize(uint32_t width, uint32_t height);
 
     VkRenderPass getRenderPass() const { return renderPass; }
+    VkRenderPass getLoadRenderPass() const { return loadRenderPass; } // [NEW] LOAD ops, untuk phase 2 occlusion culling
+    uint32_t getWidth() const { return width; }
+    uint32_t getHeight() const { return height; }
     VkFramebuffer getFramebuffer() const { return framebuffer; }
     
     // G-Buffer Attachment Accessors
@@ -62,6 +65,7 @@ private:
     uint32_t width, height;
 
     VkRenderPass renderPass;
+    VkRenderPass loadRenderPass;
     VkFramebuffer framebuffer;
 
     // Attachments: Position, Normal, Albedo
@@ -1,6 +1,7 @@
 #include "RenderGraph.hpp"
 #include <iostream>
 #include "../../Core/Logger.hpp"
+#include "../../Core/Diagnostics/GpuProfiler.hpp"
 
 RenderGraph::RenderGraph(GraphicsDevice& device) : device(device) {}
 
@@ -38,7 +39,15 @@ void RenderGraph::compile() {
 }
 
 void RenderGraph::execute(VkCommandBuffer cmd) {
+    auto& gpuProfiler = Cogent::Diagnostics::GpuProfiler::Get();
     for (auto& pass : passes) {
+        // [NEW] Timestamp GPU otomatis per pass (barrier pass ikut terhitung). No-op kalau profiler belum Init.
+        if (gpuProfiler.IsActive() && !pass.gpuScopeRegistered) {
+            pass.gpuScope = gpuProfiler.RegisterScope(pass.name);
+            pass.gpuScopeRegistered = true;
+        }
+        if (pass.gpuScopeRegistered) gpuProfiler.BeginScope(cmd, pass.gpuScope);
+
         // 1. Pre-Pass Barriers (Transition Inputs & Outputs)
         // Check Inputs
         for (const auto& input : pass.inputs) {
@@ -63,6 +72,7 @@ void RenderGraph::execute(VkCommandBuffer cmd) {
         }
         
         // vkCmdDebugMarkerEndEXT...
+        if (pass.gpuScopeRegistered) gpuProfiler.EndScope(cmd);
     }
 }
 
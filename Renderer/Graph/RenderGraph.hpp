@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <vulkan/vulkan.h>
 #include "GraphicsDevice.hpp"
+#include "../../Core/Diagnostics/Profiler.hpp"
 
 // Resource State Tracking
 struct RenderGraphResource {
@@ -32,6 +33,10 @@ struct RenderPassNode {
     
     std::function<void(VkCommandBuffer)> execute;
     std::function<void(GraphicsDevice&)> setup;
+
+    // [NEW] Scope GpuProfiler ("GPU <name>"), di-intern saat pass pertama kali dieksekusi
+    Cogent::Diagnostics::ScopeID gpuScope = 0;
+    bool gpuScopeRegistered = false;
 };
 
 class RenderGraph {
@@ -1,63 +1,130 @@
 #include "InstanceBuffer.hpp"
 #include <cstring>
 #include <stdexcept>
+#include <algorithm>
 
 namespace Cogent::Renderer {
 
-    InstanceBuffer::InstanceBuffer(GraphicsDevice& device) : device(device) {}
+    InstanceBuffer::InstanceBuffer(GraphicsDevice& device, uint32_t framesInFlight, bool deviceLocal)
+        : device(device), framesInFlight(framesInFlight > 0 ? framesInFlight : 1), deviceLocal(deviceLocal) {}
 
     InstanceBuffer::~InstanceBuffer() {
-        if (buffer) {
-            vkDestroyBuffer(device.getDevice(), buffer, nullptr);
-            vkFreeMemory(device.getDevice(), memory, nullptr);
-        }
+        VkDevice dev = device.getDevice();
+        if (ringMemory) vkUnmapMemory(dev, ringMemory);
+        if (ringBuffer) vkDestroyBuffer(dev, ringBuffer, nullptr);
+        if (ringMemory) vkFreeMemory(dev, ringMemory, nullptr);
+        if (deviceBuffer) vkDestroyBuffer(dev, deviceBuffer, nullptr);
+        if (deviceMemory) vkFreeMemory(dev, deviceMemory, nullptr);
     }
 
-    void InstanceBuffer::update(const std::vector<InstanceData>& instances) {
-        if (instances.empty()) return;
+    void InstanceBuffer::grow(uint32_t required) {
+        uint32_t newCapacity = capacity > 0 ? capacity : MIN_CAPACITY;
+        while (newCapacity < required) newCapacity *= 2;
 
-        VkDeviceSize newSize = sizeof(InstanceData) * instances.size();
-        instanceCount = static_cast<uint32_t>(instances.size());
+        // [FIX] Buffer lama mungkin masih dibaca frame yang in flight -> destroy setelah frame retire
+        if (ringMemory) vkUnmapMemory(device.getDevice(), ringMemory);
+        device.getDeletionQueue().destroyBuffer(ringBuffer, ringMemory);
+        device.getDeletionQueue().destroyBuffer(deviceBuffer, deviceMemory);
+        deviceBuffer = VK_NULL_HANDLE;
+        deviceMemory = VK_NULL_HANDLE;
 
-        // Reallocate if too small
-        if (newSize > bufferSize) {
-            if (buffer) {
-                vkDestroyBuffer(device.getDevice(), buffer, nullptr);
-                vkFreeMemory(device.getDevice(), memory, nullptr);
-            }
+        capacity = newCapacity;
+        pageCount = (capacity + PAGE_SIZE - 1) / PAGE_SIZE;
 
-            bufferSize = newSize;
+        // Host-visible ring: langsung jadi vertex buffer (mode host) atau staging (mode device-local)
+        const VkDeviceSize slotSize = sizeof(InstanceData) * capacity;
+        device.createBuffer(slotSize * framesInFlight,
+                            deviceLocal ? VK_BUFFER_USAGE_TRANSFER_SRC_BIT : VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                            ringBuffer, ringMemory);
 
-            VkBufferCreateInfo bufferInfo{};
-            bufferInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-            bufferInfo.size = bufferSize;
-            bufferInfo.usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT; 
-            bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        void* data = nullptr;
+        if (vkMapMemory(device.getDevice(), ringMemory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to map Instance Buffer!");
+        }
+        mapped = static_cast<InstanceData*>(data); // Persistently mapped sampai grow / destructor
 
-            if (vkCreateBuffer(device.getDevice(), &bufferInfo, nullptr, &buffer) != VK_SUCCESS) {
-                throw std::runtime_error("Failed to create Instance Buffer!");
-            }
+        if (deviceLocal) {
+            device.createBuffer(slotSize, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+                                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, deviceBuffer, deviceMemory);
+        }
 
-            VkMemoryRequirements memReqs;
-            vkGetBufferMemoryRequirements(device.getDevice(), buffer, &memReqs);
+        // Buffer baru kosong: semua instance dianggap berubah
+        shadow.resize(capacity);
+        shadowCount = 0;
+        slotDirty.assign(static_cast<size_t>(pageCount) * framesInFlight, 0);
+    }
+
+    void InstanceBuffer::markPage(uint32_t page) {
+        for (uint32_t slot = 0; slot < framesInFlight; slot++) {
+            slotDirty[static_cast<size_t>(slot) * pageCount + page] = 1;
+        }
+    }
 
-            VkMemoryAllocateInfo allocInfo{};
-            allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-            allocInfo.allocationSize = memReqs.size;
-            // Host Visible for frequent updates (Phase 2 optimization: Use Staging Buffer + Device Local)
-            allocInfo.memoryTypeIndex = device.findMemoryType(memReqs.memoryTypeBits, 
-                VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+    void InstanceBuffer::update(const std::vector<InstanceData>& instances, uint32_t frameIndex) {
+        currentSlot = frameIndex % framesInFlight;
+        uploadedInstances = 0;
+        pendingCopies.clear();
 
-            if (vkAllocateMemory(device.getDevice(), &allocInfo, nullptr, &memory) != VK_SUCCESS) {
-                throw std::runtime_error("Failed to allocate Instance Memory!");
+        const uint32_t count = static_cast<uint32_t>(instances.size());
+        instanceCount = count;
+        if (count == 0) return;
+        if (count > capacity) grow(count);
+
+        InstanceData* slotData = mapped + static_cast<size_t>(capacity) * currentSlot;
+        const uint32_t usedPages = (count + PAGE_SIZE - 1) / PAGE_SIZE;
+
+        for (uint32_t page = 0; page < usedPages; page++) {
+            const uint32_t begin = page * PAGE_SIZE;
+            const uint32_t end = std::min(begin + PAGE_SIZE, count);
+            const size_t bytes = sizeof(InstanceData) * (end - begin);
+
+            // Diff di memory CPU (cached) jauh lebih murah daripada menulis ke memory GPU (write-combined)
+            const bool changed = end > shadowCount || std::memcmp(&shadow[begin], &instances[begin], bytes) != 0;
+            if (changed) std::memcpy(&shadow[begin], &instances[begin], bytes);
+
+            if (deviceLocal) {
+                // Buffer device selalu berisi versi terbaru: cukup page yang berubah frame ini
+                if (!changed) continue;
+                std::memcpy(slotData + begin, &shadow[begin], bytes);
+                const VkDeviceSize srcOffset = sizeof(InstanceData) * (static_cast<VkDeviceSize>(capacity) * currentSlot + begin);
+                const VkDeviceSize dstOffset = sizeof(InstanceData) * static_cast<VkDeviceSize>(begin);
+                if (!pendingCopies.empty() && pendingCopies.back().dstOffset + pendingCopies.back().size == dstOffset) {
+                    pendingCopies.back().size += bytes; // Gabung page yang bersebelahan
+                } else {
+                    pendingCopies.push_back({ srcOffset, dstOffset, bytes });
+                }
+                uploadedInstances += end - begin;
+            } else {
+                // Tiap slot ring harus menerima perubahan ini saat gilirannya direkam
+                if (changed) markPage(page);
+                uint8_t& dirty = slotDirty[static_cast<size_t>(currentSlot) * pageCount + page];
+                if (!dirty) continue;
+                std::memcpy(slotData + begin, &shadow[begin], bytes);
+                dirty = 0;
+                uploadedInstances += end - begin;
             }
-            vkBindBufferMemory(device.getDevice(), buffer, memory, 0);
         }
+        shadowCount = count;
+    }
+
+    void InstanceBuffer::recordUpload(VkCommandBuffer commandBuffer) {
+        if (!deviceLocal || pendingCopies.empty()) return;
+
+        // WAR: frame sebelumnya (queue yang sama) mungkin masih membaca buffer device di vertex input
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        vkCmdCopyBuffer(commandBuffer, ringBuffer, deviceBuffer, static_cast<uint32_t>(pendingCopies.size()), pendingCopies.data());
 
-        // Map and Copy
-        void* data;
-        vkMapMemory(device.getDevice(), memory, 0, newSize, 0, &data);
-        memcpy(data, instances.data(), (size_t)newSize);
-        vkUnmapMemory(device.getDevice(), memory);
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+        pendingCopies.clear();
     }
 }
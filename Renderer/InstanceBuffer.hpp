@@ -1,6 +1,8 @@
 #pragma once
 #include <vulkan/vulkan.h>
 #include <vector>
+#include <array>
+#include <cstddef>
 #include <glm/glm.hpp>
 #include "../../Core/Graphics/GraphicsDevice.hpp"
 
@@ -9,23 +11,92 @@ namespace Cogent::Renderer {
         glm::mat4 model;
         glm::vec4 color;
         int id;
-        int padding[3];
+        int batchID;    // [NEW] Index DrawBatch (dipakai GPU culling untuk bounds + draw slot)
+        int materialIndex; // [NEW] Index texture di BindlessHeap (di-index per draw di gbuffer.frag)
+        int padding;
+
+        // [NEW] Binding 1 = per-instance stream (binding 0 = Vertex)
+        static constexpr uint32_t BINDING = 1;
+
+        static VkVertexInputBindingDescription getBindingDescription() {
+            VkVertexInputBindingDescription bindingDescription{};
+            bindingDescription.binding = BINDING;
+            bindingDescription.stride = sizeof(InstanceData);
+            bindingDescription.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+            return bindingDescription;
+        }
+
+        // Location 4..7 = model matrix (4 kolom vec4), 8 = color, 9 = material index
+        static std::array<VkVertexInputAttributeDescription, 6> getAttributeDescriptions() {
+            std::array<VkVertexInputAttributeDescription, 6> attributeDescriptions{};
+            for (uint32_t i = 0; i < 4; i++) {
+                attributeDescriptions[i].binding = BINDING;
+                attributeDescriptions[i].location = 4 + i;
+                attributeDescriptions[i].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+                attributeDescriptions[i].offset = offsetof(InstanceData, model) + sizeof(glm::vec4) * i;
+            }
+
+            attributeDescriptions[4].binding = BINDING;
+            attributeDescriptions[4].location = 8;
+            attributeDescriptions[4].format = VK_FORMAT_R32G32B32A32_SFLOAT;
+            attributeDescriptions[4].offset = offsetof(InstanceData, color);
+
+            attributeDescriptions[5].binding = BINDING;
+            attributeDescriptions[5].location = 9;
+            attributeDescriptions[5].format = VK_FORMAT_R32_SINT;
+            attributeDescriptions[5].offset = offsetof(InstanceData, materialIndex);
+
+            return attributeDescriptions;
+        }
     };
 
+    // [NEW] Instance stream persistently mapped, ring N frame (satu region per frame in flight).
+    // update() men-diff per page terhadap shadow CPU: hanya page yang berubah yang ditulis ke memory GPU,
+    // jadi scene statis tidak menulis apa-apa. Kapasitas tumbuh x2, buffer lama lewat DeletionQueue.
+    // Mode deviceLocal (GPU diskrit): ring = staging, page berubah di-copy ke satu buffer DEVICE_LOCAL
+    // di recordUpload().
     class InstanceBuffer {
     public:
-        InstanceBuffer(GraphicsDevice& device);
+        static constexpr uint32_t PAGE_SIZE = 64;      // Instance per page (granularity dirty tracking)
+        static constexpr uint32_t MIN_CAPACITY = 1024;
+
+        InstanceBuffer(GraphicsDevice& device, uint32_t framesInFlight = 1, bool deviceLocal = false);
         ~InstanceBuffer();
 
-        void update(const std::vector<InstanceData>& instances);
-        VkBuffer getBuffer() const { return buffer; }
+        // frameIndex = slot frame in flight yang sedang direkam (fence-nya sudah di-wait)
+        void update(const std::vector<InstanceData>& instances, uint32_t frameIndex = 0);
+        // Device-local: copy page yang berubah + barrier ke vertex input. Di luar render pass. No-op di mode host.
+        void recordUpload(VkCommandBuffer commandBuffer);
+
+        VkBuffer getBuffer() const { return deviceLocal ? deviceBuffer : ringBuffer; }
+        VkDeviceSize getOffset() const { return deviceLocal ? 0 : sizeof(InstanceData) * capacity * currentSlot; } // Offset bind binding 1
         uint32_t getInstanceCount() const { return instanceCount; }
+        uint32_t getUploadedInstances() const { return uploadedInstances; } // Ditulis di update terakhir (0 = statis)
+        bool isDeviceLocal() const { return deviceLocal; }
 
     private:
+        void grow(uint32_t required);
+        void markPage(uint32_t page);
+
         GraphicsDevice& device;
-        VkBuffer buffer;
-        VkDeviceMemory memory;
+        uint32_t framesInFlight;
+        bool deviceLocal;
+
+        uint32_t capacity = 0; // Instance per slot
+        uint32_t pageCount = 0;
         uint32_t instanceCount = 0;
-        VkDeviceSize bufferSize = 0;
+        uint32_t currentSlot = 0;
+        uint32_t uploadedInstances = 0;
+
+        VkBuffer ringBuffer = VK_NULL_HANDLE; // [slot * capacity + i], host-visible
+        VkDeviceMemory ringMemory = VK_NULL_HANDLE;
+        InstanceData* mapped = nullptr;
+        VkBuffer deviceBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory deviceMemory = VK_NULL_HANDLE;
+
+        std::vector<InstanceData> shadow;   // Isi terbaru (basis diff)
+        uint32_t shadowCount = 0;           // Instance valid di shadow
+        std::vector<uint8_t> slotDirty;     // Mode host: [slot * pageCount + page] belum ditulis ke slot itu
+        std::vector<VkBufferCopy> pendingCopies; // Mode device-local: region staging -> device frame ini
     };
 }
@@ -1,36 +1,12 @@
 #include "LightingPass.hpp"
-#include <fstream>
-
-std::vector<char> LightingPass::readFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-    if (!file.is_open()) throw std::runtime_error("Gagal buka shader: " + filename);
-    size_t fileSize = (size_t)file.tellg();
-    std::vector<char> buffer(fileSize);
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
-    return buffer;
-}
-
-VkShaderModule LightingPass::createShaderModule(VkDevice device, const std::vector<char>& code) {
-    VkShaderModuleCreateInfo createInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
-    VkShaderModule shaderModule;
-    vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule);
-    return shaderModule;
-}
-
-void LightingPass::init(VkDevice device, VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout, VkExtent2D extent) {
-    auto vertCode = readFile("Shaders/lighting.vert.spv");
-    auto fragCode = readFile("Shaders/lighting.frag.spv");
-
-    VkShaderModule vertModule = createShaderModule(device, vertCode);
-    VkShaderModule fragModule = createShaderModule(device, fragCode);
+#include "ShaderRegistry.hpp"
 
+void LightingPass::init(VkDevice device, VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout, VkExtent2D extent,
+                        VkPipelineCache pipelineCache) {
+    auto& shaders = Cogent::Renderer::ShaderRegistry::Get();
     VkPipelineShaderStageCreateInfo shaderStages[] = {
-        {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_VERTEX_BIT, vertModule, "main", nullptr},
-        {VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO, nullptr, 0, VK_SHADER_STAGE_FRAGMENT_BIT, fragModule, "main", nullptr}
+        shaders.stage(VK_SHADER_STAGE_VERTEX_BIT, "Shaders/lighting.vert.spv"),
+        shaders.stage(VK_SHADER_STAGE_FRAGMENT_BIT, "Shaders/lighting.frag.spv")
     };
 
     // Vertex Input: KOSONG (Karena kita generate vertex di shader pakai trik gl_VertexIndex)
@@ -94,12 +70,9 @@ void LightingPass::init(VkDevice device, VkRenderPass renderPass, VkDescriptorSe
     pipelineInfo.renderPass = renderPass; // Ini nanti RenderPass SWAPCHAIN
     pipelineInfo.subpass = 0;
 
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("Gagal membuat Lighting Pipeline!");
     }
-
-    vkDestroyShaderModule(device, fragModule, nullptr);
-    vkDestroyShaderModule(device, vertModule, nullptr);
 }
 
 void LightingPass::cleanup(VkDevice device) {
@@ -7,7 +7,8 @@
 
 class LightingPass {
 public:
-    void init(VkDevice device, VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout, VkExtent2D extent);
+    void init(VkDevice device, VkRenderPass renderPass, VkDescriptorSetLayout descriptorSetLayout, VkExtent2D extent,
+              VkPipelineCache pipelineCache = VK_NULL_HANDLE);
     void cleanup(VkDevice device);
     
     VkPipeline getPipeline() { return pipeline; }
@@ -16,7 +17,4 @@ public:
 private:
     VkPipeline pipeline;
     VkPipelineLayout pipelineLayout;
-
-    VkShaderModule createShaderModule(VkDevice device, const std::vector<char>& code);
-    static std::vector<char> readFile(const std::string& filename);
 };
\ No newline at end of file
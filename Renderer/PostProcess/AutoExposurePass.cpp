@@ -2,6 +2,7 @@
 #include <stdexcept>
 #include <array>
 #include "../../Core/VulkanUtils.hpp"
+#include "../ShaderRegistry.hpp"
 
 namespace Cogent::Renderer {
 
@@ -108,24 +109,17 @@ namespace Cogent::Renderer {
         }
 
         // 5. Load Shader and Create Pipeline
-        auto computeShaderCode = VulkanUtils::readFile("Shaders/AutoExposure.comp.spv");
-        VkShaderModule computeShaderModule = VulkanUtils::createShaderModule(device.getDevice(), computeShaderCode);
-
-        VkPipelineShaderStageCreateInfo computeShaderStageInfo{};
-        computeShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-        computeShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-        computeShaderStageInfo.module = computeShaderModule;
-        computeShaderStageInfo.pName = "main";
+        VkPipelineShaderStageCreateInfo computeShaderStageInfo =
+            ShaderRegistry::Get().stage(VK_SHADER_STAGE_COMPUTE_BIT, "Shaders/AutoExposure.comp.spv");
 
         VkComputePipelineCreateInfo pipelineInfo{};
         pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
         pipelineInfo.layout = pipelineLayout;
         pipelineInfo.stage = computeShaderStageInfo;
 
-        if (vkCreateComputePipelines(device.getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+        if (vkCreateComputePipelines(device.getDevice(), device.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
             throw std::runtime_error("Failed to create AutoExposure Pipeline!");
         }
-        vkDestroyShaderModule(device.getDevice(), computeShaderModule, nullptr);
     }
 
     void AutoExposurePass::execute(VkCommandBuffer cmd, VkImageView inputColor) {
@@ -4,63 +4,33 @@
 #include <array>
 #include "Types.hpp"
 #include "Model.hpp"
-
-// Helper membaca file binary .spv
-std::vector<char> RenderPipeline::readFile(const std::string& filename) {
-    std::ifstream file(filename, std::ios::ate | std::ios::binary);
-    if (!file.is_open()) {
-        throw std::runtime_error("Gagal membuka file shader: " + filename);
-    }
-    size_t fileSize = (size_t)file.tellg();
-    std::vector<char> buffer(fileSize);
-    file.seekg(0);
-    file.read(buffer.data(), fileSize);
-    file.close();
-    return buffer;
-}
-
-VkShaderModule RenderPipeline::createShaderModule(VkDevice device, const std::vector<char>& code) {
-    VkShaderModuleCreateInfo createInfo{};
-    createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
-    VkShaderModule shaderModule;
-    if (vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule) != VK_SUCCESS) {
-        throw std::runtime_error("Gagal membuat shader module!");
-    }
-    return shaderModule;
-}
-
-void RenderPipeline::init(VkDevice device, VkRenderPass renderPass, VkExtent2D extent, const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts) {
-    // 1. LOAD SHADERS
-    auto vertShaderCode = readFile("Shaders/gbuffer.vert.spv");
-    auto fragShaderCode = readFile("Shaders/gbuffer.frag.spv");
-
-    VkShaderModule vertShaderModule = createShaderModule(device, vertShaderCode);
-    VkShaderModule fragShaderModule = createShaderModule(device, fragShaderCode);
-
-    VkPipelineShaderStageCreateInfo vertShaderStageInfo{};
-    vertShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    vertShaderStageInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
-    vertShaderStageInfo.module = vertShaderModule;
-    vertShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo fragShaderStageInfo{};
-    fragShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    fragShaderStageInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-    fragShaderStageInfo.module = fragShaderModule;
-    fragShaderStageInfo.pName = "main";
-
-    VkPipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
+#include "InstanceBuffer.hpp"
+#include "ShaderRegistry.hpp"
+
+void RenderPipeline::init(VkDevice device, VkRenderPass renderPass, VkExtent2D extent, const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+                          VkPipelineCache pipelineCache) {
+    // 1. LOAD SHADERS [MODIFIED] Module di-cache ShaderRegistry (tidak di-destroy di sini)
+    auto& shaders = Cogent::Renderer::ShaderRegistry::Get();
+    VkPipelineShaderStageCreateInfo shaderStages[] = {
+        shaders.stage(VK_SHADER_STAGE_VERTEX_BIT, "Shaders/gbuffer.vert.spv"),
+        shaders.stage(VK_SHADER_STAGE_FRAGMENT_BIT, "Shaders/gbuffer.frag.spv")
+    };
 
     // 2. VERTEX INPUT (Menghubungkan Model.hpp ke Pipeline)
-    auto bindingDescription = Vertex::getBindingDescription();
-    auto attributeDescriptions = Vertex::getAttributeDescriptions();
+    // [NEW] Binding 0 = per-vertex, Binding 1 = per-instance (InstanceData)
+    std::array<VkVertexInputBindingDescription, 2> bindingDescriptions = {
+        Vertex::getBindingDescription(),
+        Cogent::Renderer::InstanceData::getBindingDescription()
+    };
+
+    std::vector<VkVertexInputAttributeDescription> attributeDescriptions;
+    for (const auto& attr : Vertex::getAttributeDescriptions()) attributeDescriptions.push_back(attr);
+    for (const auto& attr : Cogent::Renderer::InstanceData::getAttributeDescriptions()) attributeDescriptions.push_back(attr);
 
     VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
     vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-    vertexInputInfo.vertexBindingDescriptionCount = 1;
-    vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
+    vertexInputInfo.vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size());
+    vertexInputInfo.pVertexBindingDescriptions = bindingDescriptions.data();
     vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
     vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 
@@ -116,14 +86,8 @@ void RenderPipeline::init(VkDevice device, VkRenderPass renderPass, VkExtent2D e
     colorBlending.attachmentCount = static_cast<uint32_t>(blendAttachments.size());
     colorBlending.pAttachments = blendAttachments.data();
 
-    // 6. PIPELINE LAYOUT (Push Constants & Descriptors)
-    // Setup Push Constant untuk mengirim Model Matrix
-    VkPushConstantRange pushConstantRange{};
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT; // [FIX] Fragment juga butuh warna
-    pushConstantRange.offset = 0;
-    
-    // [FIX] Update ukuran agar sesuai struct ObjectPushConstant
-    pushConstantRange.size = sizeof(ObjectPushConstant); 
+    // 6. PIPELINE LAYOUT (Descriptors)
+    // [MODIFIED] Tanpa push constant: model matrix & warna per instance dibaca dari InstanceBuffer
 
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
@@ -132,8 +96,8 @@ void RenderPipeline::init(VkDevice device, VkRenderPass renderPass, VkExtent2D e
     pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(descriptorSetLayouts.size());
     pipelineLayoutInfo.pSetLayouts = descriptorSetLayouts.data();
     
-    pipelineLayoutInfo.pushConstantRangeCount = 1;
-    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    pipelineLayoutInfo.pushConstantRangeCount = 0;
+    pipelineLayoutInfo.pPushConstantRanges = nullptr;
 
     if (vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
         throw std::runtime_error("Gagal membuat pipeline layout!");
@@ -166,13 +130,9 @@ void RenderPipeline::init(VkDevice device, VkRenderPass renderPass, VkExtent2D e
     dynamicState.pDynamicStates = dynamicStates.data();
     pipelineInfo.pDynamicState = &dynamicState;
 
-    if (vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("Gagal membuat graphics pipeline!");
     }
-
-    // Bersihkan module shader setelah pipeline jadi (sudah tidak butuh)
-    vkDestroyShaderModule(device, fragShaderModule, nullptr);
-    vkDestroyShaderModule(device, vertShaderModule, nullptr);
 }
 
 void RenderPipeline::cleanup(VkDevice device) {
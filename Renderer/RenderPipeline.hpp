@@ -6,7 +6,9 @@
 
 class RenderPipeline {
 public:
-    void init(VkDevice device, VkRenderPass renderPass, VkExtent2D extent, const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts);
+    // [MODIFIED] pipelineCache = cache device (GraphicsDevice::getPipelineCache)
+    void init(VkDevice device, VkRenderPass renderPass, VkExtent2D extent, const std::vector<VkDescriptorSetLayout>& descriptorSetLayouts,
+              VkPipelineCache pipelineCache = VK_NULL_HANDLE);
     void cleanup(VkDevice device);
 
     VkPipeline getPipeline() { return pipeline; }
@@ -15,7 +17,4 @@ public:
 private:
     VkPipeline pipeline = VK_NULL_HANDLE;
     VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
-
-    VkShaderModule createShaderModule(VkDevice device, const std::vector<char>& code);
-    static std::vector<char> readFile(const std::string& filename);
 };
\ No newline at end of file
@@ -2,10 +2,11 @@
 #include <stdexcept>
 #include <array>
 #include "../Core/VulkanUtils.hpp"
+#include "ShaderRegistry.hpp"
 
 
-ScreenSpaceShadows::ScreenSpaceShadows(GraphicsDevice& device, VkExtent2D extent) 
-    : device(device), extent(extent) {
+ScreenSpaceShadows::ScreenSpaceShadows(GraphicsDevice& device, VkExtent2D extent, const Quality& quality) 
+    : device(device), extent(extent), quality(quality) {
     init();
 }
 
@@ -77,13 +78,30 @@ void ScreenSpaceShadows::createResources() {
         throw std::runtime_error("Failed to create SSS View!");
     }
 
+    // [FIX] Shadow mask selalu di GENERAL (storage write + sampled read); transisi sekali di sini
+    // supaya barrier per-frame tidak perlu UNDEFINED dan bisa menunggu pembaca frame sebelumnya.
+    VkCommandBuffer cmd = device.beginSingleTimeCommands();
+    VkImageMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0, 0, nullptr, 0, nullptr, 1, &barrier);
+    device.endSingleTimeCommands(cmd);
+
     // Create Descriptor Pool
     std::array<VkDescriptorPoolSize, 3> poolSizes{};
     poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
     poolSizes[0].descriptorCount = 1;
     poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
     poolSizes[1].descriptorCount = 1;
-    poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    poolSizes[2].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     poolSizes[2].descriptorCount = 1;
 
     VkDescriptorPoolCreateInfo poolInfo{};
@@ -117,7 +135,7 @@ void ScreenSpaceShadows::createDescriptorSetLayout() {
 
     bindings[2].binding = 2;
     bindings[2].descriptorCount = 1;
-    bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    bindings[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC; // Slice UniformRing
     bindings[2].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
 
     VkDescriptorSetLayoutCreateInfo info{};
@@ -130,7 +148,7 @@ void ScreenSpaceShadows::createDescriptorSetLayout() {
     }
 }
 
-void ScreenSpaceShadows::updateDescriptorSets(VkImageView depthView, VkSampler depthSampler, VkBuffer globalUbo) {
+void ScreenSpaceShadows::updateDescriptorSets(VkImageView depthView, VkSampler depthSampler, VkBuffer globalUbo, VkDeviceSize uboRange) {
     if (descriptorSet == VK_NULL_HANDLE) {
         VkDescriptorPoolSize poolSize = { VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1 }; 
         
@@ -155,8 +173,8 @@ void ScreenSpaceShadows::updateDescriptorSets(VkImageView depthView, VkSampler d
     
     VkDescriptorBufferInfo bufferInfo{};
     bufferInfo.buffer = globalUbo;
-    bufferInfo.offset = 0;
-    bufferInfo.range = VK_WHOLE_SIZE;
+    bufferInfo.offset = 0; // + dynamic offset saat bind
+    bufferInfo.range = uboRange;
 
     writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     writes[0].dstSet = descriptorSet;
@@ -175,7 +193,7 @@ void ScreenSpaceShadows::updateDescriptorSets(VkImageView depthView, VkSampler d
     writes[2].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
     writes[2].dstSet = descriptorSet;
     writes[2].dstBinding = 2; // UBO
-    writes[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    writes[2].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     writes[2].descriptorCount = 1;
     writes[2].pBufferInfo = &bufferInfo;
 
@@ -183,30 +201,28 @@ void ScreenSpaceShadows::updateDescriptorSets(VkImageView depthView, VkSampler d
 }
 
 void ScreenSpaceShadows::createPipeline() {
-    auto computeShaderCode = VulkanUtils::readFile("Shaders/sss.comp.spv");
-
-    VkShaderModule computeShaderModule = VulkanUtils::createShaderModule(device.getDevice(), computeShaderCode);
-
-    VkPipelineShaderStageCreateInfo computeShaderStageInfo{};
-    computeShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-    computeShaderStageInfo.stage = VK_SHADER_STAGE_COMPUTE_BIT;
-    computeShaderStageInfo.module = computeShaderModule;
-    computeShaderStageInfo.pName = "main";
-
-    VkPushConstantRange pushConstantRange{};
-    pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
-    pushConstantRange.offset = 0;
-    pushConstantRange.size = sizeof(glm::mat4) * 2 + sizeof(glm::vec4); // View + Proj + LightDir
-
-    VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
-    pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-    pipelineLayoutInfo.setLayoutCount = 1;
-    pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
-    pipelineLayoutInfo.pushConstantRangeCount = 1;
-    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
-
-    if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create SSS Pipeline Layout!");
+    Cogent::Renderer::SpecializationConstants specialization;
+    specialization.set(0, quality.maxSteps).set(1, quality.stepSize).set(2, quality.thickness);
+    VkPipelineShaderStageCreateInfo computeShaderStageInfo =
+        Cogent::Renderer::ShaderRegistry::Get().stage(VK_SHADER_STAGE_COMPUTE_BIT, "Shaders/sss.comp.spv", specialization.get());
+
+    // Layout sama untuk semua variant: hanya dibuat sekali
+    if (pipelineLayout == VK_NULL_HANDLE) {
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(glm::mat4) * 2 + sizeof(glm::vec4); // View + Proj + LightDir
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create SSS Pipeline Layout!");
+        }
     }
 
     VkComputePipelineCreateInfo pipelineInfo{};
@@ -214,21 +230,29 @@ void ScreenSpaceShadows::createPipeline() {
     pipelineInfo.layout = pipelineLayout;
     pipelineInfo.stage = computeShaderStageInfo;
 
-    if (vkCreateComputePipelines(device.getDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+    if (vkCreateComputePipelines(device.getDevice(), device.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
         throw std::runtime_error("Failed to create SSS Pipeline!");
     }
+}
 
-    vkDestroyShaderModule(device.getDevice(), computeShaderModule, nullptr);
+void ScreenSpaceShadows::setQuality(const Quality& newQuality) {
+    if (newQuality.maxSteps == quality.maxSteps && newQuality.stepSize == quality.stepSize &&
+        newQuality.thickness == quality.thickness) return;
+    quality = newQuality;
+
+    VkPipeline oldPipeline = pipeline;
+    device.getDeletionQueue().push([oldPipeline](VkDevice dev) { vkDestroyPipeline(dev, oldPipeline, nullptr); });
+    createPipeline();
 }
 
-void ScreenSpaceShadows::execute(VkCommandBuffer cmd, const glm::mat4& view, const glm::mat4& proj, const glm::vec4& lightDir) {
+void ScreenSpaceShadows::execute(VkCommandBuffer cmd, const glm::mat4& view, const glm::mat4& proj, const glm::vec4& lightDir, uint32_t uboOffset) {
     vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
     
     // Bind internal descriptor set (updated via updateDescriptorSets)
     if (descriptorSet == VK_NULL_HANDLE) {
         throw std::runtime_error("SSS Descriptor Set is NULL during execute!");
     }
-    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+    vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 1, &uboOffset);
 
     struct PushConstants {
         glm::mat4 view;
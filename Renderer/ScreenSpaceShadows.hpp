@@ -6,18 +6,40 @@
 
 class ScreenSpaceShadows {
 public:
-    ScreenSpaceShadows(GraphicsDevice& device, VkExtent2D extent);
+    // [NEW] Specialization constant sss.comp (constant_id 0..2). Ganti variant = buat ulang pipeline
+    // dari module yang sama, tanpa compile ulang shader.
+    struct Quality {
+        int32_t maxSteps = 64;
+        float stepSize = 0.05f;
+        float thickness = 0.1f;
+
+        // shadowQuality OptimizerAI (0=Low, 1=Med, 2=High): panjang march sama, jumlah step beda
+        static Quality fromLevel(int level) {
+            if (level <= 0) return { 16, 0.2f, 0.2f };
+            if (level == 1) return { 32, 0.1f, 0.15f };
+            return {};
+        }
+    };
+
+    ScreenSpaceShadows(GraphicsDevice& device, VkExtent2D extent) : ScreenSpaceShadows(device, extent, Quality{}) {}
+    ScreenSpaceShadows(GraphicsDevice& device, VkExtent2D extent, const Quality& quality);
     ~ScreenSpaceShadows();
 
     void init();
-    void execute(VkCommandBuffer cmd, const glm::mat4& view, const glm::mat4& proj, const glm::vec4& lightDir);
+    // uboOffset = dynamic offset slice camera di UniformRing frame ini
+    void execute(VkCommandBuffer cmd, const glm::mat4& view, const glm::mat4& proj, const glm::vec4& lightDir, uint32_t uboOffset);
     VkImage getImage() const { return image; }
 
     VkImage getOutputImage() const { return image; }
     VkImageView getOutputView() const { return imageView; }
     
-    // Links external resources (Depth Buffer, Camera UBO) into internal descriptor set
-    void updateDescriptorSets(VkImageView depthView, VkSampler depthSampler, VkBuffer globalUbo);
+    // Links external resources (Depth Buffer, Camera UBO) into internal descriptor set.
+    // globalUbo = buffer UniformRing, binding 2 dynamic dengan range uboRange
+    void updateDescriptorSets(VkImageView depthView, VkSampler depthSampler, VkBuffer globalUbo, VkDeviceSize uboRange);
+
+    // Pipeline lama di-destroy lewat DeletionQueue (mungkin masih dipakai frame in flight)
+    void setQuality(const Quality& newQuality);
+    const Quality& getQuality() const { return quality; }
 
 private:
     void createResources();
@@ -26,13 +48,14 @@ private:
 
     GraphicsDevice& device;
     VkExtent2D extent;
+    Quality quality;
 
     VkImage image;
     VkDeviceMemory memory;
     VkImageView imageView;
 
-    VkPipeline pipeline;
-    VkPipelineLayout pipelineLayout;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
     VkDescriptorSetLayout descriptorSetLayout;
     VkDescriptorPool descriptorPool;
     VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
@@ -0,0 +1,106 @@
+#include "SecondaryCommandRecorder.hpp"
+#include "../Core/Threading/JobSystem.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace Cogent::Renderer {
+
+    SecondaryCommandRecorder::SecondaryCommandRecorder(GraphicsDevice& device, uint32_t framesInFlight, uint32_t slotCount)
+        : device(device), framesInFlight(framesInFlight), slotCount(slotCount) {
+        slots.resize(framesInFlight * slotCount);
+
+        VkCommandPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+        poolInfo.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT; // Reset per pool, bukan per buffer
+        poolInfo.queueFamilyIndex = device.getGraphicsQueueFamily();
+
+        for (Slot& slot : slots) {
+            if (vkCreateCommandPool(device.getDevice(), &poolInfo, nullptr, &slot.pool) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create secondary command pool!");
+            }
+        }
+    }
+
+    SecondaryCommandRecorder::~SecondaryCommandRecorder() {
+        for (Slot& slot : slots) {
+            if (slot.pool) vkDestroyCommandPool(device.getDevice(), slot.pool, nullptr); // Ikut free buffers
+        }
+    }
+
+    void SecondaryCommandRecorder::beginFrame(uint32_t frameIndex) {
+        currentFrame = frameIndex % framesInFlight;
+        for (uint32_t i = 0; i < slotCount; i++) {
+            Slot& slot = slots[currentFrame * slotCount + i];
+            if (slot.used == 0) continue; // Tidak ada yang di-record sejak reset terakhir
+            vkResetCommandPool(device.getDevice(), slot.pool, 0);
+            slot.used = 0;
+        }
+    }
+
+    VkResult SecondaryCommandRecorder::acquire(Slot& slot, VkCommandBuffer& commandBuffer) {
+        if (slot.used == slot.buffers.size()) {
+            VkCommandBufferAllocateInfo allocInfo{};
+            allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+            allocInfo.commandPool = slot.pool;
+            allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+            allocInfo.commandBufferCount = 1;
+
+            VkCommandBuffer newBuffer;
+            const VkResult result = vkAllocateCommandBuffers(device.getDevice(), &allocInfo, &newBuffer);
+            if (result != VK_SUCCESS) return result;
+            slot.buffers.push_back(newBuffer);
+        }
+        commandBuffer = slot.buffers[slot.used++];
+        return VK_SUCCESS;
+    }
+
+    const std::vector<VkCommandBuffer>& SecondaryCommandRecorder::record(VkRenderPass renderPass, uint32_t subpass, VkFramebuffer framebuffer,
+                                                                         uint32_t chunkCount, const RecordFunc& func) {
+        if (chunkCount > slotCount) chunkCount = slotCount;
+        recorded.assign(chunkCount, VK_NULL_HANDLE);
+        chunkResults.assign(chunkCount, ChunkResult{});
+
+        VkCommandBufferInheritanceInfo inheritanceInfo{};
+        inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+        inheritanceInfo.renderPass = renderPass;
+        inheritanceInfo.subpass = subpass;
+        inheritanceInfo.framebuffer = framebuffer;
+
+        // groupSize 1: satu chunk = satu job, thread pemanggil ikut record
+        Threading::JobSystem::Get().Dispatch(chunkCount, 1, [&](uint32_t chunk) {
+            ChunkResult& chunkResult = chunkResults[chunk];
+            VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+            chunkResult.result = acquire(slots[currentFrame * slotCount + chunk], commandBuffer);
+            if (chunkResult.result != VK_SUCCESS) {
+                chunkResult.error = "Failed to allocate secondary command buffer!";
+                return;
+            }
+
+            VkCommandBufferBeginInfo beginInfo{};
+            beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+            beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+            beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+            chunkResult.result = vkBeginCommandBuffer(commandBuffer, &beginInfo);
+            if (chunkResult.result != VK_SUCCESS) {
+                chunkResult.error = "Failed to begin secondary command buffer!";
+                return;
+            }
+            func(commandBuffer, chunk);
+            chunkResult.result = vkEndCommandBuffer(commandBuffer);
+            if (chunkResult.result != VK_SUCCESS) {
+                chunkResult.error = "Failed to record secondary command buffer!";
+                return;
+            }
+            recorded[chunk] = commandBuffer;
+        });
+
+        for (const ChunkResult& chunkResult : chunkResults) {
+            if (chunkResult.result != VK_SUCCESS) {
+                throw std::runtime_error(std::string(chunkResult.error) + " (VkResult " + std::to_string(static_cast<int>(chunkResult.result)) + ")");
+            }
+        }
+
+        return recorded;
+    }
+}
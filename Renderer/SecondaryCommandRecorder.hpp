@@ -0,0 +1,55 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <functional>
+#include <cstdint>
+#include "../Core/Graphics/GraphicsDevice.hpp"
+
+namespace Cogent::Renderer {
+
+    // [NEW] Record isi render pass secara paralel ke secondary command buffer di JobSystem.
+    // Satu VkCommandPool per (frame in flight, slot). Slot = index chunk di Dispatch: satu chunk hanya
+    // dikerjakan satu thread, jadi pool tidak pernah dipakai dua thread sekaligus (syarat Vulkan)
+    // tanpa perlu tahu thread ID worker. Pool di-reset utuh di beginFrame (setelah fence frame itu).
+    class SecondaryCommandRecorder {
+    public:
+        using RecordFunc = std::function<void(VkCommandBuffer commandBuffer, uint32_t chunk)>;
+
+        SecondaryCommandRecorder(GraphicsDevice& device, uint32_t framesInFlight, uint32_t slotCount);
+        ~SecondaryCommandRecorder();
+
+        // Reset semua pool milik frame ini. Panggil setelah fence frame tersebut selesai di-wait.
+        void beginFrame(uint32_t frameIndex);
+
+        // Record chunkCount secondary buffer (RENDER_PASS_CONTINUE) paralel, func(cmd, chunk) dipanggil
+        // di worker. Return buffer dalam urutan chunk, siap untuk vkCmdExecuteCommands.
+        // Render pass harus sudah di-begin dengan VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS.
+        const std::vector<VkCommandBuffer>& record(VkRenderPass renderPass, uint32_t subpass, VkFramebuffer framebuffer,
+                                                   uint32_t chunkCount, const RecordFunc& func);
+
+        uint32_t getSlotCount() const { return slotCount; }
+
+    private:
+        struct Slot {
+            VkCommandPool pool = VK_NULL_HANDLE;
+            std::vector<VkCommandBuffer> buffers; // Dialokasi sekali, dipakai ulang tiap frame
+            uint32_t used = 0;
+        };
+
+        // [FIX] Hasil Vulkan per chunk: job tidak throw, error dilempar di thread pemanggil setelah Dispatch
+        struct ChunkResult {
+            VkResult result = VK_SUCCESS;
+            const char* error = nullptr;
+        };
+
+        VkResult acquire(Slot& slot, VkCommandBuffer& commandBuffer);
+
+        GraphicsDevice& device;
+        uint32_t framesInFlight;
+        uint32_t slotCount;
+        uint32_t currentFrame = 0;
+        std::vector<Slot> slots; // [frame * slotCount + slot]
+        std::vector<VkCommandBuffer> recorded;
+        std::vector<ChunkResult> chunkResults;
+    };
+}
@@ -0,0 +1,107 @@
+#include "ShaderRegistry.hpp"
+#include "../Core/VulkanUtils.hpp"
+#include "../Core/Logger.hpp"
+#include "../Core/Threading/JobSystem.hpp"
+#include <stdexcept>
+
+namespace Cogent::Renderer {
+
+    static constexpr uint32_t SPIRV_MAGIC = 0x07230203;
+
+    void ShaderRegistry::Init(VkDevice vkDevice) {
+        device = vkDevice;
+    }
+
+    void ShaderRegistry::Shutdown() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& [path, module] : modules) {
+            vkDestroyShaderModule(device, module, nullptr);
+        }
+        modules.clear();
+    }
+
+    std::vector<uint32_t> ShaderRegistry::loadSpirv(const std::string& path) {
+        std::vector<char> bytes = VulkanUtils::readFile(path);
+        if (bytes.size() < sizeof(uint32_t) || bytes.size() % sizeof(uint32_t) != 0) {
+            throw std::runtime_error("ShaderRegistry: ukuran SPIR-V tidak valid: " + path);
+        }
+
+        // Salin ke buffer uint32 (pCode wajib 4-byte aligned)
+        std::vector<uint32_t> code(bytes.size() / sizeof(uint32_t));
+        std::memcpy(code.data(), bytes.data(), bytes.size());
+        if (code[0] != SPIRV_MAGIC) {
+            throw std::runtime_error("ShaderRegistry: bukan file SPIR-V: " + path);
+        }
+        return code;
+    }
+
+    VkShaderModule ShaderRegistry::createModule(const std::string& path, const std::vector<uint32_t>& code) {
+        VkShaderModuleCreateInfo createInfo{};
+        createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        createInfo.codeSize = code.size() * sizeof(uint32_t);
+        createInfo.pCode = code.data();
+
+        VkShaderModule module = VK_NULL_HANDLE;
+        if (vkCreateShaderModule(device, &createInfo, nullptr, &module) != VK_SUCCESS) {
+            throw std::runtime_error("ShaderRegistry: gagal membuat shader module: " + path);
+        }
+        modules[path] = module;
+        return module;
+    }
+
+    void ShaderRegistry::preload(const std::vector<std::string>& paths) {
+        std::vector<std::string> missing;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const std::string& path : paths) {
+                if (modules.find(path) == modules.end()) missing.push_back(path);
+            }
+        }
+        if (missing.empty()) return;
+
+        // I/O paralel; error per file dicatat, tidak dilempar dari worker
+        std::vector<std::vector<uint32_t>> codes(missing.size());
+        std::vector<std::string> errors(missing.size());
+        Cogent::Threading::JobSystem::Get().Dispatch(static_cast<uint32_t>(missing.size()), 1, [&](uint32_t i) {
+            try {
+                codes[i] = loadSpirv(missing[i]);
+            } catch (const std::exception& e) {
+                errors[i] = e.what();
+            }
+        });
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (size_t i = 0; i < missing.size(); i++) {
+            if (!errors[i].empty()) {
+                // Bukan fatal di sini: getModule() akan mencoba lagi dan melempar kalau memang dipakai
+                LOG_WARN("ShaderRegistry: preload gagal: " + errors[i]);
+                continue;
+            }
+            if (modules.find(missing[i]) == modules.end()) createModule(missing[i], codes[i]);
+        }
+        LOG_INFO("ShaderRegistry: preloaded " + std::to_string(modules.size()) + " shader modules");
+    }
+
+    VkShaderModule ShaderRegistry::getModule(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = modules.find(path);
+        if (it != modules.end()) return it->second;
+        return createModule(path, loadSpirv(path));
+    }
+
+    VkPipelineShaderStageCreateInfo ShaderRegistry::stage(VkShaderStageFlagBits stage, const std::string& path,
+                                                          const VkSpecializationInfo* specialization) {
+        VkPipelineShaderStageCreateInfo stageInfo{};
+        stageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+        stageInfo.stage = stage;
+        stageInfo.module = getModule(path);
+        stageInfo.pName = "main";
+        stageInfo.pSpecializationInfo = specialization;
+        return stageInfo;
+    }
+
+    size_t ShaderRegistry::getModuleCount() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return modules.size();
+    }
+}
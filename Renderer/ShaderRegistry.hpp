@@ -0,0 +1,81 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Cogent::Renderer {
+
+    // [NEW] Nilai specialization constant (layout(constant_id = N) di GLSL) untuk satu stage.
+    // Driver meng-compile pipeline dengan nilai ini sebagai konstanta: loop bisa di-unroll,
+    // cabang mati dibuang, tanpa compile ulang SPIR-V. Hanya tipe 4 byte (int, uint, float, VkBool32).
+    class SpecializationConstants {
+    public:
+        template<typename T>
+        SpecializationConstants& set(uint32_t constantID, const T& value) {
+            static_assert(sizeof(T) == 4 && std::is_trivially_copyable<T>::value, "Specialization constant harus 4 byte");
+            VkSpecializationMapEntry entry{};
+            entry.constantID = constantID;
+            entry.offset = static_cast<uint32_t>(data.size());
+            entry.size = sizeof(T);
+            entries.push_back(entry);
+            data.resize(data.size() + sizeof(T));
+            std::memcpy(data.data() + entry.offset, &value, sizeof(T));
+            return *this;
+        }
+
+        // Pointer valid selama object ini hidup dan tidak di-set lagi. nullptr kalau kosong.
+        const VkSpecializationInfo* get() {
+            if (entries.empty()) return nullptr;
+            info.mapEntryCount = static_cast<uint32_t>(entries.size());
+            info.pMapEntries = entries.data();
+            info.dataSize = data.size();
+            info.pData = data.data();
+            return &info;
+        }
+
+    private:
+        std::vector<VkSpecializationMapEntry> entries;
+        std::vector<uint8_t> data;
+        VkSpecializationInfo info{};
+    };
+
+    // [NEW] Satu tempat untuk semua shader module. SPIR-V dibaca + VkShaderModule dibuat sekali per
+    // path lalu di-cache sampai Shutdown, jadi pipeline yang dibuat ulang (resize, ganti variant
+    // kualitas) tidak membaca disk lagi. Thread-safe: pipeline startup dibuat paralel di JobSystem.
+    class ShaderRegistry {
+    public:
+        static ShaderRegistry& Get() {
+            static ShaderRegistry instance;
+            return instance;
+        }
+
+        void Init(VkDevice device);
+        void Shutdown(); // Destroy semua module (pipeline yang sudah jadi tidak butuh module lagi)
+
+        // Baca banyak file paralel (JobSystem) lalu buat module-nya. Path yang sudah ada di-skip.
+        void preload(const std::vector<std::string>& paths);
+
+        VkShaderModule getModule(const std::string& path);
+
+        // Shortcut VkPipelineShaderStageCreateInfo (entry point "main")
+        VkPipelineShaderStageCreateInfo stage(VkShaderStageFlagBits stage, const std::string& path,
+                                              const VkSpecializationInfo* specialization = nullptr);
+
+        size_t getModuleCount() const;
+
+    private:
+        ShaderRegistry() = default;
+
+        static std::vector<uint32_t> loadSpirv(const std::string& path);
+        VkShaderModule createModule(const std::string& path, const std::vector<uint32_t>& code); // Dipanggil dengan lock
+
+        VkDevice device = VK_NULL_HANDLE;
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, VkShaderModule> modules;
+    };
+}
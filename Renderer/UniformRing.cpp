@@ -0,0 +1,53 @@
+#include "UniformRing.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace Cogent::Renderer {
+
+    UniformRing::UniformRing(GraphicsDevice& device, uint32_t framesInFlight, VkDeviceSize frameSize)
+        : device(device), framesInFlight(framesInFlight > 0 ? framesInFlight : 1) {
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(device.getPhysicalDevice(), &properties);
+        // Satu ring juga dipakai untuk SSBO: ambil alignment terbesar
+        alignment = std::max<VkDeviceSize>(properties.limits.minUniformBufferOffsetAlignment,
+                                           properties.limits.minStorageBufferOffsetAlignment);
+        alignment = std::max<VkDeviceSize>(alignment, 16);
+        this->frameSize = (frameSize + alignment - 1) / alignment * alignment;
+
+        device.createBuffer(this->frameSize * this->framesInFlight,
+                            VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                            buffer, memory);
+
+        void* data = nullptr;
+        if (vkMapMemory(device.getDevice(), memory, 0, VK_WHOLE_SIZE, 0, &data) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to map Uniform Ring!");
+        }
+        mapped = static_cast<char*>(data);
+    }
+
+    UniformRing::~UniformRing() {
+        if (memory) vkUnmapMemory(device.getDevice(), memory);
+        if (buffer) vkDestroyBuffer(device.getDevice(), buffer, nullptr);
+        if (memory) vkFreeMemory(device.getDevice(), memory, nullptr);
+    }
+
+    void UniformRing::beginFrame(uint32_t frameIndex) {
+        frameBase = frameSize * (frameIndex % framesInFlight);
+        head.store(0, std::memory_order_relaxed);
+    }
+
+    UniformRing::Allocation UniformRing::allocate(VkDeviceSize size) {
+        const VkDeviceSize alignedSize = (size + alignment - 1) / alignment * alignment;
+        const VkDeviceSize offset = head.fetch_add(alignedSize, std::memory_order_relaxed);
+        if (offset + alignedSize > frameSize) {
+            throw std::runtime_error("UniformRing: frame budget exceeded (" + std::to_string(frameSize) + " bytes)");
+        }
+
+        Allocation allocation;
+        allocation.data = mapped + frameBase + offset;
+        allocation.offset = static_cast<uint32_t>(frameBase + offset);
+        return allocation;
+    }
+}
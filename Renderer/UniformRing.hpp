@@ -0,0 +1,56 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include "../Core/Graphics/GraphicsDevice.hpp"
+
+namespace Cogent::Renderer {
+
+    // [NEW] Linear allocator uniform/storage per frame di satu buffer persistently mapped.
+    // Buffer dibagi framesInFlight region; tiap frame bump-allocate slice yang sudah di-align ke
+    // minUniformBufferOffsetAlignment, lalu bind lewat dynamic offset (descriptor set cukup satu,
+    // tidak per frame). Region di-reset di beginFrame setelah fence frame itu di-wait -> tanpa
+    // map/unmap per frame dan tanpa menulis memory yang masih dibaca GPU.
+    class UniformRing {
+    public:
+        static constexpr VkDeviceSize DEFAULT_FRAME_SIZE = 256 * 1024;
+
+        struct Allocation {
+            void* data = nullptr;
+            uint32_t offset = 0; // Dynamic offset (dari awal buffer)
+        };
+
+        UniformRing(GraphicsDevice& device, uint32_t framesInFlight, VkDeviceSize frameSize = DEFAULT_FRAME_SIZE);
+        ~UniformRing();
+
+        void beginFrame(uint32_t frameIndex);
+
+        // Thread-safe (atomic bump). Throw kalau budget frame habis.
+        Allocation allocate(VkDeviceSize size);
+
+        template<typename T>
+        uint32_t push(const T& value) {
+            Allocation allocation = allocate(sizeof(T));
+            std::memcpy(allocation.data, &value, sizeof(T));
+            return allocation.offset;
+        }
+
+        VkBuffer getBuffer() const { return buffer; }
+        VkDeviceSize getAlignment() const { return alignment; }
+        VkDeviceSize getFrameUsage() const { return head.load(std::memory_order_relaxed); }
+
+    private:
+        GraphicsDevice& device;
+        uint32_t framesInFlight;
+        VkDeviceSize frameSize;
+        VkDeviceSize alignment = 256;
+
+        VkBuffer buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        char* mapped = nullptr;
+
+        VkDeviceSize frameBase = 0;
+        std::atomic<VkDeviceSize> head{0}; // Byte terpakai di region frame ini
+    };
+}
@@ -0,0 +1,339 @@
+#include "BVH.hpp"
+#include "../../Core/Threading/JobSystem.hpp"
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace Cogent::Renderer {
+
+    namespace {
+        Math::AABB emptyBox() {
+            const float inf = std::numeric_limits<float>::max();
+            return { glm::vec3(inf), glm::vec3(-inf) };
+        }
+
+        void grow(Math::AABB& box, const Math::AABB& other) {
+            box.min = glm::min(box.min, other.min);
+            box.max = glm::max(box.max, other.max);
+        }
+
+        float surfaceArea(const Math::AABB& box) {
+            const glm::vec3 e = box.max - box.min;
+            if (e.x < 0.0f || e.y < 0.0f || e.z < 0.0f) return 0.0f;
+            return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+        }
+
+        bool overlaps(const Math::AABB& a, const Math::AABB& b) {
+            return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+                   a.min.y <= b.max.y && a.max.y >= b.min.y &&
+                   a.min.z <= b.max.z && a.max.z >= b.min.z;
+        }
+
+        // Slab test, return jarak masuk (>= 0) atau -1 kalau miss / lebih jauh dari maxDistance
+        float intersectRay(const glm::vec3& origin, const glm::vec3& invDir, const Math::AABB& box, float maxDistance) {
+            const glm::vec3 t1 = (box.min - origin) * invDir;
+            const glm::vec3 t2 = (box.max - origin) * invDir;
+            const float tNear = std::max({ std::min(t1.x, t2.x), std::min(t1.y, t2.y), std::min(t1.z, t2.z) });
+            const float tFar = std::min({ std::max(t1.x, t2.x), std::max(t1.y, t2.y), std::max(t1.z, t2.z) });
+            if (tFar < 0.0f || tNear > tFar || tNear > maxDistance) return -1.0f;
+            return std::max(tNear, 0.0f);
+        }
+    }
+
+    void BVH::build(const std::vector<Math::AABB>& boxes) {
+        objectCount = static_cast<uint32_t>(boxes.size());
+        nodes.clear();
+        levels.clear();
+        nodePlaneCache.clear(); // Layout node berubah, cache per node tidak valid lagi
+        objectIndices.resize(objectCount);
+        leafBoxes.resize(objectCount);
+        std::iota(objectIndices.begin(), objectIndices.end(), 0u);
+        if (objectCount == 0) {
+            buildRootArea = 0.0f;
+            return;
+        }
+
+        std::vector<glm::vec3> centroids(objectCount);
+        for (uint32_t i = 0; i < objectCount; ++i) centroids[i] = boxes[i].getCenter();
+
+        nodes.reserve(objectCount * 2 - 1);
+        nodes.emplace_back();
+        nodes[0].leftOrFirst = 0;
+        nodes[0].count = objectCount;
+        subdivide(0, boxes, centroids, 0);
+        for (uint32_t i = 0; i < objectCount; ++i) leafBoxes[i] = boxes[objectIndices[i]];
+
+        buildRootArea = surfaceArea(nodes[0].bounds);
+    }
+
+    void BVH::updateLeafBounds(Node& node, const std::vector<Math::AABB>& boxes) {
+        node.bounds = emptyBox();
+        for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i) {
+            leafBoxes[i] = boxes[objectIndices[i]];
+            grow(node.bounds, leafBoxes[i]);
+        }
+    }
+
+    void BVH::subdivide(uint32_t nodeIndex, const std::vector<Math::AABB>& boxes, const std::vector<glm::vec3>& centroids, uint32_t depth) {
+        if (levels.size() <= depth) levels.resize(depth + 1);
+        levels[depth].push_back(nodeIndex);
+
+        const uint32_t first = nodes[nodeIndex].leftOrFirst;
+        const uint32_t count = nodes[nodeIndex].count;
+        nodes[nodeIndex].bounds = emptyBox();
+        for (uint32_t i = first; i < first + count; ++i) grow(nodes[nodeIndex].bounds, boxes[objectIndices[i]]);
+        if (count <= MAX_LEAF_SIZE) return;
+
+        Math::AABB centroidBounds = { centroids[objectIndices[first]], centroids[objectIndices[first]] };
+        for (uint32_t i = first; i < first + count; ++i) {
+            centroidBounds.min = glm::min(centroidBounds.min, centroids[objectIndices[i]]);
+            centroidBounds.max = glm::max(centroidBounds.max, centroids[objectIndices[i]]);
+        }
+
+        // Binned SAH: cost = areaKiri * countKiri + areaKanan * countKanan
+        float bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        uint32_t bestSplit = 0;
+
+        for (int axis = 0; axis < 3; ++axis) {
+            const float extent = centroidBounds.max[axis] - centroidBounds.min[axis];
+            if (extent <= 0.0f) continue;
+
+            Math::AABB binBounds[SAH_BINS];
+            uint32_t binCounts[SAH_BINS] = {};
+            for (auto& b : binBounds) b = emptyBox();
+
+            const float scale = SAH_BINS / extent;
+            for (uint32_t i = first; i < first + count; ++i) {
+                const uint32_t object = objectIndices[i];
+                const uint32_t bin = std::min(SAH_BINS - 1, static_cast<uint32_t>((centroids[object][axis] - centroidBounds.min[axis]) * scale));
+                binCounts[bin]++;
+                grow(binBounds[bin], boxes[object]);
+            }
+
+            float leftArea[SAH_BINS - 1], rightArea[SAH_BINS - 1];
+            uint32_t leftCount[SAH_BINS - 1], rightCount[SAH_BINS - 1];
+            Math::AABB leftBox = emptyBox(), rightBox = emptyBox();
+            uint32_t leftSum = 0, rightSum = 0;
+            for (uint32_t i = 0; i < SAH_BINS - 1; ++i) {
+                leftSum += binCounts[i];
+                grow(leftBox, binBounds[i]);
+                leftCount[i] = leftSum;
+                leftArea[i] = surfaceArea(leftBox);
+
+                rightSum += binCounts[SAH_BINS - 1 - i];
+                grow(rightBox, binBounds[SAH_BINS - 1 - i]);
+                rightCount[SAH_BINS - 2 - i] = rightSum;
+                rightArea[SAH_BINS - 2 - i] = surfaceArea(rightBox);
+            }
+
+            for (uint32_t i = 0; i < SAH_BINS - 1; ++i) {
+                if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+                const float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i + 1;
+                }
+            }
+        }
+
+        // Semua centroid sama -> tidak bisa di-split, jadikan leaf besar
+        if (bestAxis < 0) return;
+
+        const float leafCost = count * surfaceArea(nodes[nodeIndex].bounds);
+        if (bestCost >= leafCost && count <= MAX_LEAF_SIZE * 4) return;
+
+        const float extent = centroidBounds.max[bestAxis] - centroidBounds.min[bestAxis];
+        const float scale = SAH_BINS / extent;
+        const float axisMin = centroidBounds.min[bestAxis];
+        auto middle = std::partition(objectIndices.begin() + first, objectIndices.begin() + first + count, [&](uint32_t object) {
+            return std::min(SAH_BINS - 1, static_cast<uint32_t>((centroids[object][bestAxis] - axisMin) * scale)) < bestSplit;
+        });
+        const uint32_t leftCountFinal = static_cast<uint32_t>(middle - (objectIndices.begin() + first));
+        if (leftCountFinal == 0 || leftCountFinal == count) return;
+
+        const uint32_t leftIndex = static_cast<uint32_t>(nodes.size());
+        nodes.emplace_back();
+        nodes.emplace_back();
+        nodes[leftIndex].leftOrFirst = first;
+        nodes[leftIndex].count = leftCountFinal;
+        nodes[leftIndex + 1].leftOrFirst = first + leftCountFinal;
+        nodes[leftIndex + 1].count = count - leftCountFinal;
+
+        nodes[nodeIndex].leftOrFirst = leftIndex;
+        nodes[nodeIndex].count = 0;
+
+        subdivide(leftIndex, boxes, centroids, depth + 1);
+        subdivide(leftIndex + 1, boxes, centroids, depth + 1);
+    }
+
+    void BVH::refit(const std::vector<Math::AABB>& boxes) {
+        if (boxes.size() != objectCount) {
+            build(boxes);
+            return;
+        }
+
+        // Level terdalam dulu: node di satu level saling independen -> paralel
+        for (size_t level = levels.size(); level-- > 0;) {
+            const std::vector<uint32_t>& levelNodes = levels[level];
+            Threading::JobSystem::Get().Dispatch(static_cast<uint32_t>(levelNodes.size()), 256, [&](uint32_t i) {
+                Node& node = nodes[levelNodes[i]];
+                if (node.isLeaf()) {
+                    updateLeafBounds(node, boxes);
+                } else {
+                    node.bounds = nodes[node.leftOrFirst].bounds;
+                    grow(node.bounds, nodes[node.leftOrFirst + 1].bounds);
+                }
+            });
+        }
+    }
+
+    bool BVH::needsRebuild() const {
+        if (nodes.empty()) return objectCount > 0;
+        return surfaceArea(nodes[0].bounds) > buildRootArea * 2.0f;
+    }
+
+    void BVH::collectSubtree(uint32_t nodeIndex, std::vector<uint32_t>& outIndices) const {
+        std::vector<uint32_t> stack;
+        stack.reserve(64);
+        stack.push_back(nodeIndex);
+
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            if (node.isLeaf()) {
+                outIndices.insert(outIndices.end(), objectIndices.begin() + node.leftOrFirst,
+                                  objectIndices.begin() + node.leftOrFirst + node.count);
+            } else {
+                stack.push_back(node.leftOrFirst);
+                stack.push_back(node.leftOrFirst + 1);
+            }
+        }
+    }
+
+    void BVH::queryFrustum(const Math::Frustum& frustum, std::vector<uint32_t>& outIndices) {
+        lastQueryStats = QueryStats{};
+        if (nodes.empty()) return;
+
+        nodePlaneCache.resize(nodes.size(), 0);
+        objectPlaneCache.resize(objectCount, 0);
+
+        struct Entry {
+            uint32_t node;
+            uint32_t planeMask;
+        };
+        std::vector<Entry> stack;
+        stack.reserve(64);
+        stack.push_back({ 0, Math::Frustum::ALL_PLANES });
+
+        uint8_t scratchPlane = 0;
+        while (!stack.empty()) {
+            const Entry entry = stack.back();
+            stack.pop_back();
+            const Node& node = nodes[entry.node];
+            lastQueryStats.nodesVisited++;
+
+            // Tanpa coherence: semua plane dites, urutan tetap
+            const uint32_t inMask = temporalCoherence ? entry.planeMask : Math::Frustum::ALL_PLANES;
+            uint8_t& nodeCache = temporalCoherence ? nodePlaneCache[entry.node] : (scratchPlane = 0);
+
+            uint32_t childMask = 0;
+            const Math::Intersection result = frustum.classifyAABB(node.bounds, inMask, childMask, nodeCache, &lastQueryStats.planeTests);
+            if (result == Math::Intersection::Outside) continue;
+            if (result == Math::Intersection::Inside) {
+                collectSubtree(entry.node, outIndices);
+                continue;
+            }
+
+            if (node.isLeaf()) {
+                for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i) {
+                    const uint32_t object = objectIndices[i];
+                    uint8_t& objectCache = temporalCoherence ? objectPlaneCache[object] : (scratchPlane = 0);
+                    uint32_t objectMask = 0;
+                    const uint32_t leafMask = temporalCoherence ? childMask : Math::Frustum::ALL_PLANES;
+                    if (frustum.classifyAABB(leafBoxes[i], leafMask, objectMask, objectCache, &lastQueryStats.planeTests) != Math::Intersection::Outside) {
+                        outIndices.push_back(object);
+                    }
+                }
+            } else {
+                stack.push_back({ node.leftOrFirst, childMask });
+                stack.push_back({ node.leftOrFirst + 1, childMask });
+            }
+        }
+    }
+
+    void BVH::queryOverlap(const Math::AABB& box, std::vector<uint32_t>& outIndices) const {
+        if (nodes.empty()) return;
+
+        std::vector<uint32_t> stack;
+        stack.reserve(64);
+        stack.push_back(0);
+
+        while (!stack.empty()) {
+            const Node& node = nodes[stack.back()];
+            stack.pop_back();
+            if (!overlaps(node.bounds, box)) continue;
+
+            if (node.isLeaf()) {
+                for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i) {
+                    if (overlaps(leafBoxes[i], box)) outIndices.push_back(objectIndices[i]);
+                }
+            } else {
+                stack.push_back(node.leftOrFirst);
+                stack.push_back(node.leftOrFirst + 1);
+            }
+        }
+    }
+
+    BVH::RayHit BVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+        RayHit hit;
+        if (nodes.empty()) return hit;
+
+        const glm::vec3 invDir(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+        float closest = maxDistance;
+
+        // [FIX] Entry t disimpan bersama node: hit yang ditemukan setelah push bisa membuat node
+        // di stack tidak relevan lagi, jadi dicek ulang saat pop tanpa tes AABB kedua
+        struct StackEntry {
+            uint32_t node;
+            float tEntry;
+        };
+        std::vector<StackEntry> stack;
+        stack.reserve(64);
+        const float tRoot = intersectRay(origin, invDir, nodes[0].bounds, closest);
+        if (tRoot >= 0.0f) stack.push_back({ 0, tRoot });
+
+        while (!stack.empty()) {
+            const StackEntry entry = stack.back();
+            stack.pop_back();
+            if (hit.objectIndex >= 0 && entry.tEntry >= closest) continue; // Masuk setelah hit terdekat
+            const Node& node = nodes[entry.node];
+
+            if (node.isLeaf()) {
+                for (uint32_t i = node.leftOrFirst; i < node.leftOrFirst + node.count; ++i) {
+                    const float t = intersectRay(origin, invDir, leafBoxes[i], closest);
+                    if (t >= 0.0f && (hit.objectIndex < 0 || t < closest)) {
+                        closest = t;
+                        hit.objectIndex = static_cast<int>(objectIndices[i]);
+                        hit.distance = t;
+                    }
+                }
+                continue;
+            }
+
+            // Anak terdekat di-push terakhir supaya diproses duluan (closest cepat mengecil)
+            uint32_t nearChild = node.leftOrFirst;
+            uint32_t farChild = node.leftOrFirst + 1;
+            float tNear = intersectRay(origin, invDir, nodes[nearChild].bounds, closest);
+            float tFar = intersectRay(origin, invDir, nodes[farChild].bounds, closest);
+            if (tFar >= 0.0f && (tNear < 0.0f || tFar < tNear)) {
+                std::swap(nearChild, farChild);
+                std::swap(tNear, tFar);
+            }
+            if (tFar >= 0.0f) stack.push_back({ farChild, tFar });
+            if (tNear >= 0.0f) stack.push_back({ nearChild, tNear });
+        }
+        return hit;
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../../Core/Math/Frustum.hpp"
+
+namespace Cogent::Renderer {
+
+    // [NEW] BVH over world AABB object scene (binned SAH build + incremental refit).
+    // Node disimpan flat; anak kiri/kanan selalu bersebelahan (left, left + 1).
+    // Leaf menunjuk range di objectIndices. Refit paralel per level (bawah -> atas).
+    class BVH {
+    public:
+        static constexpr uint32_t MAX_LEAF_SIZE = 4;
+        static constexpr uint32_t SAH_BINS = 12;
+
+        struct Node {
+            Math::AABB bounds;
+            uint32_t leftOrFirst = 0; // interior: index anak kiri, leaf: index pertama di objectIndices
+            uint32_t count = 0;       // 0 = interior
+            bool isLeaf() const { return count > 0; }
+        };
+
+        struct RayHit {
+            int objectIndex = -1;
+            float distance = 0.0f;
+        };
+
+        // Build penuh dari box per object (index box = index object)
+        void build(const std::vector<Math::AABB>& boxes);
+        // Update bounds node dari box baru (jumlah object harus sama dengan saat build)
+        void refit(const std::vector<Math::AABB>& boxes);
+        // Refit bikin tree longgar kalau object banyak bergerak; rebuild kalau root tumbuh > 2x area build
+        bool needsRebuild() const;
+
+        struct QueryStats {
+            uint32_t nodesVisited = 0;
+            uint32_t planeTests = 0;
+        };
+
+        // Frustum: subtree yang sepenuhnya di dalam langsung diterima tanpa test per object.
+        // [NEW] Plane mask diwariskan parent -> anak, dan plane yang terakhir menolak node/object
+        // dites pertama di frame berikutnya (kamera bergerak pelan = hampir selalu reject di test pertama).
+        void queryFrustum(const Math::Frustum& frustum, std::vector<uint32_t>& outIndices);
+        void setTemporalCoherence(bool enabled) { temporalCoherence = enabled; }
+        const QueryStats& getLastQueryStats() const { return lastQueryStats; }
+        void queryOverlap(const Math::AABB& box, std::vector<uint32_t>& outIndices) const;
+        // Hit terdekat terhadap AABB object (untuk editor picking)
+        RayHit raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = 1e30f) const;
+
+        bool empty() const { return nodes.empty(); }
+        uint32_t getObjectCount() const { return objectCount; }
+        uint32_t getNodeCount() const { return static_cast<uint32_t>(nodes.size()); }
+        const std::vector<Node>& getNodes() const { return nodes; }
+
+    private:
+        void subdivide(uint32_t nodeIndex, const std::vector<Math::AABB>& boxes, const std::vector<glm::vec3>& centroids, uint32_t depth);
+        void updateLeafBounds(Node& node, const std::vector<Math::AABB>& boxes);
+        void collectSubtree(uint32_t nodeIndex, std::vector<uint32_t>& outIndices) const;
+
+        std::vector<Node> nodes;
+        std::vector<uint32_t> objectIndices;
+        std::vector<Math::AABB> leafBoxes;          // Box object dalam urutan objectIndices (cache-friendly di leaf)
+        std::vector<std::vector<uint32_t>> levels; // node index per depth, untuk refit bottom-up
+        uint32_t objectCount = 0;
+        float buildRootArea = 0.0f;
+
+        // Cache plane penolak terakhir per node / per object (index object, bertahan lintas rebuild)
+        std::vector<uint8_t> nodePlaneCache;
+        std::vector<uint8_t> objectPlaneCache;
+        bool temporalCoherence = true;
+        QueryStats lastQueryStats;
+    };
+}
@@ -0,0 +1,203 @@
+#include "CullingKernels.hpp"
+#include "../../Core/Threading/JobSystem.hpp"
+#include <atomic>
+#include <cmath>
+
+namespace Cogent::Renderer {
+
+    void BoundsSoA::resize(uint32_t newCount) {
+        count = newCount;
+        const size_t padded = static_cast<size_t>(wordCount()) * BOXES_PER_WORD;
+        // Padding box: extent 0 di origin, bit-nya di-mask di cullParallel
+        centerX.resize(padded, 0.0f); centerY.resize(padded, 0.0f); centerZ.resize(padded, 0.0f);
+        extentX.resize(padded, 0.0f); extentY.resize(padded, 0.0f); extentZ.resize(padded, 0.0f);
+    }
+
+    namespace {
+        // Plane dalam layout SoA + |normal| untuk radius proyeksi extent
+        struct PlaneSet {
+            float nx[6], ny[6], nz[6], d[6];
+            float ax[6], ay[6], az[6];
+
+            explicit PlaneSet(const Math::Frustum& frustum) {
+                for (int p = 0; p < 6; ++p) {
+                    const Math::Plane& plane = frustum.planes[p];
+                    nx[p] = plane.normal.x; ny[p] = plane.normal.y; nz[p] = plane.normal.z;
+                    d[p] = plane.distance;
+                    ax[p] = std::fabs(plane.normal.x); ay[p] = std::fabs(plane.normal.y); az[p] = std::fabs(plane.normal.z);
+                }
+            }
+        };
+
+        std::atomic<int> g_activeLevel{ -1 };
+    }
+
+    namespace CullingKernels {
+
+        // Center/extent: box di luar plane kalau dot(n, c) + d + dot(|n|, e) < 0
+        // (sama dengan p-vertex test di Frustum::checkAABB)
+        void cullScalar(const Math::Frustum& frustum, const BoundsSoA& bounds, uint32_t firstWord, uint32_t wordCount, uint64_t* mask) {
+            const PlaneSet planes(frustum);
+            for (uint32_t w = firstWord; w < firstWord + wordCount; ++w) {
+                uint64_t bits = 0;
+                const uint32_t base = w * BoundsSoA::BOXES_PER_WORD;
+                for (uint32_t j = 0; j < BoundsSoA::BOXES_PER_WORD; ++j) {
+                    const uint32_t i = base + j;
+                    bool inside = true;
+                    for (int p = 0; p < 6 && inside; ++p) {
+                        const float dist = planes.nx[p] * bounds.centerX[i] + planes.ny[p] * bounds.centerY[i] + planes.nz[p] * bounds.centerZ[i] + planes.d[p];
+                        const float radius = planes.ax[p] * bounds.extentX[i] + planes.ay[p] * bounds.extentY[i] + planes.az[p] * bounds.extentZ[i];
+                        inside = dist + radius >= 0.0f;
+                    }
+                    if (inside) bits |= (uint64_t(1) << j);
+                }
+                mask[w] = bits;
+            }
+        }
+
+#if COGENT_SIMD_SSE2
+        void cullSSE(const Math::Frustum& frustum, const BoundsSoA& bounds, uint32_t firstWord, uint32_t wordCount, uint64_t* mask) {
+            const PlaneSet planes(frustum);
+            const __m128 zero = _mm_setzero_ps();
+            for (uint32_t w = firstWord; w < firstWord + wordCount; ++w) {
+                uint64_t bits = 0;
+                const uint32_t base = w * BoundsSoA::BOXES_PER_WORD;
+                for (uint32_t j = 0; j < BoundsSoA::BOXES_PER_WORD; j += 4) {
+                    const uint32_t i = base + j;
+                    const __m128 cx = _mm_loadu_ps(&bounds.centerX[i]);
+                    const __m128 cy = _mm_loadu_ps(&bounds.centerY[i]);
+                    const __m128 cz = _mm_loadu_ps(&bounds.centerZ[i]);
+                    const __m128 ex = _mm_loadu_ps(&bounds.extentX[i]);
+                    const __m128 ey = _mm_loadu_ps(&bounds.extentY[i]);
+                    const __m128 ez = _mm_loadu_ps(&bounds.extentZ[i]);
+
+                    __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+                    for (int p = 0; p < 6; ++p) {
+                        __m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.nx[p]), cx), _mm_set1_ps(planes.d[p]));
+                        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(planes.ny[p]), cy));
+                        dist = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(planes.nz[p]), cz));
+                        __m128 radius = _mm_mul_ps(_mm_set1_ps(planes.ax[p]), ex);
+                        radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(planes.ay[p]), ey));
+                        radius = _mm_add_ps(radius, _mm_mul_ps(_mm_set1_ps(planes.az[p]), ez));
+                        inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, radius), zero));
+                    }
+                    bits |= static_cast<uint64_t>(_mm_movemask_ps(inside)) << j;
+                }
+                mask[w] = bits;
+            }
+        }
+
+        COGENT_TARGET_AVX2
+        void cullAVX2(const Math::Frustum& frustum, const BoundsSoA& bounds, uint32_t firstWord, uint32_t wordCount, uint64_t* mask) {
+            const PlaneSet planes(frustum);
+            const __m256 zero = _mm256_setzero_ps();
+            for (uint32_t w = firstWord; w < firstWord + wordCount; ++w) {
+                uint64_t bits = 0;
+                const uint32_t base = w * BoundsSoA::BOXES_PER_WORD;
+                for (uint32_t j = 0; j < BoundsSoA::BOXES_PER_WORD; j += 8) {
+                    const uint32_t i = base + j;
+                    const __m256 cx = _mm256_loadu_ps(&bounds.centerX[i]);
+                    const __m256 cy = _mm256_loadu_ps(&bounds.centerY[i]);
+                    const __m256 cz = _mm256_loadu_ps(&bounds.centerZ[i]);
+                    const __m256 ex = _mm256_loadu_ps(&bounds.extentX[i]);
+                    const __m256 ey = _mm256_loadu_ps(&bounds.extentY[i]);
+                    const __m256 ez = _mm256_loadu_ps(&bounds.extentZ[i]);
+
+                    __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+                    for (int p = 0; p < 6; ++p) {
+                        __m256 dist = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.nx[p]), cx), _mm256_set1_ps(planes.d[p]));
+                        dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(planes.ny[p]), cy));
+                        dist = _mm256_add_ps(dist, _mm256_mul_ps(_mm256_set1_ps(planes.nz[p]), cz));
+                        __m256 radius = _mm256_mul_ps(_mm256_set1_ps(planes.ax[p]), ex);
+                        radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(planes.ay[p]), ey));
+                        radius = _mm256_add_ps(radius, _mm256_mul_ps(_mm256_set1_ps(planes.az[p]), ez));
+                        inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(dist, radius), zero, _CMP_GE_OQ));
+                    }
+                    bits |= static_cast<uint64_t>(_mm256_movemask_ps(inside)) << j;
+                }
+                mask[w] = bits;
+            }
+        }
+
+        COGENT_TARGET_AVX512
+        void cullAVX512(const Math::Frustum& frustum, const BoundsSoA& bounds, uint32_t firstWord, uint32_t wordCount, uint64_t* mask) {
+            const PlaneSet planes(frustum);
+            const __m512 zero = _mm512_setzero_ps();
+            for (uint32_t w = firstWord; w < firstWord + wordCount; ++w) {
+                uint64_t bits = 0;
+                const uint32_t base = w * BoundsSoA::BOXES_PER_WORD;
+                for (uint32_t j = 0; j < BoundsSoA::BOXES_PER_WORD; j += 16) {
+                    const uint32_t i = base + j;
+                    const __m512 cx = _mm512_loadu_ps(&bounds.centerX[i]);
+                    const __m512 cy = _mm512_loadu_ps(&bounds.centerY[i]);
+                    const __m512 cz = _mm512_loadu_ps(&bounds.centerZ[i]);
+                    const __m512 ex = _mm512_loadu_ps(&bounds.extentX[i]);
+                    const __m512 ey = _mm512_loadu_ps(&bounds.extentY[i]);
+                    const __m512 ez = _mm512_loadu_ps(&bounds.extentZ[i]);
+
+                    __mmask16 inside = 0xFFFF;
+                    for (int p = 0; p < 6; ++p) {
+                        __m512 dist = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(planes.nx[p]), cx), _mm512_set1_ps(planes.d[p]));
+                        dist = _mm512_add_ps(dist, _mm512_mul_ps(_mm512_set1_ps(planes.ny[p]), cy));
+                        dist = _mm512_add_ps(dist, _mm512_mul_ps(_mm512_set1_ps(planes.nz[p]), cz));
+                        __m512 radius = _mm512_mul_ps(_mm512_set1_ps(planes.ax[p]), ex);
+                        radius = _mm512_add_ps(radius, _mm512_mul_ps(_mm512_set1_ps(planes.ay[p]), ey));
+                        radius = _mm512_add_ps(radius, _mm512_mul_ps(_mm512_set1_ps(planes.az[p]), ez));
+                        inside = _mm512_mask_cmp_ps_mask(inside, _mm512_add_ps(dist, radius), zero, _CMP_GE_OQ);
+                    }
+                    bits |= static_cast<uint64_t>(inside) << j;
+                }
+                mask[w] = bits;
+            }
+        }
+#endif
+
+        Math::Simd::Level getActiveLevel() {
+            int level = g_activeLevel.load(std::memory_order_relaxed);
+            if (level < 0) {
+                level = static_cast<int>(Math::Simd::detectLevel());
+                g_activeLevel.store(level, std::memory_order_relaxed);
+            }
+            return static_cast<Math::Simd::Level>(level);
+        }
+
+        void setActiveLevel(Math::Simd::Level level) {
+            const Math::Simd::Level supported = Math::Simd::detectLevel();
+            if (static_cast<int>(level) > static_cast<int>(supported)) level = supported;
+            g_activeLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+        }
+
+        FrustumCullKernel getKernel(Math::Simd::Level level) {
+            switch (level) {
+#if COGENT_SIMD_SSE2
+                case Math::Simd::Level::AVX512: return &cullAVX512;
+                case Math::Simd::Level::AVX2:   return &cullAVX2;
+                case Math::Simd::Level::SSE2:   return &cullSSE;
+#endif
+                default:                        return &cullScalar;
+            }
+        }
+
+        void cullParallel(const Math::Frustum& frustum, const BoundsSoA& bounds, std::vector<uint64_t>& mask) {
+            const uint32_t words = bounds.wordCount();
+            mask.resize(words);
+            if (words == 0) return;
+
+            // 256 word (16K box) per job: cukup besar supaya overhead dispatch tidak dominan
+            constexpr uint32_t WORDS_PER_JOB = 256;
+            const FrustumCullKernel kernel = getKernel(getActiveLevel());
+            const uint32_t jobCount = (words + WORDS_PER_JOB - 1) / WORDS_PER_JOB;
+
+            Threading::JobSystem::Get().Dispatch(jobCount, 1, [&](uint32_t job) {
+                const uint32_t firstWord = job * WORDS_PER_JOB;
+                const uint32_t count = (firstWord + WORDS_PER_JOB < words) ? WORDS_PER_JOB : words - firstWord;
+                kernel(frustum, bounds, firstWord, count, mask.data());
+            });
+
+            const uint32_t tail = bounds.count % BoundsSoA::BOXES_PER_WORD;
+            if (tail != 0) {
+                mask[words - 1] &= (uint64_t(1) << tail) - 1;
+            }
+        }
+    }
+}
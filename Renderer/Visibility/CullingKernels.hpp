@@ -0,0 +1,55 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../../Core/Math/Frustum.hpp"
+#include "../../Core/Math/Simd.hpp"
+
+namespace Cogent::Renderer {
+
+    // [NEW] Bounds dalam layout SoA (center/extent per axis) untuk kernel frustum SIMD.
+    // Kapasitas di-pad ke kelipatan 64 supaya satu word bitmask = 64 box penuh tanpa tail handling.
+    struct BoundsSoA {
+        static constexpr uint32_t BOXES_PER_WORD = 64;
+
+        std::vector<float> centerX, centerY, centerZ;
+        std::vector<float> extentX, extentY, extentZ;
+        uint32_t count = 0;
+
+        void resize(uint32_t newCount);
+        void set(uint32_t index, const glm::vec3& aabbMin, const glm::vec3& aabbMax) {
+            centerX[index] = (aabbMin.x + aabbMax.x) * 0.5f;
+            centerY[index] = (aabbMin.y + aabbMax.y) * 0.5f;
+            centerZ[index] = (aabbMin.z + aabbMax.z) * 0.5f;
+            extentX[index] = (aabbMax.x - aabbMin.x) * 0.5f;
+            extentY[index] = (aabbMax.y - aabbMin.y) * 0.5f;
+            extentZ[index] = (aabbMax.z - aabbMin.z) * 0.5f;
+        }
+
+        uint32_t wordCount() const { return (count + BOXES_PER_WORD - 1) / BOXES_PER_WORD; }
+    };
+
+    // Kernel: test box [firstWord*64, (firstWord+wordCount)*64) terhadap 6 plane,
+    // tulis bit 1 = visible ke mask[firstWord..]. Tidak menyentuh word lain -> aman di-split per thread.
+    using FrustumCullKernel = void(*)(const Math::Frustum& frustum, const BoundsSoA& bounds,
+                                      uint32_t firstWord, uint32_t wordCount, uint64_t* mask);
+
+    namespace CullingKernels {
+        // Referensi scalar (hasil harus identik dengan Frustum::checkAABB)
+        void cullScalar(const Math::Frustum& frustum, const BoundsSoA& bounds, uint32_t firstWord, uint32_t wordCount, uint64_t* mask);
+#if COGENT_SIMD_SSE2
+        void cullSSE(const Math::Frustum& frustum, const BoundsSoA& bounds, uint32_t firstWord, uint32_t wordCount, uint64_t* mask);
+        void cullAVX2(const Math::Frustum& frustum, const BoundsSoA& bounds, uint32_t firstWord, uint32_t wordCount, uint64_t* mask);
+        void cullAVX512(const Math::Frustum& frustum, const BoundsSoA& bounds, uint32_t firstWord, uint32_t wordCount, uint64_t* mask);
+#endif
+
+        // Kernel terbaik untuk CPU ini (cpuid sekali, lalu di-cache)
+        Math::Simd::Level getActiveLevel();
+        void setActiveLevel(Math::Simd::Level level); // di-clamp ke level yang didukung
+        FrustumCullKernel getKernel(Math::Simd::Level level);
+
+        // Cull semua bounds secara paralel di JobSystem. mask di-resize ke bounds.wordCount(),
+        // bit di luar bounds.count selalu 0.
+        void cullParallel(const Math::Frustum& frustum, const BoundsSoA& bounds, std::vector<uint64_t>& mask);
+    }
+}
@@ -0,0 +1,465 @@
+#include "GpuCullingPass.hpp"
+#include "../../Core/VulkanUtils.hpp"
+#include "../ShaderRegistry.hpp"
+#include "../../Core/Logger.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace Cogent::Renderer {
+
+    GpuCullingPass::GpuCullingPass(GraphicsDevice& device, uint32_t framesInFlight)
+        : device(device), framesInFlight(framesInFlight > 0 ? framesInFlight : 1) {
+        createDescriptorSetLayout();
+        createPipeline();
+
+        std::array<VkDescriptorPoolSize, 3> poolSizes{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSizes[0].descriptorCount = 7;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        poolSizes[1].descriptorCount = 1;
+        poolSizes[2].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[2].descriptorCount = 1;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        poolInfo.maxSets = 1;
+
+        if (vkCreateDescriptorPool(device.getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create GPU Culling Descriptor Pool!");
+        }
+
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = 1;
+        allocInfo.pSetLayouts = &descriptorSetLayout;
+        if (vkAllocateDescriptorSets(device.getDevice(), &allocInfo, &descriptorSet) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate GPU Culling Descriptor Set!");
+        }
+
+        // Counter + cull data tidak tergantung kapasitas scene. Keduanya device-local: dengan beberapa
+        // frame in flight CPU tidak boleh menulis/membaca memory yang mungkin masih dipakai GPU.
+        device.createBuffer(sizeof(uint32_t) * 4,
+            VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            counterBuffer, counterMemory);
+
+        device.createBuffer(sizeof(CullData), VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            cullDataBuffer, cullDataMemory);
+
+        // [NEW] Readback counter: satu slot (4 x uint32) per frame in flight
+        const VkDeviceSize readbackSize = sizeof(uint32_t) * 4 * this->framesInFlight;
+        device.createBuffer(readbackSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            readbackBuffer, readbackMemory);
+        vkMapMemory(device.getDevice(), readbackMemory, 0, readbackSize, 0, reinterpret_cast<void**>(&readback));
+        memset(readback, 0, readbackSize);
+
+        createBuffers(1024, 16);
+    }
+
+    GpuCullingPass::~GpuCullingPass() {
+        VkDevice dev = device.getDevice();
+        destroyBuffers();
+
+        vkDestroyBuffer(dev, counterBuffer, nullptr);
+        vkFreeMemory(dev, counterMemory, nullptr);
+        vkDestroyBuffer(dev, cullDataBuffer, nullptr);
+        vkFreeMemory(dev, cullDataMemory, nullptr);
+        vkUnmapMemory(dev, readbackMemory);
+        vkDestroyBuffer(dev, readbackBuffer, nullptr);
+        vkFreeMemory(dev, readbackMemory, nullptr);
+
+        vkDestroyPipeline(dev, pipeline, nullptr);
+        vkDestroyPipelineLayout(dev, pipelineLayout, nullptr);
+        vkDestroyDescriptorPool(dev, descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(dev, descriptorSetLayout, nullptr);
+    }
+
+    void GpuCullingPass::createDescriptorSetLayout() {
+        // 0: Objects (read)      1: Batch Bounds (read)   2: Draw Commands (atomic)
+        // 3: Visible Instances   4: Compacted Draws       5: Counters
+        // 6: Visibility Flags    7: Cull Data (UBO)       8: Hi-Z Pyramid
+        std::array<VkDescriptorSetLayoutBinding, 9> bindings{};
+        for (uint32_t i = 0; i < bindings.size(); i++) {
+            bindings[i].binding = i;
+            bindings[i].descriptorCount = 1;
+            bindings[i].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            bindings[i].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        }
+        bindings[7].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+        bindings[8].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+
+        VkDescriptorSetLayoutCreateInfo info{};
+        info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        info.bindingCount = static_cast<uint32_t>(bindings.size());
+        info.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device.getDevice(), &info, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create GPU Culling Descriptor Layout!");
+        }
+    }
+
+    void GpuCullingPass::createPipeline() {
+        VkPipelineShaderStageCreateInfo computeShaderStageInfo =
+            ShaderRegistry::Get().stage(VK_SHADER_STAGE_COMPUTE_BIT, "Shaders/cull.comp.spv");
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(PushConstants);
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create GPU Culling Pipeline Layout!");
+        }
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.stage = computeShaderStageInfo;
+
+        if (vkCreateComputePipelines(device.getDevice(), device.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create GPU Culling Pipeline!");
+        }
+    }
+
+    void GpuCullingPass::createBuffers(uint32_t newObjectCapacity, uint32_t newBatchCapacity) {
+        objectCapacity = newObjectCapacity;
+        batchCapacity = newBatchCapacity;
+
+        VkDeviceSize objectSize = sizeof(InstanceData) * objectCapacity;
+        VkDeviceSize boundsSize = sizeof(BatchBounds) * batchCapacity;
+        VkDeviceSize drawSize = sizeof(VkDrawIndexedIndirectCommand) * batchCapacity;
+
+        device.createBuffer(objectSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, objectBuffer, objectMemory);
+        device.createBuffer(boundsSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, boundsBuffer, boundsMemory);
+        device.createBuffer(drawSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, drawTemplateBuffer, drawTemplateMemory);
+        device.createBuffer(drawSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, drawBuffer, drawMemory);
+        device.createBuffer(drawSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, compactDrawBuffer, compactDrawMemory);
+        device.createBuffer(objectSize, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, visibleBuffer, visibleMemory);
+        device.createBuffer(sizeof(uint32_t) * objectCapacity, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, visibilityBuffer, visibilityMemory);
+
+        // Staging layout per slot: [objects][bounds][draw templates], satu slot per frame in flight
+        stagingSlotSize = objectSize + boundsSize + drawSize;
+        VkDeviceSize stagingSize = stagingSlotSize * framesInFlight;
+        device.createBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            stagingBuffer, stagingMemory);
+        vkMapMemory(device.getDevice(), stagingMemory, 0, stagingSize, 0, &stagingMapped);
+
+        updateDescriptorSet();
+    }
+
+    void GpuCullingPass::destroyBuffers(bool deferred) {
+        VkDevice dev = device.getDevice();
+        if (stagingMapped) {
+            vkUnmapMemory(dev, stagingMemory);
+            stagingMapped = nullptr;
+        }
+
+        VkBuffer* buffers[] = { &objectBuffer, &boundsBuffer, &drawTemplateBuffer, &drawBuffer, &compactDrawBuffer, &visibleBuffer, &visibilityBuffer, &stagingBuffer };
+        VkDeviceMemory* memories[] = { &objectMemory, &boundsMemory, &drawTemplateMemory, &drawMemory, &compactDrawMemory, &visibleMemory, &visibilityMemory, &stagingMemory };
+        for (size_t i = 0; i < 8; i++) {
+            if (deferred) {
+                device.getDeletionQueue().destroyBuffer(*buffers[i], *memories[i]);
+            } else {
+                if (*buffers[i] != VK_NULL_HANDLE) vkDestroyBuffer(dev, *buffers[i], nullptr);
+                if (*memories[i] != VK_NULL_HANDLE) vkFreeMemory(dev, *memories[i], nullptr);
+            }
+            *buffers[i] = VK_NULL_HANDLE;
+            *memories[i] = VK_NULL_HANDLE;
+        }
+    }
+
+    void GpuCullingPass::updateDescriptorSet() {
+        std::array<VkDescriptorBufferInfo, 8> bufferInfos{};
+        VkBuffer buffers[] = { objectBuffer, boundsBuffer, drawBuffer, visibleBuffer, compactDrawBuffer, counterBuffer, visibilityBuffer, cullDataBuffer };
+
+        std::array<VkWriteDescriptorSet, 8> writes{};
+        for (uint32_t i = 0; i < writes.size(); i++) {
+            bufferInfos[i].buffer = buffers[i];
+            bufferInfos[i].offset = 0;
+            bufferInfos[i].range = VK_WHOLE_SIZE;
+
+            writes[i].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[i].dstSet = descriptorSet;
+            writes[i].dstBinding = i;
+            writes[i].descriptorType = (i == 7) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+            writes[i].descriptorCount = 1;
+            writes[i].pBufferInfo = &bufferInfos[i];
+        }
+
+        vkUpdateDescriptorSets(device.getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+    }
+
+    void GpuCullingPass::setDepthPyramid(VkImageView view, VkSampler sampler, uint32_t width, uint32_t height) {
+        pyramidView = view;
+        pyramidSampler = sampler;
+        pyramidWidth = width;
+        pyramidHeight = height;
+
+        VkDescriptorImageInfo imageInfo{};
+        imageInfo.sampler = pyramidSampler;
+        imageInfo.imageView = pyramidView;
+        imageInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        VkWriteDescriptorSet write{};
+        write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        write.dstSet = descriptorSet;
+        write.dstBinding = 8;
+        write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        write.descriptorCount = 1;
+        write.pImageInfo = &imageInfo;
+
+        vkUpdateDescriptorSets(device.getDevice(), 1, &write, 0, nullptr);
+    }
+
+    bool GpuCullingPass::fitsCapacity(const DrawBatcher& batcher) const {
+        return batcher.getInstances().size() <= objectCapacity && batcher.getBatches().size() <= batchCapacity;
+    }
+
+    void GpuCullingPass::uploadScene(const DrawBatcher& batcher, const Resources::GeometryPool& geometryPool) {
+        const auto& instances = batcher.getInstances();
+        const auto& batches = batcher.getBatches();
+
+        // Grow (x2) kalau kapasitas tidak cukup. Buffer lama di-destroy lewat DeletionQueue; caller tetap
+        // menjamin tidak ada frame lain in flight (descriptor set dipakai bersama semua frame).
+        bool grown = false;
+        if (!fitsCapacity(batcher)) {
+            uint32_t newObjectCapacity = objectCapacity;
+            uint32_t newBatchCapacity = batchCapacity;
+            while (newObjectCapacity < instances.size()) newObjectCapacity *= 2;
+            while (newBatchCapacity < batches.size()) newBatchCapacity *= 2;
+
+            destroyBuffers(true);
+            createBuffers(newObjectCapacity, newBatchCapacity);
+            if (pyramidView != VK_NULL_HANDLE) setDepthPyramid(pyramidView, pyramidSampler, pyramidWidth, pyramidHeight);
+            LOG_INFO("GpuCullingPass: capacity -> " + std::to_string(objectCapacity) + " objects, " + std::to_string(batchCapacity) + " batches");
+            grown = true;
+        }
+
+        // Flag visibility per index instance: tetap valid selama urutan instance sama
+        bool layoutChanged = grown || instances.size() != objectCount || batches.size() != uploadedBatches.size();
+        for (size_t i = 0; !layoutChanged && i < batches.size(); i++) {
+            layoutChanged = batches[i].meshID != uploadedBatches[i].meshID || batches[i].firstInstance != uploadedBatches[i].firstInstance ||
+                            batches[i].instanceCount != uploadedBatches[i].instanceCount;
+        }
+        resetVisibility = resetVisibility || layoutChanged;
+        uploadedBatches = batches;
+
+        objectCount = static_cast<uint32_t>(instances.size());
+        batchCount = static_cast<uint32_t>(batches.size());
+
+        char* dst = static_cast<char*>(stagingMapped) + stagingSlotOffset();
+        memcpy(dst, instances.data(), sizeof(InstanceData) * objectCount);
+        dst += sizeof(InstanceData) * objectCapacity;
+
+        BatchBounds* bounds = reinterpret_cast<BatchBounds*>(dst);
+        dst += sizeof(BatchBounds) * batchCapacity;
+        VkDrawIndexedIndirectCommand* templates = reinterpret_cast<VkDrawIndexedIndirectCommand*>(dst);
+
+        for (uint32_t i = 0; i < batchCount; i++) {
+            const auto& mesh = geometryPool.getMesh(batches[i].meshID);
+            bounds[i].boundsMin = glm::vec4(mesh.bounds.min, 0.0f);
+            bounds[i].boundsMax = glm::vec4(mesh.bounds.max, 0.0f);
+
+            templates[i].indexCount = mesh.indexCount;
+            templates[i].instanceCount = 0; // Diisi atomicAdd oleh cull.comp
+            templates[i].firstIndex = mesh.firstIndex;
+            templates[i].vertexOffset = mesh.vertexOffset;
+            templates[i].firstInstance = batches[i].firstInstance;
+        }
+
+        pendingUpload = true;
+        pendingInstanceCopies.clear(); // Full upload sudah berisi semua instance
+    }
+
+    void GpuCullingPass::updateInstances(const DrawBatcher& batcher, const std::vector<uint32_t>& changedInstances) {
+        if (changedInstances.empty() || pendingUpload) return;
+
+        const auto& instances = batcher.getInstances();
+        sortedInstances.assign(changedInstances.begin(), changedInstances.end());
+        std::sort(sortedInstances.begin(), sortedInstances.end());
+        sortedInstances.erase(std::unique(sortedInstances.begin(), sortedInstances.end()), sortedInstances.end());
+
+        // Row di slot staging frame ini memakai offset yang sama dengan di objectBuffer; index berurutan
+        // digabung jadi satu region copy
+        char* slot = static_cast<char*>(stagingMapped) + stagingSlotOffset();
+        for (uint32_t instance : sortedInstances) {
+            if (instance >= objectCount) continue;
+            const VkDeviceSize offset = sizeof(InstanceData) * instance;
+            memcpy(slot + offset, &instances[instance], sizeof(InstanceData));
+
+            if (!pendingInstanceCopies.empty() && pendingInstanceCopies.back().dstOffset + pendingInstanceCopies.back().size == offset) {
+                pendingInstanceCopies.back().size += sizeof(InstanceData);
+            } else {
+                pendingInstanceCopies.push_back({ stagingSlotOffset() + offset, offset, sizeof(InstanceData) });
+            }
+        }
+    }
+
+    void GpuCullingPass::execute(VkCommandBuffer cmd, const Math::Frustum& frustum, const glm::mat4& viewProj, uint32_t phase) {
+        if (objectCount == 0) return;
+
+        VkDeviceSize drawSize = sizeof(VkDrawIndexedIndirectCommand) * batchCount;
+
+        if (phase == 0) {
+            // [NEW] Frame sebelumnya mungkin masih in flight dan membaca buffer yang akan di-reset di sini
+            // (indirect draw, instance stream, compute). Barrier ini juga mencakup submit sebelumnya di queue.
+            // TRANSFER_WRITE: copy upload/reset counter frame sebelumnya ke buffer yang sama (WAW)
+            VkMemoryBarrier frameBarrier{};
+            frameBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            frameBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+            frameBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            vkCmdPipelineBarrier(cmd,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0, 1, &frameBarrier, 0, nullptr, 0, nullptr);
+
+            // Cull data lewat command buffer, bukan memory mapped (slot lain bisa masih dibaca GPU)
+            CullData cullData;
+            cullData.viewProj = viewProj;
+            for (int i = 0; i < 6; i++) {
+                cullData.planes[i] = glm::vec4(frustum.planes[i].normal, frustum.planes[i].distance);
+            }
+            vkCmdUpdateBuffer(cmd, cullDataBuffer, 0, sizeof(CullData), &cullData);
+        } else {
+            // Phase 0 draw + compact masih membaca buffer yang akan di-reset (WAR)
+            VkMemoryBarrier phaseBarrier{};
+            phaseBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            phaseBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            phaseBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+            vkCmdPipelineBarrier(cmd,
+                VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                VK_PIPELINE_STAGE_TRANSFER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0, 1, &phaseBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        if (pendingUpload && phase == 0) {
+            const VkDeviceSize slotOffset = stagingSlotOffset();
+            VkBufferCopy objectCopy{ slotOffset, 0, sizeof(InstanceData) * objectCount };
+            vkCmdCopyBuffer(cmd, stagingBuffer, objectBuffer, 1, &objectCopy);
+
+            VkDeviceSize boundsOffset = slotOffset + sizeof(InstanceData) * objectCapacity;
+            VkBufferCopy boundsCopy{ boundsOffset, 0, sizeof(BatchBounds) * batchCount };
+            vkCmdCopyBuffer(cmd, stagingBuffer, boundsBuffer, 1, &boundsCopy);
+
+            VkBufferCopy templateCopy{ boundsOffset + sizeof(BatchBounds) * batchCapacity, 0, drawSize };
+            vkCmdCopyBuffer(cmd, stagingBuffer, drawTemplateBuffer, 1, &templateCopy);
+
+            // Urutan object berubah -> reset flag visibility (late phase akan mengisi ulang)
+            if (resetVisibility) {
+                vkCmdFillBuffer(cmd, visibilityBuffer, 0, sizeof(uint32_t) * objectCount, 0);
+                resetVisibility = false;
+            }
+
+            // Template harus selesai ditulis sebelum dibaca lagi sebagai source
+            VkMemoryBarrier uploadBarrier{};
+            uploadBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            uploadBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            uploadBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                0, 1, &uploadBarrier, 0, nullptr, 0, nullptr);
+
+            pendingUpload = false;
+        } else if (!pendingInstanceCopies.empty() && phase == 0) {
+            // [NEW] Update parsial: hanya row instance yang berubah (resetBarrier di bawah menutup ke compute)
+            vkCmdCopyBuffer(cmd, stagingBuffer, objectBuffer, static_cast<uint32_t>(pendingInstanceCopies.size()), pendingInstanceCopies.data());
+            pendingInstanceCopies.clear();
+        }
+
+        // 1. Reset: draw commands dari template (instanceCount = 0), counter phase ini = 0
+        VkBufferCopy resetCopy{ 0, 0, drawSize };
+        vkCmdCopyBuffer(cmd, drawTemplateBuffer, drawBuffer, 1, &resetCopy);
+        if (phase == 0) {
+            vkCmdFillBuffer(cmd, counterBuffer, 0, sizeof(uint32_t) * 4, 0);
+        }
+
+        VkMemoryBarrier resetBarrier{};
+        resetBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        resetBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        resetBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_UNIFORM_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &resetBarrier, 0, nullptr, 0, nullptr);
+
+        // 2. Cull (1 thread per object)
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+        vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+
+        PushConstants pc{};
+        pc.objectCount = objectCount;
+        pc.batchCount = batchCount;
+        pc.mode = 0;
+        pc.phase = phase;
+        pc.occlusionEnabled = occlusionEnabled ? 1 : 0;
+        pc.pyramidWidth = pyramidWidth;
+        pc.pyramidHeight = pyramidHeight;
+        vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pc);
+        vkCmdDispatch(cmd, (objectCount + 63) / 64, 1, 1);
+
+        VkMemoryBarrier cullBarrier{};
+        cullBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        cullBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        cullBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+
+        // 3. Compact (1 thread per batch)
+        pc.mode = 1;
+        vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstants), &pc);
+        vkCmdDispatch(cmd, (batchCount + 63) / 64, 1, 1);
+
+        // 4. Hasil dipakai sebagai indirect args + instance stream, counter di-copy ke readback
+        VkMemoryBarrier drawBarrier{};
+        drawBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        drawBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        drawBarrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 1, &drawBarrier, 0, nullptr, 0, nullptr);
+
+        // 5. [NEW] Phase terakhir frame ini: counter final -> slot readback frame ini (dibaca CPU setelah fence slot)
+        const uint32_t lastPhase = occlusionEnabled ? 1u : 0u;
+        if (phase == lastPhase) {
+            VkBufferCopy readbackCopy{ 0, sizeof(uint32_t) * 4 * currentFrame, sizeof(uint32_t) * 4 };
+            vkCmdCopyBuffer(cmd, counterBuffer, readbackBuffer, 1, &readbackCopy);
+
+            VkMemoryBarrier hostBarrier{};
+            hostBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            hostBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            hostBarrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+                0, 1, &hostBarrier, 0, nullptr, 0, nullptr);
+        }
+    }
+
+    void GpuCullingPass::draw(VkCommandBuffer cmd, uint32_t phase) {
+        if (objectCount == 0) return;
+
+        VkBuffer instanceBuffers[] = { visibleBuffer };
+        VkDeviceSize offsets[] = { 0 };
+        vkCmdBindVertexBuffers(cmd, InstanceData::BINDING, 1, instanceBuffers, offsets);
+
+        vkCmdDrawIndexedIndirectCount(cmd, compactDrawBuffer, 0, counterBuffer, sizeof(uint32_t) * 2 * phase,
+            batchCount, sizeof(VkDrawIndexedIndirectCommand));
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <glm/glm.hpp>
+#include "../../Core/Graphics/GraphicsDevice.hpp"
+#include "../../Core/Math/Frustum.hpp"
+#include "../../Resources/GeometryPool.hpp"
+#include "../DrawBatcher.hpp"
+
+namespace Cogent::Renderer {
+
+    // [NEW] GPU-driven culling: compute pass membaca semua object (transform + bounds) dari SSBO,
+    // frustum test di GPU, compact survivor ke VkDrawIndexedIndirectCommand + draw count.
+    // CPU cost per frame konstan: scene hanya di-upload ulang saat berubah (uploadScene; updateInstances untuk row yang berubah saja).
+    // Dengan occlusion aktif: two-phase (early = visible frame lalu, late = test Hi-Z pyramid).
+    class GpuCullingPass {
+    public:
+        GpuCullingPass(GraphicsDevice& device, uint32_t framesInFlight = 1);
+        ~GpuCullingPass();
+
+        // Upload SEMUA object (sudah di-batch per mesh). Copy ke device-local terjadi di execute() berikutnya.
+        // [MODIFIED] Staging per frame in flight (slot currentFrame, panggil setelah beginFrame): tidak perlu
+        // menunggu frame lain, kecuali kapasitas harus tumbuh (lihat fitsCapacity). Flag visibility two-phase
+        // hanya di-reset kalau jumlah object atau layout batch berubah.
+        void uploadScene(const DrawBatcher& batcher, const Resources::GeometryPool& geometryPool);
+
+        // [NEW] false -> uploadScene akan realokasi buffer + update descriptor set: caller harus menunggu
+        // semua frame in flight dulu
+        bool fitsCapacity(const DrawBatcher& batcher) const;
+
+        // [NEW] Upload ulang hanya instance yang berubah (DrawBatcher::refreshInstances) lewat staging slot
+        // frame ini. Layout batch harus sama dengan uploadScene terakhir.
+        void updateInstances(const DrawBatcher& batcher, const std::vector<uint32_t>& changedInstances);
+
+        // Hi-Z pyramid untuk phase 1 (wajib di-set sebelum execute pertama)
+        void setDepthPyramid(VkImageView pyramidView, VkSampler pyramidSampler, uint32_t width, uint32_t height);
+        void setOcclusionEnabled(bool enabled) { occlusionEnabled = enabled; }
+        bool isOcclusionEnabled() const { return occlusionEnabled; }
+
+        // Record: reset counter, cull dispatch, compact dispatch, barrier ke indirect + vertex input.
+        // Harus di luar render pass. phase 1 hanya dipakai kalau occlusion aktif (setelah Hi-Z build).
+        void execute(VkCommandBuffer cmd, const Math::Frustum& frustum, const glm::mat4& viewProj, uint32_t phase = 0);
+
+        // Record di dalam G-Buffer pass (GeometryPool sudah di-bind di binding 0)
+        void draw(VkCommandBuffer cmd, uint32_t phase = 0);
+
+        // [NEW] Slot frame in flight yang sedang direkam (panggil setelah fence slot itu di-wait)
+        void beginFrame(uint32_t frameIndex) { currentFrame = frameIndex % framesInFlight; pendingInstanceCopies.clear(); }
+
+        // Hasil frame terakhir yang memakai slot ini (framesInFlight frame lalu), total dua phase.
+        // Counter di-copy ke readback per slot, jadi tidak pernah dibaca selagi GPU masih menulis.
+        uint32_t getLastDrawCount() const { const uint32_t* c = readback + currentFrame * 4; return c[0] + c[2]; }
+        uint32_t getLastVisibleCount() const { const uint32_t* c = readback + currentFrame * 4; return c[1] + c[3]; }
+        uint32_t getObjectCount() const { return objectCount; }
+
+    private:
+        void createDescriptorSetLayout();
+        void createPipeline();
+        void createBuffers(uint32_t objectCapacity, uint32_t batchCapacity);
+        void destroyBuffers(bool deferred = false); // deferred: lewat DeletionQueue device
+        void updateDescriptorSet();
+        VkDeviceSize stagingSlotOffset() const { return stagingSlotSize * currentFrame; }
+
+        struct PushConstants {
+            uint32_t objectCount;
+            uint32_t batchCount;
+            uint32_t mode;  // 0 = cull, 1 = compact
+            uint32_t phase; // 0 = early, 1 = late
+            uint32_t occlusionEnabled;
+            uint32_t pyramidWidth;
+            uint32_t pyramidHeight;
+        };
+
+        struct CullData {
+            glm::mat4 viewProj;
+            glm::vec4 planes[6];
+        };
+
+        struct BatchBounds {
+            glm::vec4 boundsMin;
+            glm::vec4 boundsMax;
+        };
+
+        GraphicsDevice& device;
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+        VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+        // Device-local
+        VkBuffer objectBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory objectMemory = VK_NULL_HANDLE;
+        VkBuffer boundsBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory boundsMemory = VK_NULL_HANDLE;
+        VkBuffer drawTemplateBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory drawTemplateMemory = VK_NULL_HANDLE;
+        VkBuffer drawBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory drawMemory = VK_NULL_HANDLE;
+        VkBuffer compactDrawBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory compactDrawMemory = VK_NULL_HANDLE;
+        VkBuffer visibleBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory visibleMemory = VK_NULL_HANDLE;
+        VkBuffer visibilityBuffer = VK_NULL_HANDLE;    // Per object: visible frame lalu (two-phase)
+        VkDeviceMemory visibilityMemory = VK_NULL_HANDLE;
+
+        // Device-local, tidak tergantung kapasitas scene
+        VkBuffer counterBuffer = VK_NULL_HANDLE;   // Per phase: [drawCount, visibleCount]
+        VkDeviceMemory counterMemory = VK_NULL_HANDLE;
+        VkBuffer cullDataBuffer = VK_NULL_HANDLE;  // Diisi vkCmdUpdateBuffer (tidak ada tulis CPU ke memory in-flight)
+        VkDeviceMemory cullDataMemory = VK_NULL_HANDLE;
+
+        // Host-visible (persistently mapped). Staging: satu slot [objects][bounds][draw templates] per frame in flight
+        VkBuffer stagingBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+        VkBuffer readbackBuffer = VK_NULL_HANDLE;  // [NEW] Salinan counter per frame in flight
+        VkDeviceMemory readbackMemory = VK_NULL_HANDLE;
+        void* stagingMapped = nullptr;
+        uint32_t* readback = nullptr;
+
+        uint32_t framesInFlight = 1;
+        uint32_t currentFrame = 0;
+
+        VkImageView pyramidView = VK_NULL_HANDLE;
+        VkSampler pyramidSampler = VK_NULL_HANDLE;
+        uint32_t pyramidWidth = 1;
+        uint32_t pyramidHeight = 1;
+        bool occlusionEnabled = false;
+
+        uint32_t objectCapacity = 0;
+        uint32_t batchCapacity = 0;
+        uint32_t objectCount = 0;
+        uint32_t batchCount = 0;
+        bool pendingUpload = false;
+        bool resetVisibility = false;
+        VkDeviceSize stagingSlotSize = 0;
+        std::vector<DrawBatch> uploadedBatches;         // Layout batch uploadScene terakhir
+        std::vector<uint32_t> sortedInstances;          // Scratch updateInstances
+        std::vector<VkBufferCopy> pendingInstanceCopies; // Range staging slot frame ini -> objectBuffer
+    };
+}
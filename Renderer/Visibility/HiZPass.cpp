@@ -0,0 +1,309 @@
+#include "HiZPass.hpp"
+#include "../../Core/VulkanUtils.hpp"
+#include "../ShaderRegistry.hpp"
+#include "../../Core/Logger.hpp"
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace Cogent::Renderer {
+
+    static uint32_t previousPow2(uint32_t v) {
+        uint32_t result = 1;
+        while (result * 2 <= v) result *= 2;
+        return result;
+    }
+
+    HiZPass::HiZPass(GraphicsDevice& device, VkImageView depthView, VkExtent2D depthExtent)
+        : device(device), depthExtent(depthExtent) {
+        createPyramid();
+        createPipeline();
+        createDescriptors(depthView);
+        LOG_INFO("HiZPass: pyramid " + std::to_string(pyramidWidth) + "x" + std::to_string(pyramidHeight) +
+                 " (" + std::to_string(mipCount) + " mips)");
+    }
+
+    HiZPass::~HiZPass() {
+        VkDevice dev = device.getDevice();
+        vkDestroyPipeline(dev, pipeline, nullptr);
+        vkDestroyPipelineLayout(dev, pipelineLayout, nullptr);
+        vkDestroyDescriptorPool(dev, descriptorPool, nullptr);
+        vkDestroyDescriptorSetLayout(dev, descriptorSetLayout, nullptr);
+
+        vkDestroySampler(dev, sampler, nullptr);
+        for (auto view : mipViews) vkDestroyImageView(dev, view, nullptr);
+        vkDestroyImageView(dev, pyramidView, nullptr);
+        vkDestroyImage(dev, pyramidImage, nullptr);
+        vkFreeMemory(dev, pyramidMemory, nullptr);
+    }
+
+    void HiZPass::createPyramid() {
+        pyramidWidth = previousPow2(depthExtent.width);
+        pyramidHeight = previousPow2(depthExtent.height);
+        mipCount = 1;
+        while ((std::max(pyramidWidth, pyramidHeight) >> mipCount) > 0) mipCount++;
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = pyramidWidth;
+        imageInfo.extent.height = pyramidHeight;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = mipCount;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = VK_FORMAT_R32_SFLOAT;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vkCreateImage(device.getDevice(), &imageInfo, nullptr, &pyramidImage) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z Image!");
+        }
+
+        VkMemoryRequirements memReqs;
+        vkGetImageMemoryRequirements(device.getDevice(), pyramidImage, &memReqs);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memReqs.size;
+        allocInfo.memoryTypeIndex = device.findMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+        if (vkAllocateMemory(device.getDevice(), &allocInfo, nullptr, &pyramidMemory) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate Hi-Z Memory!");
+        }
+        vkBindImageMemory(device.getDevice(), pyramidImage, pyramidMemory, 0);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = pyramidImage;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = VK_FORMAT_R32_SFLOAT;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = mipCount;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        if (vkCreateImageView(device.getDevice(), &viewInfo, nullptr, &pyramidView) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z View!");
+        }
+
+        mipViews.resize(mipCount);
+        for (uint32_t i = 0; i < mipCount; i++) {
+            viewInfo.subresourceRange.baseMipLevel = i;
+            viewInfo.subresourceRange.levelCount = 1;
+            if (vkCreateImageView(device.getDevice(), &viewInfo, nullptr, &mipViews[i]) != VK_SUCCESS) {
+                throw std::runtime_error("Failed to create Hi-Z Mip View!");
+            }
+        }
+
+        VkSamplerCreateInfo samplerInfo{};
+        samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+        samplerInfo.magFilter = VK_FILTER_NEAREST;
+        samplerInfo.minFilter = VK_FILTER_NEAREST;
+        samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+        samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+        samplerInfo.minLod = 0.0f;
+        samplerInfo.maxLod = static_cast<float>(mipCount);
+        samplerInfo.maxAnisotropy = 1.0f;
+
+        if (vkCreateSampler(device.getDevice(), &samplerInfo, nullptr, &sampler) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z Sampler!");
+        }
+
+        // Pyramid selalu di GENERAL (storage write + sampled read)
+        VkCommandBuffer cmd = device.beginSingleTimeCommands();
+        VkImageMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        barrier.image = pyramidImage;
+        barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, mipCount, 0, 1 };
+        barrier.srcAccessMask = 0;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 1, &barrier);
+        device.endSingleTimeCommands(cmd);
+    }
+
+    void HiZPass::createPipeline() {
+        std::array<VkDescriptorSetLayoutBinding, 2> bindings{};
+        bindings[0].binding = 0;
+        bindings[0].descriptorCount = 1;
+        bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        bindings[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        bindings[1].binding = 1;
+        bindings[1].descriptorCount = 1;
+        bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        bindings[1].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.bindingCount = static_cast<uint32_t>(bindings.size());
+        layoutInfo.pBindings = bindings.data();
+
+        if (vkCreateDescriptorSetLayout(device.getDevice(), &layoutInfo, nullptr, &descriptorSetLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z Descriptor Layout!");
+        }
+
+        VkPipelineShaderStageCreateInfo computeShaderStageInfo =
+            ShaderRegistry::Get().stage(VK_SHADER_STAGE_COMPUTE_BIT, "Shaders/hiz.comp.spv");
+
+        VkPushConstantRange pushConstantRange{};
+        pushConstantRange.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+        pushConstantRange.offset = 0;
+        pushConstantRange.size = sizeof(int32_t) * 4; // srcSize + dstSize
+
+        VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
+        pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+        pipelineLayoutInfo.setLayoutCount = 1;
+        pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+        pipelineLayoutInfo.pushConstantRangeCount = 1;
+        pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+        if (vkCreatePipelineLayout(device.getDevice(), &pipelineLayoutInfo, nullptr, &pipelineLayout) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z Pipeline Layout!");
+        }
+
+        VkComputePipelineCreateInfo pipelineInfo{};
+        pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+        pipelineInfo.layout = pipelineLayout;
+        pipelineInfo.stage = computeShaderStageInfo;
+
+        if (vkCreateComputePipelines(device.getDevice(), device.getPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z Pipeline!");
+        }
+    }
+
+    void HiZPass::createDescriptors(VkImageView depthView) {
+        std::array<VkDescriptorPoolSize, 2> poolSizes{};
+        poolSizes[0].type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSizes[0].descriptorCount = mipCount;
+        poolSizes[1].type = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+        poolSizes[1].descriptorCount = mipCount;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+        poolInfo.pPoolSizes = poolSizes.data();
+        poolInfo.maxSets = mipCount;
+
+        if (vkCreateDescriptorPool(device.getDevice(), &poolInfo, nullptr, &descriptorPool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create Hi-Z Descriptor Pool!");
+        }
+
+        std::vector<VkDescriptorSetLayout> layouts(mipCount, descriptorSetLayout);
+        VkDescriptorSetAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocInfo.descriptorPool = descriptorPool;
+        allocInfo.descriptorSetCount = mipCount;
+        allocInfo.pSetLayouts = layouts.data();
+
+        descriptorSets.resize(mipCount);
+        if (vkAllocateDescriptorSets(device.getDevice(), &allocInfo, descriptorSets.data()) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate Hi-Z Descriptor Sets!");
+        }
+
+        for (uint32_t i = 0; i < mipCount; i++) {
+            VkDescriptorImageInfo srcInfo{};
+            srcInfo.sampler = sampler;
+            srcInfo.imageView = (i == 0) ? depthView : mipViews[i - 1];
+            srcInfo.imageLayout = (i == 0) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+
+            VkDescriptorImageInfo dstInfo{};
+            dstInfo.imageView = mipViews[i];
+            dstInfo.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+            std::array<VkWriteDescriptorSet, 2> writes{};
+            writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[0].dstSet = descriptorSets[i];
+            writes[0].dstBinding = 0;
+            writes[0].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+            writes[0].descriptorCount = 1;
+            writes[0].pImageInfo = &srcInfo;
+
+            writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+            writes[1].dstSet = descriptorSets[i];
+            writes[1].dstBinding = 1;
+            writes[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            writes[1].descriptorCount = 1;
+            writes[1].pImageInfo = &dstInfo;
+
+            vkUpdateDescriptorSets(device.getDevice(), static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+        }
+    }
+
+    void HiZPass::execute(VkCommandBuffer cmd, VkImage depthImage) {
+        // Depth write (G-Buffer pass) -> compute read
+        VkImageMemoryBarrier depthBarrier{};
+        depthBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        depthBarrier.oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        depthBarrier.newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+        depthBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        depthBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        depthBarrier.image = depthImage;
+        depthBarrier.subresourceRange = { VK_IMAGE_ASPECT_DEPTH_BIT, 0, 1, 0, 1 };
+        depthBarrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        depthBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+        // [FIX] Pyramid cuma satu untuk semua frame in flight: tunggu cull.comp / build Hi-Z
+        // frame sebelumnya selesai membaca/menulis sebelum semua mip ditimpa (WAR/WAW)
+        VkImageMemoryBarrier pyramidBarrier{};
+        pyramidBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        pyramidBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+        pyramidBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+        pyramidBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        pyramidBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        pyramidBarrier.image = pyramidImage;
+        pyramidBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, mipCount, 0, 1 };
+        pyramidBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        pyramidBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+        VkImageMemoryBarrier barriers[] = { depthBarrier, pyramidBarrier };
+        vkCmdPipelineBarrier(cmd,
+            VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+            0, 0, nullptr, 0, nullptr, 2, barriers);
+
+        vkCmdBindPipeline(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+
+        int32_t srcWidth = static_cast<int32_t>(depthExtent.width);
+        int32_t srcHeight = static_cast<int32_t>(depthExtent.height);
+
+        for (uint32_t i = 0; i < mipCount; i++) {
+            int32_t dstWidth = std::max(1, static_cast<int32_t>(pyramidWidth >> i));
+            int32_t dstHeight = std::max(1, static_cast<int32_t>(pyramidHeight >> i));
+
+            vkCmdBindDescriptorSets(cmd, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSets[i], 0, nullptr);
+
+            int32_t pc[4] = { srcWidth, srcHeight, dstWidth, dstHeight };
+            vkCmdPushConstants(cmd, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pc), pc);
+            vkCmdDispatch(cmd, (dstWidth + 7) / 8, (dstHeight + 7) / 8, 1);
+
+            // Mip i harus selesai sebelum jadi source mip i+1 (dan sebelum dibaca cull.comp)
+            VkImageMemoryBarrier mipBarrier{};
+            mipBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            mipBarrier.oldLayout = VK_IMAGE_LAYOUT_GENERAL;
+            mipBarrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+            mipBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            mipBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            mipBarrier.image = pyramidImage;
+            mipBarrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, i, 1, 0, 1 };
+            mipBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+            mipBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                0, 0, nullptr, 0, nullptr, 1, &mipBarrier);
+
+            srcWidth = dstWidth;
+            srcHeight = dstHeight;
+        }
+    }
+}
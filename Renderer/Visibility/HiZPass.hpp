@@ -0,0 +1,48 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include "../../Core/Graphics/GraphicsDevice.hpp"
+
+namespace Cogent::Renderer {
+
+    // [NEW] Hierarchical-Z depth pyramid (R32F, max-reduction) dibangun via compute dari G-Buffer depth.
+    // Ukuran mip 0 = power-of-two di bawah resolusi depth. Image selalu di layout GENERAL.
+    class HiZPass {
+    public:
+        HiZPass(GraphicsDevice& device, VkImageView depthView, VkExtent2D depthExtent);
+        ~HiZPass();
+
+        // Record build pyramid. Depth harus sudah di DEPTH_STENCIL_READ_ONLY_OPTIMAL (finalLayout G-Buffer).
+        void execute(VkCommandBuffer cmd, VkImage depthImage);
+
+        VkImageView getPyramidView() const { return pyramidView; }
+        VkSampler getSampler() const { return sampler; }
+        uint32_t getWidth() const { return pyramidWidth; }
+        uint32_t getHeight() const { return pyramidHeight; }
+        uint32_t getMipCount() const { return mipCount; }
+
+    private:
+        void createPyramid();
+        void createDescriptors(VkImageView depthView);
+        void createPipeline();
+
+        GraphicsDevice& device;
+        VkExtent2D depthExtent;
+
+        uint32_t pyramidWidth = 0;
+        uint32_t pyramidHeight = 0;
+        uint32_t mipCount = 0;
+
+        VkImage pyramidImage = VK_NULL_HANDLE;
+        VkDeviceMemory pyramidMemory = VK_NULL_HANDLE;
+        VkImageView pyramidView = VK_NULL_HANDLE;   // Semua mip (untuk sampling di cull.comp)
+        std::vector<VkImageView> mipViews;          // Satu view per mip (storage write / source mip berikutnya)
+        VkSampler sampler = VK_NULL_HANDLE;         // Nearest, clamp
+
+        VkPipeline pipeline = VK_NULL_HANDLE;
+        VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+        VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+        VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+        std::vector<VkDescriptorSet> descriptorSets; // Per mip
+    };
+}
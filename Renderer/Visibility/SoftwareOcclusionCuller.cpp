@@ -0,0 +1,391 @@
+#include "SoftwareOcclusionCuller.hpp"
+#include "../../Core/Threading/JobSystem.hpp"
+#include "../../Core/Math/Simd.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace Cogent::Renderer {
+
+    namespace {
+        // Vertex dengan w sekecil ini dianggap menyentuh near plane
+        constexpr float kNearW = 1e-4f;
+        constexpr float kMinArea = 1e-6f;
+
+        float elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+            return std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+    }
+
+    SoftwareOcclusionCuller::SoftwareOcclusionCuller() {
+        depthBuffer.assign(WIDTH * HEIGHT, 1.0f);
+    }
+
+    void SoftwareOcclusionCuller::registerMesh(int meshID, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices) {
+        OccluderMesh& mesh = meshes[meshID];
+        mesh.positions = positions;
+        mesh.indices = indices;
+        mesh.indices.resize(indices.size() - indices.size() % 3);
+    }
+
+    void SoftwareOcclusionCuller::beginFrame(const glm::mat4& viewProj) {
+        this->viewProj = viewProj;
+        pendingOccluders.clear();
+        stats = Stats{};
+        std::fill(depthBuffer.begin(), depthBuffer.end(), 1.0f);
+    }
+
+    void SoftwareOcclusionCuller::addOccluder(const glm::mat4& model, int meshID) {
+        auto it = meshes.find(meshID);
+        if (it == meshes.end()) return;
+
+        pendingOccluders.push_back({ model, &it->second, stats.occluderTriangles });
+        stats.occluders++;
+        stats.occluderTriangles += static_cast<uint32_t>(it->second.indices.size() / 3);
+    }
+
+    void SoftwareOcclusionCuller::rasterize() {
+        auto start = std::chrono::high_resolution_clock::now();
+
+        screenTriangles.resize(stats.occluderTriangles);
+        transformOccluders();
+        setupTriangles();
+
+        // Tile tidak overlap -> tiap job menulis region depth buffer sendiri, tanpa lock
+        Threading::JobSystem::Get().Dispatch(TILES_X * TILES_Y, 1, [this](uint32_t tileIndex) {
+            rasterizeTile(tileIndex);
+        });
+
+        stats.rasterMs = elapsedMs(start);
+    }
+
+    void SoftwareOcclusionCuller::transformOccluders() {
+        Threading::JobSystem::Get().Dispatch(static_cast<uint32_t>(pendingOccluders.size()), 1, [this](uint32_t index) {
+            const PendingOccluder& occluder = pendingOccluders[index];
+            const glm::mat4 mvp = viewProj * occluder.model;
+
+            std::vector<glm::vec4> clip(occluder.mesh->positions.size());
+            for (size_t v = 0; v < clip.size(); ++v) {
+                clip[v] = mvp * glm::vec4(occluder.mesh->positions[v], 1.0f);
+            }
+
+            const auto& indices = occluder.mesh->indices;
+            for (size_t t = 0; t < indices.size() / 3; ++t) {
+                ScreenTriangle& tri = screenTriangles[occluder.firstTriangle + t];
+                tri.valid = true;
+
+                for (int k = 0; k < 3; ++k) {
+                    const glm::vec4& c = clip[indices[t * 3 + k]];
+                    // Tidak ada near-plane clipping: triangle yang menyentuh near plane di-skip (tetap conservative)
+                    if (c.w <= kNearW) {
+                        tri.valid = false;
+                        break;
+                    }
+                    const float invW = 1.0f / c.w;
+                    tri.x[k] = (c.x * invW * 0.5f + 0.5f) * WIDTH;
+                    tri.y[k] = (c.y * invW * 0.5f + 0.5f) * HEIGHT;
+                    tri.z[k] = c.z * invW;
+                }
+            }
+        });
+    }
+
+    void SoftwareOcclusionCuller::setupTriangles() {
+        const uint32_t count = static_cast<uint32_t>(screenTriangles.size());
+        setups.resize(count);
+
+        // [FIX] Rasterisasi conservative untuk occluder: pixel [x, x+1] x [y, y+1] hanya ditulis kalau
+        // tercover penuh, dengan depth terjauh triangle di pixel itu (bukan coverage/depth di pusat pixel).
+        // Edge function & depth plane linear, jadi cukup dievaluasi di corner (x, y) setelah C digeser ke
+        // corner terburuk: E minimum -> offset min(A,0) + min(B,0), z maksimum -> offset max(zA,0) + max(zB,0).
+        auto finishSetup = [](TriangleSetup& s, bool valid, float minX, float maxX, float minY, float maxY) {
+            for (int e = 0; e < 3; ++e) {
+                s.edgeC[e] += std::min(s.edgeA[e], 0.0f) + std::min(s.edgeB[e], 0.0f);
+            }
+            s.zC += std::max(s.zA, 0.0f) + std::max(s.zB, 0.0f);
+
+            // Bounding box pixel yang seluruhnya di dalam bbox triangle
+            s.minX = std::max(0, static_cast<int>(std::ceil(minX)));
+            s.maxX = std::min(static_cast<int>(WIDTH) - 1, static_cast<int>(std::floor(maxX)) - 1);
+            s.minY = std::max(0, static_cast<int>(std::ceil(minY)));
+            s.maxY = std::min(static_cast<int>(HEIGHT) - 1, static_cast<int>(std::floor(maxY)) - 1);
+            if (!valid) { s.minX = 1; s.maxX = 0; }
+        };
+
+        auto setupScalar = [&](uint32_t i) {
+            const ScreenTriangle& t = screenTriangles[i];
+            TriangleSetup& s = setups[i];
+            if (!t.valid) { s.minX = 1; s.maxX = 0; return; }
+
+            // Edge 0: v1->v2, Edge 1: v2->v0, Edge 2: v0->v1 (edge i berlawanan dengan vertex i)
+            for (int e = 0; e < 3; ++e) {
+                const int a = (e + 1) % 3;
+                const int b = (e + 2) % 3;
+                s.edgeA[e] = t.y[a] - t.y[b];
+                s.edgeB[e] = t.x[b] - t.x[a];
+                s.edgeC[e] = t.x[a] * t.y[b] - t.x[b] * t.y[a];
+            }
+
+            float area = s.edgeA[2] * t.x[2] + s.edgeB[2] * t.y[2] + s.edgeC[2];
+            // Dua winding di-rasterize: flip supaya interior selalu E >= 0
+            if (area < 0.0f) {
+                area = -area;
+                for (int e = 0; e < 3; ++e) { s.edgeA[e] = -s.edgeA[e]; s.edgeB[e] = -s.edgeB[e]; s.edgeC[e] = -s.edgeC[e]; }
+            }
+
+            const float invArea = area > kMinArea ? 1.0f / area : 0.0f;
+            s.zA = (s.edgeA[0] * t.z[0] + s.edgeA[1] * t.z[1] + s.edgeA[2] * t.z[2]) * invArea;
+            s.zB = (s.edgeB[0] * t.z[0] + s.edgeB[1] * t.z[1] + s.edgeB[2] * t.z[2]) * invArea;
+            s.zC = (s.edgeC[0] * t.z[0] + s.edgeC[1] * t.z[1] + s.edgeC[2] * t.z[2]) * invArea;
+
+            finishSetup(s, area > kMinArea,
+                std::min({ t.x[0], t.x[1], t.x[2] }), std::max({ t.x[0], t.x[1], t.x[2] }),
+                std::min({ t.y[0], t.y[1], t.y[2] }), std::max({ t.y[0], t.y[1], t.y[2] }));
+        };
+
+        const uint32_t batchCount = (count + 3) / 4;
+        Threading::JobSystem::Get().Dispatch(batchCount, 64, [&](uint32_t batch) {
+            const uint32_t base = batch * 4;
+#if COGENT_SIMD_SSE2
+            if (base + 4 <= count) {
+                // Setup 4 triangle sekaligus (SoA di register SSE)
+                const ScreenTriangle* t = &screenTriangles[base];
+                const __m128 x0 = _mm_setr_ps(t[0].x[0], t[1].x[0], t[2].x[0], t[3].x[0]);
+                const __m128 x1 = _mm_setr_ps(t[0].x[1], t[1].x[1], t[2].x[1], t[3].x[1]);
+                const __m128 x2 = _mm_setr_ps(t[0].x[2], t[1].x[2], t[2].x[2], t[3].x[2]);
+                const __m128 y0 = _mm_setr_ps(t[0].y[0], t[1].y[0], t[2].y[0], t[3].y[0]);
+                const __m128 y1 = _mm_setr_ps(t[0].y[1], t[1].y[1], t[2].y[1], t[3].y[1]);
+                const __m128 y2 = _mm_setr_ps(t[0].y[2], t[1].y[2], t[2].y[2], t[3].y[2]);
+                const __m128 z0 = _mm_setr_ps(t[0].z[0], t[1].z[0], t[2].z[0], t[3].z[0]);
+                const __m128 z1 = _mm_setr_ps(t[0].z[1], t[1].z[1], t[2].z[1], t[3].z[1]);
+                const __m128 z2 = _mm_setr_ps(t[0].z[2], t[1].z[2], t[2].z[2], t[3].z[2]);
+
+                __m128 a[3], b[3], c[3];
+                a[0] = _mm_sub_ps(y1, y2); b[0] = _mm_sub_ps(x2, x1); c[0] = _mm_sub_ps(_mm_mul_ps(x1, y2), _mm_mul_ps(x2, y1));
+                a[1] = _mm_sub_ps(y2, y0); b[1] = _mm_sub_ps(x0, x2); c[1] = _mm_sub_ps(_mm_mul_ps(x2, y0), _mm_mul_ps(x0, y2));
+                a[2] = _mm_sub_ps(y0, y1); b[2] = _mm_sub_ps(x1, x0); c[2] = _mm_sub_ps(_mm_mul_ps(x0, y1), _mm_mul_ps(x1, y0));
+
+                __m128 area = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[2], x2), _mm_mul_ps(b[2], y2)), c[2]);
+                const __m128 sign = _mm_and_ps(area, _mm_set1_ps(-0.0f));
+                area = _mm_xor_ps(area, sign);
+                for (int e = 0; e < 3; ++e) {
+                    a[e] = _mm_xor_ps(a[e], sign);
+                    b[e] = _mm_xor_ps(b[e], sign);
+                    c[e] = _mm_xor_ps(c[e], sign);
+                }
+
+                const __m128 validArea = _mm_cmpgt_ps(area, _mm_set1_ps(kMinArea));
+                const __m128 invArea = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1.0f), area), validArea);
+                const __m128 zA = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], z0), _mm_mul_ps(a[1], z1)), _mm_mul_ps(a[2], z2)), invArea);
+                const __m128 zB = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b[0], z0), _mm_mul_ps(b[1], z1)), _mm_mul_ps(b[2], z2)), invArea);
+                const __m128 zC = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(c[0], z0), _mm_mul_ps(c[1], z1)), _mm_mul_ps(c[2], z2)), invArea);
+
+                alignas(16) float outA[3][4], outB[3][4], outC[3][4];
+                alignas(16) float outZA[4], outZB[4], outZC[4];
+                alignas(16) float minX[4], maxX[4], minY[4], maxY[4];
+                for (int e = 0; e < 3; ++e) {
+                    _mm_store_ps(outA[e], a[e]);
+                    _mm_store_ps(outB[e], b[e]);
+                    _mm_store_ps(outC[e], c[e]);
+                }
+                _mm_store_ps(outZA, zA);
+                _mm_store_ps(outZB, zB);
+                _mm_store_ps(outZC, zC);
+                _mm_store_ps(minX, _mm_min_ps(x0, _mm_min_ps(x1, x2)));
+                _mm_store_ps(maxX, _mm_max_ps(x0, _mm_max_ps(x1, x2)));
+                _mm_store_ps(minY, _mm_min_ps(y0, _mm_min_ps(y1, y2)));
+                _mm_store_ps(maxY, _mm_max_ps(y0, _mm_max_ps(y1, y2)));
+                const int validMask = _mm_movemask_ps(validArea);
+
+                for (int k = 0; k < 4; ++k) {
+                    TriangleSetup& s = setups[base + k];
+                    for (int e = 0; e < 3; ++e) {
+                        s.edgeA[e] = outA[e][k];
+                        s.edgeB[e] = outB[e][k];
+                        s.edgeC[e] = outC[e][k];
+                    }
+                    s.zA = outZA[k];
+                    s.zB = outZB[k];
+                    s.zC = outZC[k];
+                    finishSetup(s, t[k].valid && (validMask & (1 << k)), minX[k], maxX[k], minY[k], maxY[k]);
+                }
+                return;
+            }
+#endif
+            for (uint32_t i = base; i < std::min(base + 4, count); ++i) {
+                setupScalar(i);
+            }
+        });
+    }
+
+    void SoftwareOcclusionCuller::rasterizeTile(uint32_t tileIndex) {
+        const int tileMinX = static_cast<int>((tileIndex % TILES_X) * TILE_WIDTH);
+        const int tileMinY = static_cast<int>((tileIndex / TILES_X) * TILE_HEIGHT);
+        const int tileMaxX = tileMinX + static_cast<int>(TILE_WIDTH) - 1;
+        const int tileMaxY = tileMinY + static_cast<int>(TILE_HEIGHT) - 1;
+
+        for (const TriangleSetup& s : setups) {
+            if (s.minX > s.maxX) continue;
+
+            // Align ke 4 pixel (TILE_WIDTH kelipatan 4, jadi tetap di dalam tile).
+            // Pixel di luar bbox otomatis gagal edge test.
+            const int x0 = std::max(s.minX, tileMinX) & ~3;
+            const int x1 = std::min(s.maxX, tileMaxX);
+            const int y0 = std::max(s.minY, tileMinY);
+            const int y1 = std::min(s.maxY, tileMaxY);
+            if (x0 > x1 || y0 > y1) continue;
+
+#if COGENT_SIMD_SSE2
+            const __m128 laneOffset = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+            const __m128 zero = _mm_setzero_ps();
+            __m128 edgeA[3], edgeStep[3];
+            for (int e = 0; e < 3; ++e) {
+                edgeA[e] = _mm_set1_ps(s.edgeA[e]);
+                edgeStep[e] = _mm_set1_ps(s.edgeA[e] * 4.0f);
+            }
+            const __m128 zA = _mm_set1_ps(s.zA);
+            const __m128 zStep = _mm_set1_ps(s.zA * 4.0f);
+
+            for (int y = y0; y <= y1; ++y) {
+                const float py = static_cast<float>(y); // Corner pixel, lihat finishSetup
+                const __m128 px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x0)), laneOffset);
+
+                __m128 edge[3];
+                for (int e = 0; e < 3; ++e) {
+                    edge[e] = _mm_add_ps(_mm_mul_ps(edgeA[e], px), _mm_set1_ps(s.edgeB[e] * py + s.edgeC[e]));
+                }
+                __m128 depth = _mm_add_ps(_mm_mul_ps(zA, px), _mm_set1_ps(s.zB * py + s.zC));
+
+                float* row = &depthBuffer[static_cast<size_t>(y) * WIDTH];
+                for (int x = x0; x <= x1; x += 4) {
+                    const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(edge[0], zero), _mm_cmpge_ps(edge[1], zero)),
+                                                     _mm_cmpge_ps(edge[2], zero));
+                    if (_mm_movemask_ps(inside)) {
+                        const __m128 current = _mm_loadu_ps(row + x);
+                        const __m128 nearest = _mm_min_ps(current, depth); // Triangle terdekat, depth terjauh per triangle
+                        _mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, current)));
+                    }
+
+                    for (int e = 0; e < 3; ++e) edge[e] = _mm_add_ps(edge[e], edgeStep[e]);
+                    depth = _mm_add_ps(depth, zStep);
+                }
+            }
+#else
+            for (int y = y0; y <= y1; ++y) {
+                const float py = static_cast<float>(y);
+                float* row = &depthBuffer[static_cast<size_t>(y) * WIDTH];
+                for (int x = x0; x <= x1; ++x) {
+                    const float px = static_cast<float>(x);
+                    bool inside = true;
+                    for (int e = 0; e < 3; ++e) {
+                        if (s.edgeA[e] * px + s.edgeB[e] * py + s.edgeC[e] < 0.0f) { inside = false; break; }
+                    }
+                    if (inside) {
+                        row[x] = std::min(row[x], s.zA * px + s.zB * py + s.zC);
+                    }
+                }
+            }
+#endif
+        }
+    }
+
+    bool SoftwareOcclusionCuller::isVisible(const Math::AABB& worldBox) const {
+        float minX = static_cast<float>(WIDTH), maxX = 0.0f;
+        float minY = static_cast<float>(HEIGHT), maxY = 0.0f;
+        float minZ = 1.0f;
+
+        for (int i = 0; i < 8; ++i) {
+            const glm::vec3 corner(
+                (i & 1) ? worldBox.max.x : worldBox.min.x,
+                (i & 2) ? worldBox.max.y : worldBox.min.y,
+                (i & 4) ? worldBox.max.z : worldBox.min.z);
+            const glm::vec4 clip = viewProj * glm::vec4(corner, 1.0f);
+
+            // Box memotong near plane -> anggap visible
+            if (clip.w <= kNearW) return true;
+
+            const float invW = 1.0f / clip.w;
+            const float sx = (clip.x * invW * 0.5f + 0.5f) * WIDTH;
+            const float sy = (clip.y * invW * 0.5f + 0.5f) * HEIGHT;
+            minX = std::min(minX, sx); maxX = std::max(maxX, sx);
+            minY = std::min(minY, sy); maxY = std::max(maxY, sy);
+            minZ = std::min(minZ, clip.z * invW);
+        }
+        if (minZ <= 0.0f) return true;
+
+        const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+        const int x1 = std::min(static_cast<int>(WIDTH) - 1, static_cast<int>(std::floor(maxX)));
+        const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+        const int y1 = std::min(static_cast<int>(HEIGHT) - 1, static_cast<int>(std::floor(maxY)));
+        if (x0 > x1 || y0 > y1) return true;
+
+        // Visible kalau ada satu pixel di footprint yang depth occluder-nya tidak lebih dekat
+        for (int y = y0; y <= y1; ++y) {
+            const float* row = &depthBuffer[static_cast<size_t>(y) * WIDTH];
+            int x = x0;
+#if COGENT_SIMD_SSE2
+            const __m128 boxZ = _mm_set1_ps(minZ);
+            for (; x + 3 <= x1; x += 4) {
+                if (_mm_movemask_ps(_mm_cmple_ps(boxZ, _mm_loadu_ps(row + x)))) return true;
+            }
+#endif
+            for (; x <= x1; ++x) {
+                if (minZ <= row[x]) return true;
+            }
+        }
+        return false;
+    }
+
+    void SoftwareOcclusionCuller::cull(const glm::mat4& viewProj, const Scene::World& world, std::vector<uint32_t>& candidates) {
+        beginFrame(viewProj);
+        if (candidates.empty()) return;
+
+        const auto& bounds = world.bounds();
+        const auto& meshColumn = world.meshes();
+        const auto& transforms = world.transforms();
+
+        // Occluder = kandidat dengan proyeksi terbesar (radius^2 / jarak^2)
+        std::vector<std::pair<float, uint32_t>> scored;
+        scored.reserve(candidates.size());
+        for (uint32_t row : candidates) {
+            if (meshes.find(meshColumn[row].meshID) == meshes.end()) continue;
+
+            const glm::vec3 center = (bounds[row].min + bounds[row].max) * 0.5f;
+            const float radius = glm::length(bounds[row].max - bounds[row].min) * 0.5f;
+            const float w = (viewProj * glm::vec4(center, 1.0f)).w;
+            scored.push_back({ (radius * radius) / std::max(w * w, kNearW), row });
+        }
+
+        const size_t occluderCount = std::min<size_t>(scored.size(), maxOccluders);
+        std::partial_sort(scored.begin(), scored.begin() + occluderCount, scored.end(),
+            [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        for (size_t i = 0; i < occluderCount; ++i) {
+            const uint32_t row = scored[i].second;
+            const int meshID = meshColumn[row].meshID;
+            const uint32_t triangles = static_cast<uint32_t>(meshes[meshID].indices.size() / 3);
+            if (stats.occluderTriangles + triangles > triangleBudget) continue;
+            addOccluder(transforms[row], meshID);
+        }
+
+        rasterize();
+
+        auto start = std::chrono::high_resolution_clock::now();
+        const uint32_t count = static_cast<uint32_t>(candidates.size());
+        testResults.resize(count);
+        Threading::JobSystem::Get().Dispatch(count, 64, [&](uint32_t i) {
+            const Scene::WorldBounds& box = bounds[candidates[i]];
+            testResults[i] = isVisible({ box.min, box.max }) ? 1 : 0;
+        });
+
+        size_t kept = 0;
+        for (uint32_t i = 0; i < count; ++i) {
+            if (testResults[i]) candidates[kept++] = candidates[i];
+        }
+        candidates.resize(kept);
+
+        stats.tested = count;
+        stats.culled = count - static_cast<uint32_t>(kept);
+        stats.testMs = elapsedMs(start);
+    }
+}
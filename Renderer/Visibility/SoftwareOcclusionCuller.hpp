@@ -0,0 +1,100 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "../../Core/Math/Frustum.hpp"
+#include "../../Scene/World.hpp"
+
+namespace Cogent::Renderer {
+
+    // [NEW] CPU occlusion culling (tanpa GPU readback):
+    // 1. Pilih beberapa occluder besar dari kandidat yang lolos frustum
+    // 2. Rasterize mesh occluder ke depth buffer kecil, per tile di JobSystem. Conservative: hanya pixel yang
+    //    tercover penuh yang ditulis, dengan depth terjauh triangle di pixel itu (occluder tidak pernah membesar)
+    // 3. Test AABB kandidat: tertutup kalau depth terdekat AABB lebih jauh dari semua pixel di footprint-nya
+    // Murni CPU, jadi bisa dipakai headless.
+    class SoftwareOcclusionCuller {
+    public:
+        static constexpr uint32_t WIDTH = 256;
+        static constexpr uint32_t HEIGHT = 128;
+        static constexpr uint32_t TILE_WIDTH = 64;
+        static constexpr uint32_t TILE_HEIGHT = 32;
+        static constexpr uint32_t TILES_X = WIDTH / TILE_WIDTH;
+        static constexpr uint32_t TILES_Y = HEIGHT / TILE_HEIGHT;
+
+        struct Stats {
+            uint32_t occluders = 0;
+            uint32_t occluderTriangles = 0;
+            uint32_t tested = 0;
+            uint32_t culled = 0;
+            float rasterMs = 0.0f;
+            float testMs = 0.0f;
+
+            float culledFraction() const { return tested > 0 ? static_cast<float>(culled) / tested : 0.0f; }
+        };
+
+        SoftwareOcclusionCuller();
+
+        // Geometry occluder per meshID (posisi object-space + index list)
+        void registerMesh(int meshID, const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices);
+        bool hasMeshes() const { return !meshes.empty(); }
+
+        void setMaxOccluders(uint32_t count) { maxOccluders = count; }
+        void setTriangleBudget(uint32_t count) { triangleBudget = count; }
+
+        // Full pipeline: candidates (row hasil frustum test) di-filter in-place, urutan dipertahankan
+        void cull(const glm::mat4& viewProj, const Scene::World& world, std::vector<uint32_t>& candidates);
+
+        // Building blocks (dipakai cull, bisa dipanggil langsung untuk test headless)
+        void beginFrame(const glm::mat4& viewProj);
+        void addOccluder(const glm::mat4& model, int meshID);
+        void rasterize();
+        bool isVisible(const Math::AABB& worldBox) const;
+
+        const Stats& getStats() const { return stats; }
+        const std::vector<float>& getDepthBuffer() const { return depthBuffer; }
+
+    private:
+        struct OccluderMesh {
+            std::vector<glm::vec3> positions;
+            std::vector<uint32_t> indices;
+        };
+
+        struct PendingOccluder {
+            glm::mat4 model;
+            const OccluderMesh* mesh;
+            uint32_t firstTriangle;
+        };
+
+        // Screen-space triangle (x, y dalam pixel, z = NDC depth [0..1])
+        struct ScreenTriangle {
+            float x[3], y[3], z[3];
+            bool valid;
+        };
+
+        // Hasil triangle setup: 3 edge function (E = A*x + B*y + C, pixel tercover penuh kalau E >= 0 di corner (x, y)),
+        // depth plane z = zA*x + zB*y + zC (depth terjauh pixel di corner (x, y)), dan bounding box pixel
+        struct TriangleSetup {
+            float edgeA[3], edgeB[3], edgeC[3];
+            float zA, zB, zC;
+            int minX, maxX, minY, maxY;
+        };
+
+        void transformOccluders();
+        void setupTriangles();
+        void rasterizeTile(uint32_t tileIndex);
+
+        std::unordered_map<int, OccluderMesh> meshes;
+        std::vector<PendingOccluder> pendingOccluders;
+        std::vector<ScreenTriangle> screenTriangles;
+        std::vector<TriangleSetup> setups;
+        std::vector<float> depthBuffer;
+        std::vector<uint8_t> testResults;
+
+        glm::mat4 viewProj{1.0f};
+        uint32_t maxOccluders = 16;
+        uint32_t triangleBudget = 32768;
+        Stats stats;
+    };
+}
@@ -1,24 +1,131 @@
 #include "VisibilitySystem.hpp"
 #include "../../Core/Math/Frustum.hpp"
+#include "../../Core/Threading/JobSystem.hpp"
+#include "../../Core/Diagnostics/Profiler.hpp"
+#include "../../Resources/GeometryPool.hpp"
 
 namespace Cogent::Renderer {
 
     void VisibilitySystem::update(const glm::mat4& viewProj) {
         _frustum.update(viewProj);
+        _viewProj = viewProj;
     }
 
-    void VisibilitySystem::cull(const std::vector<GameObject>& allObjects, std::vector<const GameObject*>& visibleObjects) {
-        visibleObjects.clear();
-        visibleObjects.reserve(allObjects.size());
+    void VisibilitySystem::markDirty(uint32_t row) {
+        if (row >= _dirtyFlags.size()) return; // Belum pernah di-sync: ikut sebagai row baru
+        if (!_dirtyFlags[row]) {
+            _dirtyFlags[row] = 1;
+            _dirtyIndices.push_back(row);
+        }
+    }
+
+    void VisibilitySystem::markAllDirty() {
+        _dirtyIndices.clear();
+        for (uint32_t i = 0; i < _dirtyFlags.size(); ++i) {
+            _dirtyFlags[i] = 1;
+            _dirtyIndices.push_back(i);
+        }
+    }
 
-        for (const auto& obj : allObjects) {
-            Math::AABB box;
-            box.min = obj.aabbMin;
-            box.max = obj.aabbMax;
+    void VisibilitySystem::updateBounds(Scene::World& world, const Resources::GeometryPool& geometryPool) {
+        const uint32_t count = world.size();
+        const uint32_t previous = static_cast<uint32_t>(_dirtyFlags.size());
+        const bool appendOnly = count >= previous && world.getStructureVersion() - _structureVersion == count - previous;
 
-            if (_frustum.checkAABB(box)) {
-                visibleObjects.push_back(&obj);
+        if (!appendOnly) {
+            // Entity di-destroy (swap-remove) -> row bergeser, hitung ulang semuanya
+            _dirtyFlags.resize(count);
+            markAllDirty();
+        } else {
+            _dirtyFlags.resize(count, 0);
+            for (uint32_t i = previous; i < count; ++i) {
+                _dirtyFlags[i] = 1;
+                _dirtyIndices.push_back(i);
             }
         }
+        _structureVersion = world.getStructureVersion();
+        _bounds.resize(count);
+        _worldBoxes.resize(count);
+
+        const auto& transforms = world.transforms();
+        const auto& meshes = world.meshes();
+        auto& worldBounds = world.bounds();
+
+        const uint32_t dirtyCount = static_cast<uint32_t>(_dirtyIndices.size());
+        Threading::JobSystem::Get().Dispatch(dirtyCount, 256, [&](uint32_t i) {
+            const uint32_t row = _dirtyIndices[i];
+
+            Math::AABB box = Math::transformAABB(geometryPool.getMesh(meshes[row].meshID).bounds, transforms[row]);
+            worldBounds[row] = { box.min, box.max };
+            _bounds.set(row, box.min, box.max);
+            _worldBoxes[row] = box;
+            _dirtyFlags[row] = 0;
+        });
+
+        // Topologi berubah atau refit sudah terlalu longgar -> SAH build ulang, selain itu refit
+        if (!appendOnly || _bvh.getObjectCount() != count) {
+            _bvh.build(_worldBoxes);
+        } else if (dirtyCount > 0) {
+            _bvh.refit(_worldBoxes);
+            if (_bvh.needsRebuild()) _bvh.build(_worldBoxes);
+        }
+
+        _dirtyIndices.clear();
+        _lastBoundsUpdates = dirtyCount;
+        _boundsSynced = true;
+    }
+
+    void VisibilitySystem::cullBounds(const BoundsSoA& bounds, std::vector<uint64_t>& visibilityMask) const {
+        CullingKernels::cullParallel(_frustum, bounds, visibilityMask);
+    }
+
+    void VisibilitySystem::cull(const Scene::World& world, std::vector<uint32_t>& visibleRows) {
+        PROFILE_FUNCTION();
+        visibleRows.clear();
+        visibleRows.reserve(world.size());
+
+        const uint32_t count = world.size();
+
+        // [NEW] BVH: subtree di luar frustum dibuang sekaligus, yang di dalam diterima tanpa test per object
+        if (_useBVH && _boundsSynced && _bvh.getObjectCount() == count) {
+            _bvh.queryFrustum(_frustum, visibleRows);
+        } else {
+            cullLinear(world, visibleRows);
+        }
+
+        // [NEW] Survivor frustum -> software occlusion (filter in-place)
+        if (_occlusionEnabled && _occlusionCuller.hasMeshes()) {
+            _occlusionCuller.cull(_viewProj, world, visibleRows);
+        }
+    }
+
+    void VisibilitySystem::cullLinear(const Scene::World& world, std::vector<uint32_t>& visibleRows) {
+        // [NEW] SoA store dari updateBounds; kalau tidak sinkron, gather dari kolom WorldBounds
+        const uint32_t count = world.size();
+        if (!_boundsSynced || _bounds.count != count) {
+            const auto& worldBounds = world.bounds();
+            _bounds.resize(count);
+            for (uint32_t i = 0; i < count; ++i) {
+                _bounds.set(i, worldBounds[i].min, worldBounds[i].max);
+            }
+        }
+        cullBounds(_bounds, _visibilityMask);
+
+        for (uint32_t w = 0; w < _visibilityMask.size(); ++w) {
+            uint64_t bits = _visibilityMask[w];
+            while (bits) {
+                const uint32_t bit = Math::Simd::countTrailingZeros(bits);
+                visibleRows.push_back(w * BoundsSoA::BOXES_PER_WORD + bit);
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    BVH::RayHit VisibilitySystem::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+        return _bvh.raycast(origin, direction, maxDistance);
+    }
+
+    void VisibilitySystem::queryOverlap(const Math::AABB& box, std::vector<uint32_t>& outIndices) const {
+        _bvh.queryOverlap(box, outIndices);
     }
 }
@@ -2,20 +2,68 @@
 #include <vector>
 #include <glm/glm.hpp>
 #include "../../Core/Math/Frustum.hpp"
-#include "../../Core/Types.hpp" // For GameObject
+#include "../../Scene/World.hpp"
+#include "SoftwareOcclusionCuller.hpp"
+#include "CullingKernels.hpp"
+#include "BVH.hpp"
+
+namespace Cogent::Resources { class GeometryPool; }
 
 namespace Cogent::Renderer {
 
     class VisibilitySystem {
     public:
         void update(const glm::mat4& viewProj);
-        
-        // Culls objects and populates 'visibleObjects' list
-        void cull(const std::vector<GameObject>& allObjects, std::vector<const GameObject*>& visibleObjects);
+
+        // [NEW] Per-frame bounds stage: world AABB (Arvo) dihitung ulang hanya untuk row dirty,
+        // paralel di JobSystem, lalu ditulis ke kolom WorldBounds dan SoA store.
+        // Row baru otomatis dirty; create/destroy (structure version berubah) = semua dirty.
+        void updateBounds(Scene::World& world, const Resources::GeometryPool& geometryPool);
+        void markDirty(uint32_t row);
+        void markAllDirty();
+        uint32_t getLastBoundsUpdateCount() const { return _lastBoundsUpdates; }
+
+        // Culls world and populates 'visibleRows' (row di Scene::World)
+        // (pakai SoA store dari updateBounds kalau sinkron, selain itu gather dari kolom WorldBounds)
+        void cull(const Scene::World& world, std::vector<uint32_t>& visibleRows);
+
+        // [NEW] Frustum test langsung di SoA bounds (SIMD + paralel), bit 1 = visible
+        void cullBounds(const BoundsSoA& bounds, std::vector<uint64_t>& visibilityMask) const;
 
         const Math::Frustum& getFrustum() const { return _frustum; }
 
+        // [NEW] BVH atas world AABB: rebuild saat jumlah object berubah, refit paralel saat ada dirty.
+        // cull() pakai BVH (default) atau kernel SIMD linear.
+        void setUseBVH(bool enabled) { _useBVH = enabled; }
+        bool isUsingBVH() const { return _useBVH; }
+        // [NEW] Plane mask + last-plane cache di query BVH (default on)
+        void setTemporalCoherence(bool enabled) { _bvh.setTemporalCoherence(enabled); }
+        const BVH& getBVH() const { return _bvh; }
+        BVH::RayHit raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance = 1e30f) const;
+        void queryOverlap(const Math::AABB& box, std::vector<uint32_t>& outIndices) const;
+
+        // [NEW] CPU occlusion culling setelah frustum test (butuh mesh occluder ter-register)
+        SoftwareOcclusionCuller& getOcclusionCuller() { return _occlusionCuller; }
+        void setOcclusionEnabled(bool enabled) { _occlusionEnabled = enabled; }
+        bool isOcclusionEnabled() const { return _occlusionEnabled; }
+        float getOcclusionCulledFraction() const { return _occlusionCuller.getStats().culledFraction(); }
+
     private:
+        void cullLinear(const Scene::World& world, std::vector<uint32_t>& visibleRows);
+
         Math::Frustum _frustum;
+        glm::mat4 _viewProj{1.0f};
+        BoundsSoA _bounds;
+        std::vector<uint64_t> _visibilityMask;
+        std::vector<uint32_t> _dirtyIndices;
+        std::vector<uint8_t> _dirtyFlags;
+        bool _boundsSynced = false;
+        uint64_t _structureVersion = 0;
+        std::vector<Math::AABB> _worldBoxes;
+        BVH _bvh;
+        bool _useBVH = true;
+        uint32_t _lastBoundsUpdates = 0;
+        SoftwareOcclusionCuller _occlusionCuller;
+        bool _occlusionEnabled = false;
     };
 }
@@ -0,0 +1,117 @@
+#include "GeometryPool.hpp"
+#include "../Core/Logger.hpp"
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace Cogent::Resources {
+
+    GeometryPool::GeometryPool(GraphicsDevice& device) : device(device) {}
+
+    GeometryPool::~GeometryPool() {
+        // Explicit cleanup() dipanggil engine sebelum device di-destroy
+    }
+
+    void GeometryPool::init(uint32_t maxVertices, uint32_t maxIndices) {
+        vertexCapacity = maxVertices;
+        indexCapacity = maxIndices;
+
+        device.createBuffer(static_cast<VkDeviceSize>(sizeof(Vertex)) * vertexCapacity,
+            VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, vertexBuffer, vertexMemory);
+
+        device.createBuffer(static_cast<VkDeviceSize>(sizeof(uint32_t)) * indexCapacity,
+            VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, indexBuffer, indexMemory);
+
+        LOG_INFO("GeometryPool: " + std::to_string(vertexCapacity) + " vertices, " + std::to_string(indexCapacity) + " indices reserved");
+    }
+
+    void GeometryPool::cleanup() {
+        VkDevice dev = device.getDevice();
+        if (vertexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(dev, vertexBuffer, nullptr);
+        if (vertexMemory != VK_NULL_HANDLE) vkFreeMemory(dev, vertexMemory, nullptr);
+        if (indexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(dev, indexBuffer, nullptr);
+        if (indexMemory != VK_NULL_HANDLE) vkFreeMemory(dev, indexMemory, nullptr);
+
+        vertexBuffer = VK_NULL_HANDLE;
+        vertexMemory = VK_NULL_HANDLE;
+        indexBuffer = VK_NULL_HANDLE;
+        indexMemory = VK_NULL_HANDLE;
+        vertexCursor = 0;
+        indexCursor = 0;
+        meshes.clear();
+    }
+
+    uint32_t GeometryPool::addMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+        if (vertices.empty() || indices.empty()) {
+            throw std::runtime_error("GeometryPool: mesh kosong!");
+        }
+        if (vertexCursor + vertices.size() > vertexCapacity || indexCursor + indices.size() > indexCapacity) {
+            throw std::runtime_error("GeometryPool: kapasitas habis! Naikkan maxVertices/maxIndices di init().");
+        }
+
+        MeshRange range;
+        range.firstIndex = indexCursor;
+        range.indexCount = static_cast<uint32_t>(indices.size());
+        range.vertexOffset = static_cast<int32_t>(vertexCursor);
+        range.vertexCount = static_cast<uint32_t>(vertices.size());
+
+        range.bounds.min = glm::vec3(std::numeric_limits<float>::max());
+        range.bounds.max = glm::vec3(std::numeric_limits<float>::lowest());
+        for (const auto& v : vertices) {
+            range.bounds.min = glm::min(range.bounds.min, v.pos);
+            range.bounds.max = glm::max(range.bounds.max, v.pos);
+        }
+
+        uploadToBuffer(vertexBuffer, static_cast<VkDeviceSize>(vertexCursor) * sizeof(Vertex),
+                       vertices.data(), sizeof(Vertex) * vertices.size());
+        uploadToBuffer(indexBuffer, static_cast<VkDeviceSize>(indexCursor) * sizeof(uint32_t),
+                       indices.data(), sizeof(uint32_t) * indices.size());
+
+        vertexCursor += range.vertexCount;
+        indexCursor += range.indexCount;
+
+        meshes.push_back(range);
+        return static_cast<uint32_t>(meshes.size() - 1);
+    }
+
+    void GeometryPool::bind(VkCommandBuffer cmd) const {
+        VkBuffer vertexBuffers[] = { vertexBuffer };
+        VkDeviceSize offsets[] = { 0 };
+        vkCmdBindVertexBuffers(cmd, 0, 1, vertexBuffers, offsets);
+        vkCmdBindIndexBuffer(cmd, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+    }
+
+    void GeometryPool::draw(VkCommandBuffer cmd, uint32_t meshID, uint32_t instanceCount, uint32_t firstInstance) const {
+        const MeshRange& mesh = meshes[meshID];
+        vkCmdDrawIndexed(cmd, mesh.indexCount, instanceCount, mesh.firstIndex, mesh.vertexOffset, firstInstance);
+    }
+
+    void GeometryPool::uploadToBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size) {
+        VkDevice dev = device.getDevice();
+
+        VkBuffer stagingBuffer;
+        VkDeviceMemory stagingMemory;
+        device.createBuffer(size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            stagingBuffer, stagingMemory);
+
+        void* mapped;
+        vkMapMemory(dev, stagingMemory, 0, size, 0, &mapped);
+        memcpy(mapped, data, static_cast<size_t>(size));
+        vkUnmapMemory(dev, stagingMemory);
+
+        VkCommandBuffer cmd = device.beginSingleTimeCommands();
+        VkBufferCopy copyRegion{};
+        copyRegion.srcOffset = 0;
+        copyRegion.dstOffset = dstOffset;
+        copyRegion.size = size;
+        vkCmdCopyBuffer(cmd, stagingBuffer, dst, 1, &copyRegion);
+        device.endSingleTimeCommands(cmd);
+
+        vkDestroyBuffer(dev, stagingBuffer, nullptr);
+        vkFreeMemory(dev, stagingMemory, nullptr);
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <vector>
+#include "../Core/Types.hpp"
+#include "../Core/Math/Frustum.hpp"
+#include "../Core/Graphics/GraphicsDevice.hpp"
+
+namespace Cogent::Resources {
+
+    // Satu mesh = satu range di dalam mega buffer (base vertex + first index)
+    struct MeshRange {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        int32_t vertexOffset = 0;
+        uint32_t vertexCount = 0;
+        Math::AABB bounds{}; // Local space, dihitung saat addMesh
+    };
+
+    // [NEW] Global geometry pool: satu vertex buffer + satu index buffer (device-local).
+    // Semua mesh di-suballocate secara linear, jadi satu pass cukup bind sekali.
+    class GeometryPool {
+    public:
+        static constexpr uint32_t DEFAULT_VERTEX_CAPACITY = 1024 * 1024;
+        static constexpr uint32_t DEFAULT_INDEX_CAPACITY = 4 * 1024 * 1024;
+
+        GeometryPool(GraphicsDevice& device);
+        ~GeometryPool();
+
+        void init(uint32_t maxVertices = DEFAULT_VERTEX_CAPACITY, uint32_t maxIndices = DEFAULT_INDEX_CAPACITY);
+        void cleanup();
+
+        // Upload via staging buffer, return meshID (index ke getMesh)
+        uint32_t addMesh(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices);
+
+        const MeshRange& getMesh(uint32_t meshID) const { return meshes[meshID]; }
+        uint32_t getMeshCount() const { return static_cast<uint32_t>(meshes.size()); }
+
+        // Bind VB + IB sekali per pass
+        void bind(VkCommandBuffer cmd) const;
+        // Draw satu range (indices relatif ke base vertex mesh)
+        void draw(VkCommandBuffer cmd, uint32_t meshID, uint32_t instanceCount = 1, uint32_t firstInstance = 0) const;
+
+        VkBuffer getVertexBuffer() const { return vertexBuffer; }
+        VkBuffer getIndexBuffer() const { return indexBuffer; }
+
+    private:
+        void uploadToBuffer(VkBuffer dst, VkDeviceSize dstOffset, const void* data, VkDeviceSize size);
+
+        GraphicsDevice& device;
+
+        VkBuffer vertexBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
+        VkBuffer indexBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory indexMemory = VK_NULL_HANDLE;
+
+        uint32_t vertexCapacity = 0;
+        uint32_t indexCapacity = 0;
+        uint32_t vertexCursor = 0;
+        uint32_t indexCursor = 0;
+
+        std::vector<MeshRange> meshes;
+    };
+}
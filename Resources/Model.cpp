@@ -4,6 +4,7 @@
 #include "Model.hpp"
 #include <iostream>
 #include <unordered_map>
+#include <utility>
 #include "../Core/VulkanUtils.hpp"
 #include "../Core/Types.hpp" // Hashes are already defined here!
 
@@ -14,6 +15,17 @@
 // It is now inside the Vertex struct in Types.hpp.
 
 void Model::loadModel(VkDevice device, VkPhysicalDevice physDevice, const std::string& filepath) {
+    loadObj(filepath);
+
+    // Buat Buffer Vulkan
+    createVertexBuffer(device, physDevice);
+    createIndexBuffer(device, physDevice);
+
+    std::cout << "Model loaded: " << filepath << " (Vertices: " << vertices.size() << ")" << std::endl;
+}
+
+// [NEW] Bagian CPU dari loadModel (dipisah supaya import bisa diukur / dipakai tanpa device)
+void Model::loadObj(const std::string& filepath) {
     tinyobj::attrib_t attrib;
     std::vector<tinyobj::shape_t> shapes;
     std::vector<tinyobj::material_t> materials;
@@ -71,14 +83,8 @@ void Model::loadModel(VkDevice device, VkPhysicalDevice physDevice, const std::s
     }
 
     // Simpan ke member class
-    this->vertices = localVertices;
-    this->indices = localIndices;
-
-    // Buat Buffer Vulkan
-    createVertexBuffer(device, physDevice);
-    createIndexBuffer(device, physDevice);
-
-    std::cout << "Model loaded: " << filepath << " (Vertices: " << vertices.size() << ")" << std::endl;
+    this->vertices = std::move(localVertices);
+    this->indices = std::move(localIndices);
 }
 
 // [NEW] Implementation of createVertexBuffer to keep code clean
@@ -4,6 +4,7 @@
 #include <string>
 #include "../Core/Types.hpp" // [FIX] Untuk struct Vertex
 #include "PrimitiveMesh.hpp" // [OPSIONAL] Jika loadFromMesh butuh PrimitiveMesh
+#include "GeometryPool.hpp"
 
 // Forward declaration biar tidak circular dependency
 // Forward declaration biar tidak circular dependency
@@ -12,6 +13,7 @@ struct PrimitiveMesh;
 class Model {
 public:
     void loadModel(VkDevice device, VkPhysicalDevice physDevice, const std::string& filepath);
+    void loadObj(const std::string& filepath); // [NEW] Parse + dedup vertex saja, tanpa buffer GPU
     void draw(VkCommandBuffer cmd); 
     void cleanup(VkDevice device);
 
@@ -24,6 +26,14 @@ public:
         createIndexBuffer(device, physDevice);
     }
 
+    // [NEW] Masukkan data CPU ke GeometryPool (shared VB/IB), return meshID
+    uint32_t uploadToPool(Cogent::Resources::GeometryPool& pool) const {
+        return pool.addMesh(vertices, indices);
+    }
+
+    const std::vector<Vertex>& getVertices() const { return vertices; }
+    const std::vector<uint32_t>& getIndices() const { return indices; }
+
 private:
     // Data CPU
     std::vector<Vertex> vertices;
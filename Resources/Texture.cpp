@@ -8,6 +8,7 @@
 
 // Note: We need to include GraphicsDevice for the override
 #include "../Core/Graphics/GraphicsDevice.hpp"
+#include "../Renderer/BindlessHeap.hpp"
 
 void Texture::load(VkDevice device, VkPhysicalDevice physDevice, VkCommandPool commandPool, VkQueue graphicsQueue, const std::string& filepath) {
     this->path = filepath;
@@ -126,6 +127,7 @@ void Texture::uploadGPU(GraphicsDevice& device) {
     if (pixelData.empty()) return;
 
     state = Cogent::Resources::StreamingState::UPLOADING;
+    owner = &device;
 
     VkDevice vkDevice = device.getDevice();
     VkPhysicalDevice physDevice = device.getPhysicalDevice();
@@ -208,23 +210,33 @@ void Texture::uploadGPU(GraphicsDevice& device) {
 }
 
 void Texture::unload() {
-     // We don't have device handle stored in Texture to destroy resources...
-     // cleanup(device) takes a device handle. 
-     // This is a flaw in the current Texture design for RAII/Automatic unloading.
-     // For now, assume manual cleanup or we need to store device handle.
-     
-     // Since this method override must match base class with no arguments, 
-     // we can't easily implement full unload without storing VkDevice.
-     
-     if (textureImage != VK_NULL_HANDLE) {
-         std::cerr << "WARNING: Texture::unload() called but cannot destroy Vulkan resources (Missing VkDevice handle). Use cleanup(device) instead." << std::endl;
-         // In a real engine, Texture would hold a pointer to Device or RenderContext.
-         // For now, we clear CPU data.
-     }
+    // [FIX] Texture yang di-upload lewat streaming tahu device-nya: handle GPU dilepas lewat
+    // DeletionQueue (frame yang masih sampling texture ini selesai dulu), jadi evict tanpa stall.
+    if (owner && textureImage != VK_NULL_HANDLE) {
+        // [FIX] Slot bindless ikut entry yang sama: index baru dipakai ulang setelah image-nya benar-benar
+        // hancur, jadi tidak ada frame yang membaca slot lama yang sudah menunjuk ke texture lain
+        owner->getDeletionQueue().push([image = textureImage, view = textureImageView, sampler = textureSampler,
+                                        memory = textureImageMemory, heap = bindlessHeap, index = bindlessIndex](VkDevice device) {
+            if (sampler != VK_NULL_HANDLE) vkDestroySampler(device, sampler, nullptr);
+            if (view != VK_NULL_HANDLE) vkDestroyImageView(device, view, nullptr);
+            vkDestroyImage(device, image, nullptr);
+            if (memory != VK_NULL_HANDLE) vkFreeMemory(device, memory, nullptr);
+            if (heap) heap->recycle(index);
+        });
+        bindlessHeap = nullptr;
+        bindlessIndex = Cogent::Renderer::BindlessHeap::INVALID_INDEX;
+        textureSampler = VK_NULL_HANDLE;
+        textureImageView = VK_NULL_HANDLE;
+        textureImage = VK_NULL_HANDLE;
+        textureImageMemory = VK_NULL_HANDLE;
+    } else if (textureImage != VK_NULL_HANDLE) {
+        // Legacy load(): tidak ada GraphicsDevice, harus lewat cleanup(device)
+        std::cerr << "WARNING: Texture::unload() called on a legacy-loaded texture. Use cleanup(device) instead." << std::endl;
+    }
      
-     pixelData.clear();
-     pixelData.shrink_to_fit();
-     state = Cogent::Resources::StreamingState::UNLOADED;
+    pixelData.clear();
+    pixelData.shrink_to_fit();
+    state = Cogent::Resources::StreamingState::UNLOADED;
 }
 
 void Texture::cleanup(VkDevice device) {
@@ -5,6 +5,8 @@
 #include "../Core/VulkanUtils.hpp"
 #include "Streaming/Streamer.hpp" // For StreamableResource
 
+namespace Cogent::Renderer { class BindlessHeap; }
+
 // Inherit from StreamableResource to support streaming
 class Texture : public Cogent::Resources::StreamableResource {
 public:
@@ -18,6 +20,13 @@ public:
 
     VkImageView getImageView() { return textureImageView; }
     VkSampler getSampler() { return textureSampler; }
+    uint32_t getWidth() const { return width; }
+    uint32_t getHeight() const { return height; }
+    bool usesFallback() const { return isFallback; } // [NEW] true kalau loadCPU gagal decode (pixel putih 1x1)
+
+    // [NEW] Slot BindlessHeap milik texture ini; unload() melepasnya bersama image di entry DeletionQueue yang sama
+    void setBindlessSlot(Cogent::Renderer::BindlessHeap* heap, uint32_t index) { bindlessHeap = heap; bindlessIndex = index; }
+    uint32_t getBindlessIndex() const { return bindlessIndex; }
 
     // Helpers for Legacy Load (if needed) or internal use
     void createImage(VkDevice device, VkPhysicalDevice physDevice, uint32_t width, uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, VkImage& image, VkDeviceMemory& imageMemory);
@@ -38,4 +47,8 @@ private:
     // CPU Data for Streaming
     std::vector<unsigned char> pixelData;
     bool isFallback = false;
+
+    GraphicsDevice* owner = nullptr; // [NEW] Diset di uploadGPU, supaya unload() bisa release handle GPU
+    Cogent::Renderer::BindlessHeap* bindlessHeap = nullptr;
+    uint32_t bindlessIndex = 0xFFFFFFFFu; // BindlessHeap::INVALID_INDEX
 };
\ No newline at end of file
@@ -0,0 +1,279 @@
+#include "World.hpp"
+#include <utility>
+
+namespace Cogent::Scene {
+
+    glm::mat4 LocalTransform::toMatrix() const {
+        const glm::mat3 r = glm::mat3_cast(rotation);
+        glm::mat4 m(1.0f);
+        m[0] = glm::vec4(r[0] * scale.x, 0.0f);
+        m[1] = glm::vec4(r[1] * scale.y, 0.0f);
+        m[2] = glm::vec4(r[2] * scale.z, 0.0f);
+        m[3] = glm::vec4(position, 1.0f);
+        return m;
+    }
+
+    LocalTransform LocalTransform::fromMatrix(const glm::mat4& matrix) {
+        LocalTransform t;
+        t.position = glm::vec3(matrix[3]);
+
+        const glm::vec3 c0(matrix[0]), c1(matrix[1]), c2(matrix[2]);
+        t.scale = glm::vec3(glm::length(c0), glm::length(c1), glm::length(c2));
+        if (glm::dot(glm::cross(c0, c1), c2) < 0.0f) t.scale.x = -t.scale.x; // Mirror
+
+        // Scale 0 (object di-collapse) -> rotasi tidak bisa diambil, biarkan identity
+        if (t.scale.x == 0.0f || t.scale.y == 0.0f || t.scale.z == 0.0f) return t;
+        const glm::mat3 r(c0 / t.scale.x, c1 / t.scale.y, c2 / t.scale.z);
+        t.rotation = glm::normalize(glm::quat_cast(r));
+        return t;
+    }
+
+    Entity World::create(int meshID, const glm::mat4& transform, const glm::vec4& color, std::string name) {
+        Entity entity;
+        if (!freeIndices.empty()) {
+            entity.index = freeIndices.back();
+            freeIndices.pop_back();
+        } else {
+            entity.index = static_cast<uint32_t>(sparse.size());
+            sparse.push_back(Entity::INVALID);
+            generations.push_back(0);
+            dirtyFlags.push_back(0);
+        }
+        entity.generation = generations[entity.index];
+
+        sparse[entity.index] = size();
+        entities.push_back(entity);
+        transformColumn.push_back(transform);
+        localColumn.push_back(LocalTransform::fromMatrix(transform));
+        hierarchyColumn.push_back(Hierarchy{});
+        boundsColumn.push_back(WorldBounds{}); // Diisi VisibilitySystem::updateBounds (row baru otomatis dirty)
+        meshColumn.push_back(MeshRenderer{ meshID, 0 });
+        colorColumn.push_back(color);
+        nameColumn.push_back(std::move(name));
+
+        structureVersion++;
+        return entity;
+    }
+
+    void World::destroy(Entity entity) {
+        if (!isAlive(entity)) return;
+
+        // Lepas dari parent, child jadi root dengan posisi world tetap
+        detach(entity.index);
+        uint32_t child = hierarchyColumn[sparse[entity.index]].firstChild;
+        while (child != Entity::INVALID) {
+            const uint32_t childRow = rowOfIndex(child);
+            const uint32_t next = hierarchyColumn[childRow].nextSibling;
+            localColumn[childRow] = LocalTransform::fromMatrix(transformColumn[childRow]);
+            hierarchyColumn[childRow].parent = Entity::INVALID;
+            hierarchyColumn[childRow].nextSibling = Entity::INVALID;
+            updateDepth(child, 0);
+            markDirty(child);
+            child = next;
+        }
+
+        const uint32_t row = sparse[entity.index];
+        const uint32_t last = size() - 1;
+        if (row != last) {
+            // Swap-remove: row terakhir pindah ke lubang
+            entities[row] = entities[last];
+            transformColumn[row] = transformColumn[last];
+            localColumn[row] = localColumn[last];
+            hierarchyColumn[row] = hierarchyColumn[last];
+            boundsColumn[row] = boundsColumn[last];
+            meshColumn[row] = meshColumn[last];
+            colorColumn[row] = colorColumn[last];
+            nameColumn[row] = std::move(nameColumn[last]);
+            sparse[entities[row].index] = row;
+        }
+
+        entities.pop_back();
+        transformColumn.pop_back();
+        localColumn.pop_back();
+        hierarchyColumn.pop_back();
+        boundsColumn.pop_back();
+        meshColumn.pop_back();
+        colorColumn.pop_back();
+        nameColumn.pop_back();
+
+        // dirtyFlags sengaja tidak di-reset: index mungkin masih ada di pendingDirty (di-skip saat update)
+        sparse[entity.index] = Entity::INVALID;
+        generations[entity.index]++;
+        freeIndices.push_back(entity.index);
+        structureVersion++;
+    }
+
+    void World::clear() {
+        for (const Entity& entity : entities) {
+            sparse[entity.index] = Entity::INVALID;
+            generations[entity.index]++;
+            freeIndices.push_back(entity.index);
+        }
+        for (uint32_t index : pendingDirty) dirtyFlags[index] = 0;
+        pendingDirty.clear();
+        entities.clear();
+        transformColumn.clear();
+        localColumn.clear();
+        hierarchyColumn.clear();
+        boundsColumn.clear();
+        meshColumn.clear();
+        colorColumn.clear();
+        nameColumn.clear();
+        structureVersion++;
+    }
+
+    void World::reserve(uint32_t capacity) {
+        entities.reserve(capacity);
+        transformColumn.reserve(capacity);
+        localColumn.reserve(capacity);
+        hierarchyColumn.reserve(capacity);
+        boundsColumn.reserve(capacity);
+        meshColumn.reserve(capacity);
+        colorColumn.reserve(capacity);
+        nameColumn.reserve(capacity);
+    }
+
+    bool World::isAlive(Entity entity) const {
+        return entity.index < sparse.size() &&
+               sparse[entity.index] != Entity::INVALID &&
+               generations[entity.index] == entity.generation;
+    }
+
+    uint32_t World::rowOf(Entity entity) const {
+        return isAlive(entity) ? sparse[entity.index] : Entity::INVALID;
+    }
+
+    bool World::setParent(Entity child, Entity parent) {
+        if (!isAlive(child) || child == parent) return false;
+        const bool hasParent = parent.isValid();
+        if (hasParent && !isAlive(parent)) return false;
+
+        // Cycle: parent baru tidak boleh descendant dari child
+        for (uint32_t ancestor = hasParent ? parent.index : Entity::INVALID; ancestor != Entity::INVALID;
+             ancestor = hierarchyColumn[rowOfIndex(ancestor)].parent) {
+            if (ancestor == child.index) return false;
+        }
+
+        detach(child.index);
+
+        const uint32_t childRow = rowOfIndex(child.index);
+        glm::mat4 local = transformColumn[childRow];
+        uint32_t depth = 0;
+        if (hasParent) {
+            const uint32_t parentRow = rowOfIndex(parent.index);
+            Hierarchy& parentNode = hierarchyColumn[parentRow];
+            hierarchyColumn[childRow].parent = parent.index;
+            hierarchyColumn[childRow].nextSibling = parentNode.firstChild;
+            parentNode.firstChild = child.index;
+            local = glm::inverse(transformColumn[parentRow]) * local;
+            depth = parentNode.depth + 1;
+        }
+
+        localColumn[childRow] = LocalTransform::fromMatrix(local);
+        updateDepth(child.index, depth);
+        markDirty(child.index);
+        return true;
+    }
+
+    Entity World::getParent(Entity entity) const {
+        if (!isAlive(entity)) return {};
+        const uint32_t parent = hierarchyColumn[rowOfIndex(entity.index)].parent;
+        if (parent == Entity::INVALID) return {};
+        return entities[rowOfIndex(parent)];
+    }
+
+    void World::setLocalTransform(uint32_t row, const LocalTransform& local) {
+        localColumn[row] = local;
+        markDirty(entities[row].index);
+    }
+
+    void World::setWorldTransform(uint32_t row, const glm::mat4& worldMatrix) {
+        const uint32_t parent = hierarchyColumn[row].parent;
+        const glm::mat4 local = (parent == Entity::INVALID) ? worldMatrix
+                                                            : glm::inverse(transformColumn[rowOfIndex(parent)]) * worldMatrix;
+        setLocalTransform(row, LocalTransform::fromMatrix(local));
+    }
+
+    uint32_t World::updateTransforms(std::vector<uint32_t>& changedRows) {
+        changedRows.clear();
+        if (pendingDirty.empty()) return 0;
+
+        // Bucket row dirty per depth (breadth-first)
+        for (auto& level : dirtyLevels) level.clear();
+        for (uint32_t index : pendingDirty) {
+            const uint32_t row = sparse[index];
+            if (row == Entity::INVALID) { // Sudah di-destroy
+                dirtyFlags[index] = 0;
+                continue;
+            }
+            const uint32_t depth = hierarchyColumn[row].depth;
+            if (dirtyLevels.size() <= depth) dirtyLevels.resize(depth + 1);
+            dirtyLevels[depth].push_back(row);
+        }
+        pendingDirty.clear();
+
+        auto& jobs = Threading::JobSystem::Get();
+        for (size_t depth = 0; depth < dirtyLevels.size(); ++depth) {
+            if (dirtyLevels[depth].empty()) continue;
+            if (dirtyLevels.size() <= depth + 1) dirtyLevels.resize(depth + 2); // Sebelum ambil reference
+            const std::vector<uint32_t>& rows = dirtyLevels[depth];
+            std::vector<uint32_t>& nextLevel = dirtyLevels[depth + 1];
+
+            // Parent di level sebelumnya sudah final -> row di level ini independen
+            jobs.Dispatch(static_cast<uint32_t>(rows.size()), 64, [&](uint32_t i) {
+                const uint32_t row = rows[i];
+                const uint32_t parent = hierarchyColumn[row].parent;
+                const glm::mat4 local = localColumn[row].toMatrix();
+                transformColumn[row] = (parent == Entity::INVALID) ? local : transformColumn[rowOfIndex(parent)] * local;
+            });
+
+            // Propagasi ke child (yang belum dirty) untuk level berikutnya
+            for (uint32_t row : rows) {
+                dirtyFlags[entities[row].index] = 0;
+                changedRows.push_back(row);
+                for (uint32_t child = hierarchyColumn[row].firstChild; child != Entity::INVALID;
+                     child = hierarchyColumn[rowOfIndex(child)].nextSibling) {
+                    if (!dirtyFlags[child]) {
+                        dirtyFlags[child] = 1;
+                        nextLevel.push_back(rowOfIndex(child));
+                    }
+                }
+            }
+        }
+        return static_cast<uint32_t>(changedRows.size());
+    }
+
+    void World::markDirty(uint32_t entityIndex) {
+        if (!dirtyFlags[entityIndex]) {
+            dirtyFlags[entityIndex] = 1;
+            pendingDirty.push_back(entityIndex);
+        }
+    }
+
+    void World::detach(uint32_t entityIndex) {
+        Hierarchy& node = hierarchyColumn[rowOfIndex(entityIndex)];
+        if (node.parent != Entity::INVALID) {
+            uint32_t* link = &hierarchyColumn[rowOfIndex(node.parent)].firstChild;
+            while (*link != Entity::INVALID && *link != entityIndex) {
+                link = &hierarchyColumn[rowOfIndex(*link)].nextSibling;
+            }
+            if (*link == entityIndex) *link = node.nextSibling;
+        }
+        node.parent = Entity::INVALID;
+        node.nextSibling = Entity::INVALID;
+    }
+
+    void World::updateDepth(uint32_t entityIndex, uint32_t depth) {
+        std::vector<std::pair<uint32_t, uint32_t>> stack{ { entityIndex, depth } };
+        while (!stack.empty()) {
+            const auto [index, level] = stack.back();
+            stack.pop_back();
+            Hierarchy& node = hierarchyColumn[rowOfIndex(index)];
+            node.depth = level;
+            for (uint32_t child = node.firstChild; child != Entity::INVALID;
+                 child = hierarchyColumn[rowOfIndex(child)].nextSibling) {
+                stack.push_back({ child, level + 1 });
+            }
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "../Core/Threading/JobSystem.hpp"
+
+namespace Cogent::Scene {
+
+    // Handle stabil ke entity. index = slot di sparse array, generation naik setiap slot dipakai ulang
+    // (handle lama ke entity yang sudah di-destroy otomatis invalid).
+    struct Entity {
+        static constexpr uint32_t INVALID = 0xFFFFFFFFu;
+        uint32_t index = INVALID;
+        uint32_t generation = 0;
+
+        bool isValid() const { return index != INVALID; }
+        bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const Entity& other) const { return !(*this == other); }
+    };
+
+    // Komponen
+    struct WorldBounds {
+        glm::vec3 min = glm::vec3(-1.0f);
+        glm::vec3 max = glm::vec3(1.0f);
+    };
+
+    struct MeshRenderer {
+        int meshID = 0;     // 0=Cube, 1=Sphere, 2=Capsule (index GeometryPool)
+        int pipelineID = 0; // Batching key (0 = G-Buffer opaque)
+        int materialID = 0; // [NEW] Descriptor set material (0 = texture default)
+    };
+
+    // [NEW] Transform lokal (relatif ke parent) dalam bentuk TRS
+    struct LocalTransform {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        glm::vec3 scale = glm::vec3(1.0f);
+
+        glm::mat4 toMatrix() const;
+        static LocalTransform fromMatrix(const glm::mat4& matrix); // Tanpa shear
+    };
+
+    // [NEW] Link hierarchy pakai entity index (bukan row), jadi swap-remove tidak perlu fixup
+    struct Hierarchy {
+        uint32_t parent = 0xFFFFFFFFu;
+        uint32_t firstChild = 0xFFFFFFFFu;
+        uint32_t nextSibling = 0xFFFFFFFFu;
+        uint32_t depth = 0; // 0 = root
+    };
+
+    // [NEW] Scene storage data-oriented (pengganti std::vector<GameObject>).
+    // Semua entity renderable berbagi satu archetype: tiap komponen disimpan di array SoA sendiri,
+    // row yang sama di semua kolom = entity yang sama. Sparse set (entity index -> row) memberi handle
+    // stabil; destroy = swap-remove supaya kolom tetap padat tanpa lubang.
+    // Loop panas (bounds, culling, batching) cuma menyentuh kolom yang dibutuhkan; nama (std::string)
+    // disimpan di kolom cold terpisah.
+    class World {
+    public:
+        static constexpr uint32_t CHUNK_SIZE = 1024; // Row per job di forEachChunk
+
+        // transform = matrix world (entity baru selalu root)
+        Entity create(int meshID, const glm::mat4& transform, const glm::vec4& color, std::string name);
+        void destroy(Entity entity);
+        void clear();
+        void reserve(uint32_t capacity);
+
+        bool isAlive(Entity entity) const;
+        uint32_t size() const { return static_cast<uint32_t>(entities.size()); }
+        bool empty() const { return entities.empty(); }
+
+        // Row saat ini untuk entity (Entity::INVALID kalau sudah mati). Row bisa berubah setelah destroy.
+        uint32_t rowOf(Entity entity) const;
+        Entity entityAt(uint32_t row) const { return entities[row]; }
+        uint32_t rowOfIndex(uint32_t entityIndex) const { return sparse[entityIndex]; } // Untuk link Hierarchy
+
+        // [NEW] Hierarchy. setParent mempertahankan posisi world child (local dihitung ulang);
+        // parent invalid = jadikan root. Return false kalau akan membentuk cycle.
+        bool setParent(Entity child, Entity parent);
+        Entity getParent(Entity entity) const;
+        // Local TRS berubah -> subtree ditandai dirty, world matrix dihitung di updateTransforms
+        void setLocalTransform(uint32_t row, const LocalTransform& local);
+        // Dari editor/gizmo: matrix world diubah ke local relatif parent
+        void setWorldTransform(uint32_t row, const glm::mat4& worldMatrix);
+
+        // [NEW] Hitung ulang world matrix hanya untuk subtree dirty, breadth-first per depth level:
+        // tiap level paralel di JobSystem (parent selalu selesai sebelum child). Row yang world-nya
+        // berubah ditulis ke changedRows (untuk bounds / GPU re-upload). Scene statis = O(1).
+        uint32_t updateTransforms(std::vector<uint32_t>& changedRows);
+
+        // Naik setiap create/destroy: row lama tidak bisa dipercaya lagi (cache per row harus di-rebuild)
+        uint64_t getStructureVersion() const { return structureVersion; }
+
+        // Kolom SoA (index = row)
+        // transforms() = matrix world hasil updateTransforms. Tulis lewat setLocalTransform/setWorldTransform
+        // supaya child ikut ter-update.
+        std::vector<glm::mat4>& transforms() { return transformColumn; }
+        const std::vector<glm::mat4>& transforms() const { return transformColumn; }
+        std::vector<WorldBounds>& bounds() { return boundsColumn; }
+        const std::vector<WorldBounds>& bounds() const { return boundsColumn; }
+        std::vector<MeshRenderer>& meshes() { return meshColumn; }
+        const std::vector<MeshRenderer>& meshes() const { return meshColumn; }
+        std::vector<glm::vec4>& colors() { return colorColumn; }
+        const std::vector<glm::vec4>& colors() const { return colorColumn; }
+        const std::vector<LocalTransform>& locals() const { return localColumn; }
+        const std::vector<Hierarchy>& hierarchy() const { return hierarchyColumn; }
+        std::vector<std::string>& names() { return nameColumn; } // Cold: editor saja
+        const std::vector<std::string>& names() const { return nameColumn; }
+
+        // Iterasi paralel per chunk row [begin, end) di JobSystem. Satu chunk = satu job,
+        // jadi func boleh menulis row di range-nya tanpa lock.
+        template<typename Func>
+        void forEachChunk(Func&& func, uint32_t chunkSize = CHUNK_SIZE) const {
+            const uint32_t count = size();
+            if (count == 0 || chunkSize == 0) return;
+            const uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+            Threading::JobSystem::Get().Dispatch(chunkCount, 1, [&](uint32_t chunk) {
+                const uint32_t begin = chunk * chunkSize;
+                const uint32_t end = (begin + chunkSize < count) ? begin + chunkSize : count;
+                func(begin, end);
+            });
+        }
+
+    private:
+        void markDirty(uint32_t entityIndex);
+        void detach(uint32_t entityIndex);
+        void updateDepth(uint32_t entityIndex, uint32_t depth);
+        // Sparse set
+        std::vector<uint32_t> sparse;      // entity index -> row (INVALID = slot bebas)
+        std::vector<uint32_t> generations; // per entity index
+        std::vector<uint32_t> freeIndices;
+        std::vector<Entity> entities;      // row -> entity
+
+        // Kolom komponen
+        std::vector<glm::mat4> transformColumn; // World
+        std::vector<LocalTransform> localColumn;
+        std::vector<Hierarchy> hierarchyColumn;
+        std::vector<WorldBounds> boundsColumn;
+        std::vector<MeshRenderer> meshColumn;
+        std::vector<glm::vec4> colorColumn;
+        std::vector<std::string> nameColumn;
+
+        // Dirty per entity index (bukan row, tetap valid setelah swap-remove)
+        std::vector<uint8_t> dirtyFlags;
+        std::vector<uint32_t> pendingDirty;
+        std::vector<std::vector<uint32_t>> dirtyLevels; // Scratch: row dirty per depth
+
+        uint64_t structureVersion = 0;
+    };
+}
@@ -6,11 +6,17 @@ layout(location = 1) in vec3 inColor;
 layout(location = 2) in vec3 inNormal;
 layout(location = 3) in vec2 inTexCoord;
 
+// INSTANCE INPUT (Binding 1): Must match C++ InstanceData (Renderer/InstanceBuffer.hpp)
+layout(location = 4) in mat4 inModel;   // Occupies locations 4..7
+layout(location = 8) in vec4 inInstanceColor;
+layout(location = 9) in int inMaterialIndex; // Index texture di bindless heap
+
 // OUTPUT to Fragment Shader
 layout(location = 0) out vec3 fragPos;
 layout(location = 1) out vec3 fragColor;
 layout(location = 2) out vec3 fragNormal;
 layout(location = 3) out vec2 fragTexCoord;
+layout(location = 4) flat out int fragMaterialIndex;
 
 // UBO Camera (Set 0) - Must match C++ CameraUBO struct exactly
 layout(set = 0, binding = 0) uniform CameraUBO {
@@ -23,18 +29,14 @@ layout(set = 0, binding = 0) uniform CameraUBO {
     float deltaTime;
 } ubo;
 
-layout(push_constant) uniform PushConsts {
-    mat4 model;
-    vec4 color;
-} push;
-
 void main() {
-    vec4 worldPos = push.model * vec4(inPosition, 1.0);
+    vec4 worldPos = inModel * vec4(inPosition, 1.0);
     
     fragPos = worldPos.xyz;
-    fragColor = push.color.rgb * inColor; // Use push constant color * vertex color
-    fragNormal = mat3(push.model) * inNormal;
+    fragColor = inInstanceColor.rgb * inColor; // Instance color * vertex color
+    fragNormal = mat3(inModel) * inNormal;
     fragTexCoord = inTexCoord;
+    fragMaterialIndex = inMaterialIndex;
 
     gl_Position = ubo.proj * ubo.view * worldPos;
 }
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "Engine/CogentEngine.hpp"
 #include "Core/Logger.hpp"
 
-int main() {
+int main(int argc, char** argv) {
     // 1. Init Logging
     // Use relative path to build directory or where executable runs
     LOG_INIT("cogent_log.txt");
@@ -12,13 +12,17 @@ int main() {
 
     LOG_INFO("Bootstrapping System...");
     
+    // [NEW] --headless / COGENT_HEADLESS=1: tanpa window, render offscreen (lihat HeadlessOptions)
+    const HeadlessOptions headless = HeadlessOptions::parse(argc, argv);
+
     // Initialize GLFW before CogentEngine (which creates Vulkan Instance)
-    if (!glfwInit()) {
+    // Headless tidak butuh display: glfwInit gagal di mesin tanpa X11/Wayland
+    if (!headless.enabled && !glfwInit()) {
         LOG_ERROR("FATAL: Failed to initialize GLFW in main!");
         return EXIT_FAILURE;
     }
 
-    CogentEngine app;
+    CogentEngine app(headless);
 
     try {
         app.run();